@@ -0,0 +1,162 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "Journal.hpp"
+#include "MoveGenerator.hpp"
+
+namespace {
+using clock = std::chrono::steady_clock;
+
+/**
+ * @brief Plies of the journaled game
+ */
+constexpr std::size_t PLIES{10000};
+
+/**
+ * @brief Number of random plies seeked to
+ */
+constexpr std::size_t SEEKS{2000};
+
+/**
+ * @brief Writes a game of PLIES pseudo-random legal moves to a journal
+ * @details Quiet piece moves are preferred and moves leaving no reply are
+ * skipped, so that the game lasts
+ * @param snapshots Whether snapshots are written as a Game does
+ */
+bool write_game(const std::string &path, bool snapshots) {
+    std::remove(path.c_str());
+
+    dreamchess::Journal journal{};
+
+    if (!journal.open(path)) {
+        return false;
+    }
+
+    dreamchess::Board board{};
+    uint64_t seed = 2021;
+
+    journal.append_reset();
+
+    for (std::size_t ply = 1; ply <= PLIES; ply++) {
+        dreamchess::MoveList legal;
+        dreamchess::MoveGenerator::legal(board, legal);
+        std::vector<dreamchess::Move> quiet;
+        std::vector<dreamchess::Move> other;
+
+        for (const auto &move : legal) {
+            const bool is_quiet =
+                dreamchess::Piece::type(move.piece()) !=
+                    dreamchess::Piece::PAWN &&
+                board.piece_at(move.destination()) == dreamchess::Piece::NONE;
+
+            (is_quiet ? quiet : other).push_back(move);
+        }
+
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const std::size_t first =
+            (seed >> 33) % std::max<std::size_t>(1, quiet.size());
+        bool played = false;
+
+        quiet.insert(quiet.end(), other.begin(), other.end());
+
+        // The first move leaving the opponent a legal reply
+        for (std::size_t i = 0; i < quiet.size() && !played; i++) {
+            const dreamchess::Move move = quiet[(first + i) % quiet.size()];
+            dreamchess::Board next = board;
+            next.make_move(move);
+
+            dreamchess::MoveList replies;
+            dreamchess::MoveGenerator::legal(next, replies);
+
+            if (replies.size() > 0) {
+                board = next;
+                journal.append(move);
+                played = true;
+            }
+        }
+
+        if (!played) {
+            return false;
+        }
+
+        if (snapshots && ply % dreamchess::Journal::SNAPSHOT_INTERVAL == 0) {
+            journal.append_snapshot(board);
+        }
+    }
+
+    return journal.close();
+}
+
+double seconds_since(clock::time_point start) {
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+}    // namespace
+
+int main() {
+    const std::string path{"journal_bench.dcj"};
+
+    for (const bool snapshots : {false, true}) {
+        if (!write_game(path, snapshots)) {
+            std::cerr << "cannot write " << path << "\n";
+            return 1;
+        }
+
+        if (snapshots) {
+            std::cout << "snapshots every "
+                      << dreamchess::Journal::SNAPSHOT_INTERVAL << " plies:\n";
+        } else {
+            std::cout << "no snapshots:\n";
+        }
+
+        auto start = clock::now();
+        const auto contents = dreamchess::Journal::read(path);
+        const double read = seconds_since(start);
+
+        if (!contents || contents->m_moves.size() != PLIES) {
+            std::cerr << "cannot read " << path << "\n";
+            return 1;
+        }
+
+        uint64_t seed = 46;
+        start = clock::now();
+
+        for (std::size_t i = 0; i < SEEKS; i++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            if (!dreamchess::Journal::seek(*contents, (seed >> 33) % PLIES)) {
+                return 1;
+            }
+        }
+
+        const double seek = seconds_since(start) / SEEKS;
+
+        dreamchess::Game game{};
+        start = clock::now();
+        const bool resumed = game.open_journal(path);
+        const double resume = seconds_since(start);
+        game.close_journal();
+
+        std::cout << "  read " << read * 1e3 << " ms, seek " << seek * 1e6
+                  << " us per ply, resume "
+                  << (resumed ? std::to_string(resume * 1e3) + " ms"
+                              : std::string{"failed"})
+                  << "\n";
+    }
+
+    std::remove(path.c_str());
+
+    return 0;
+}
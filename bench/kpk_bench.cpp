@@ -0,0 +1,90 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Kpk.hpp"
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    using dreamchess::Kpk;
+
+    const auto generation_start = clock::now();
+    const Kpk::table_t table = Kpk::generate();
+    const auto generation_end = clock::now();
+
+    uint32_t wins = 0;
+
+    for (const auto &word : table) {
+        wins += static_cast<uint32_t>(__builtin_popcountll(word));
+    }
+
+    std::cout << "generation: "
+              << std::chrono::duration<double, std::milli>(generation_end -
+                                                           generation_start)
+                     .count()
+              << " ms, " << sizeof(table) << " bytes, " << wins
+              << " winning positions\n";
+
+    // Random normalized positions, illegal ones are probed as draws
+    constexpr size_t PROBES{1 << 20};
+    std::mt19937 random{2021};
+    std::vector<uint16_t> positions(PROBES * 4);
+
+    for (size_t i = 0; i < PROBES; i++) {
+        positions[i * 4] = static_cast<uint16_t>(random() % 64);
+        positions[i * 4 + 1] =
+            static_cast<uint16_t>(8 * (1 + random() % 6) + random() % 4);
+        positions[i * 4 + 2] = static_cast<uint16_t>(random() % 64);
+        positions[i * 4 + 3] = static_cast<uint16_t>(random() % 2);
+    }
+
+    static_cast<void>(Kpk::table());
+
+    uint32_t hits = 0;
+    const auto probe_start = clock::now();
+
+    for (size_t i = 0; i < PROBES; i++) {
+        hits += Kpk::probe(positions[i * 4], positions[i * 4 + 1],
+                           positions[i * 4 + 2], positions[i * 4 + 3] != 0);
+    }
+
+    const auto probe_end = clock::now();
+
+    std::cout << "probe: "
+              << std::chrono::duration<double, std::nano>(probe_end -
+                                                          probe_start)
+                         .count() /
+                     PROBES
+              << " ns/probe (" << hits << " wins)\n";
+
+    dreamchess::Board board{};
+    board.load_fen("4k3/8/4P3/4K3/8/8/8/8 w - - 0 1");
+
+    uint32_t board_hits = 0;
+    const auto board_start = clock::now();
+
+    for (size_t i = 0; i < PROBES; i++) {
+        board_hits += Kpk::probe(board).value_or(false);
+    }
+
+    const auto board_end = clock::now();
+
+    std::cout << "board probe: "
+              << std::chrono::duration<double, std::nano>(board_end -
+                                                          board_start)
+                         .count() /
+                     PROBES
+              << " ns/probe (" << board_hits << " wins)\n";
+
+    return 0;
+}
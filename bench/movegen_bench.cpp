@@ -0,0 +1,120 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "MoveGenerator.hpp"
+
+namespace {
+using clock = std::chrono::steady_clock;
+
+/**
+ * @brief Counts the leaves of the legal move tree
+ */
+uint64_t perft(dreamchess::Board &board, uint16_t depth) {
+    dreamchess::MoveList moves;
+    dreamchess::MoveGenerator::legal(board, moves);
+
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    uint64_t nodes = 0;
+
+    for (const auto &move : moves) {
+        const dreamchess::Board::Undo undo = board.undo(move);
+        board.make_move(move);
+        nodes += perft(board, depth - 1);
+        board.unmake_move(move, undo);
+    }
+
+    return nodes;
+}
+
+/**
+ * @brief Positions of a random game, for the validation loop
+ */
+std::vector<dreamchess::Board> positions(uint32_t count) {
+    std::vector<dreamchess::Board> result;
+    dreamchess::Board board{};
+    uint64_t seed = 2021;
+
+    while (result.size() < count) {
+        dreamchess::MoveList moves;
+        dreamchess::MoveGenerator::legal(board, moves);
+
+        if (moves.size() == 0 || board.halfmove_clock() > 40) {
+            board = dreamchess::Board{};
+            continue;
+        }
+
+        result.push_back(board);
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        board.make_move(moves[(seed >> 33) % moves.size()]);
+    }
+
+    return result;
+}
+}    // namespace
+
+int main() {
+    constexpr std::string_view kiwipete{
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"};
+
+    for (const auto &[fen, depth] :
+         {std::pair{dreamchess::Board::START_FEN, uint16_t{5}},
+          std::pair{kiwipete, uint16_t{4}}}) {
+        dreamchess::Board board{};
+        board.load_fen(fen);
+
+        const auto start = clock::now();
+        const uint64_t nodes = perft(board, depth);
+        const double seconds =
+            std::chrono::duration<double>(clock::now() - start).count();
+
+        std::cout << "perft " << depth << ": " << nodes << " nodes in "
+                  << seconds << " s, " << static_cast<double>(nodes) / seconds
+                  << " nodes/s\n";
+    }
+
+    // The permissive rules of the interactive Game, every source and
+    // destination of the side to move
+    const std::vector<dreamchess::Board> boards = positions(2000);
+    uint64_t checked = 0;
+    uint64_t valid = 0;
+    const auto start = clock::now();
+
+    for (const auto &board : boards) {
+        for (int16_t source = 0; source < 64; source++) {
+            const dreamchess::Board::piece_t piece = board.piece_at(source);
+
+            if (dreamchess::Piece::color(piece) != board.turn()) {
+                continue;
+            }
+
+            for (int16_t destination = 0; destination < 64; destination++) {
+                checked++;
+                valid += board.move_is_semi_valid(dreamchess::Move{
+                    source, destination, piece, dreamchess::Piece::NONE});
+            }
+        }
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+
+    std::cout << "move_is_semi_valid: " << checked << " Moves, " << valid
+              << " valid, " << seconds / static_cast<double>(checked) * 1e9
+              << " ns per Move\n";
+
+    return 0;
+}
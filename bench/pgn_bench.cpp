@@ -0,0 +1,207 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "GameStore.hpp"
+#include "GameStoreWriter.hpp"
+#include "MoveGenerator.hpp"
+#include "Pgn.hpp"
+#include "PgnPipeline.hpp"
+#include "PgnReader.hpp"
+#include "PositionIndexBuilder.hpp"
+
+namespace {
+/**
+ * @brief Writes random legal games, as a stand-in for a real dump
+ */
+void generate(const std::string &path, uint32_t games) {
+    std::ofstream file{path};
+    std::mt19937 random{2021};
+
+    for (uint32_t game = 0; game < games; game++) {
+        dreamchess::Board board{};
+        dreamchess::History history;
+
+        for (uint32_t ply = 0; ply < 80 + random() % 80; ply++) {
+            dreamchess::MoveList moves;
+            dreamchess::MoveGenerator::legal(board, moves);
+
+            if (moves.size() == 0) {
+                break;
+            }
+
+            const dreamchess::Move move = moves[random() % moves.size()];
+            history.add_step(board, move);
+            board.make_move(move);
+        }
+
+        dreamchess::Pgn::Tags tags;
+        tags.m_round = std::to_string(game + 1);
+        dreamchess::Pgn::write(file, tags, board, history);
+    }
+}
+}    // namespace
+
+int main(int argc, char **argv) {
+    using clock = std::chrono::steady_clock;
+
+    uint16_t workers = static_cast<uint16_t>(
+        std::max(1U, std::thread::hardware_concurrency()));
+    std::string path;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument{argv[i]};
+
+        if (argument == "-j" && i + 1 < argc) {
+            workers = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else {
+            path = argument;
+        }
+    }
+
+    const bool generated = path.empty();
+
+    if (generated) {
+        path = "pgn_bench.pgn";
+        generate(path, 5000);
+    }
+
+    dreamchess::PgnReader reader;
+
+    if (!reader.open(path)) {
+        std::cerr << "cannot open " << path << "\n";
+        return 1;
+    }
+
+    // Splitting alone, the upper bound of the replay
+    uint64_t games = 0;
+    const auto split_start = clock::now();
+
+    while (reader.next()) {
+        games++;
+    }
+
+    const double split_seconds =
+        std::chrono::duration<double>(clock::now() - split_start).count();
+
+    std::cout << "split: " << games << " games, "
+              << static_cast<double>(reader.text().size()) / 1e6 /
+                     split_seconds
+              << " MB/s\n";
+
+    reader.rewind();
+    const dreamchess::PgnReader::Statistics statistics = reader.replay_all();
+
+    std::cout << "replay: " << statistics.m_games << " games, "
+              << statistics.m_plies << " plies, " << statistics.m_errors
+              << " errors in " << statistics.m_seconds << " s, "
+              << statistics.games_per_second() << " games/s, "
+              << statistics.megabytes_per_second() << " MB/s\n";
+
+    // The pipeline, from one worker to all of them
+    for (uint16_t pool = 1; pool <= workers; pool++) {
+        const dreamchess::PgnReader::Statistics parallel =
+            dreamchess::PgnPipeline{pool}.run(reader.text());
+
+        std::cout << "pipeline, " << pool << " workers: "
+                  << parallel.games_per_second() << " games/s, "
+                  << parallel.megabytes_per_second() << " MB/s, "
+                  << parallel.games_per_second() /
+                         statistics.games_per_second()
+                  << "x\n";
+    }
+
+    // The same games in the binary store
+    const std::string store_path{"pgn_bench.dcgs"};
+    dreamchess::GameStoreWriter writer;
+    writer.open(store_path);
+    reader.rewind();
+
+    for (auto game = reader.next(); game; game = reader.next()) {
+        writer.add_pgn(*game);
+    }
+
+    writer.close();
+
+    dreamchess::GameStore store;
+    store.open(store_path);
+
+    std::ifstream store_file{store_path, std::ios::binary | std::ios::ate};
+    const auto store_bytes = static_cast<double>(store_file.tellg());
+
+    dreamchess::Board board{};
+    uint64_t plies = 0;
+    const auto scan_start = clock::now();
+
+    for (std::size_t game = 0; game < store.size(); game++) {
+        plies += store.replay(game, board).value_or(0);
+    }
+
+    const double scan_seconds =
+        std::chrono::duration<double>(clock::now() - scan_start).count();
+
+    std::cout << "store: " << store.size() << " games, " << store_bytes
+              << " bytes, "
+              << static_cast<double>(reader.text().size()) / store_bytes
+              << "x smaller, scan " << plies << " plies at "
+              << static_cast<double>(store.size()) / scan_seconds
+              << " games/s\n";
+
+    // Every position of the store, then looked up again
+    const std::string index_path{"pgn_bench.dcpi"};
+    const auto index_start = clock::now();
+
+    dreamchess::PositionIndexBuilder{workers}.build(store, index_path);
+
+    const double index_seconds =
+        std::chrono::duration<double>(clock::now() - index_start).count();
+
+    dreamchess::PositionIndex index;
+    index.open(index_path);
+
+    std::mt19937_64 random{2021};
+    uint64_t found = 0;
+    constexpr uint32_t lookups = 100000;
+    const auto lookup_start = clock::now();
+
+    for (uint32_t i = 0; i < lookups; i++) {
+        // Half of the keys are indexed, half are not
+        const uint64_t key =
+            i % 2 == 0 ? index.entries()[random() % index.size()].m_key
+                       : random();
+        const auto [begin, end] = index.find(key);
+        found += static_cast<uint64_t>(end - begin);
+    }
+
+    const double lookup_seconds =
+        std::chrono::duration<double>(clock::now() - lookup_start).count();
+
+    std::cout << "index: " << index.size() << " positions in "
+              << index_seconds << " s with " << workers << " threads, "
+              << lookup_seconds / lookups * 1e6 << " us per lookup, " << found
+              << " hits\n";
+
+    index.close();
+    std::remove(index_path.c_str());
+    std::remove(store_path.c_str());
+
+    if (generated) {
+        std::remove(path.c_str());
+    }
+
+    return 0;
+}
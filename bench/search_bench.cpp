@@ -0,0 +1,126 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "Search.hpp"
+
+namespace {
+/**
+ * @brief Openings, middlegames and endgames, quiet and tactical
+ */
+constexpr std::array<std::string_view, 8> SUITE{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/3P4/2NBPN2/PP3PPP/R2Q1RK1 w - - 0 10",
+    "2rq1rk1/pb1nbppp/1p2pn2/2pp4/2PP4/1PN1PN2/PB2BPPP/2RQ1RK1 w - - 0 12",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+    "8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1"};
+
+struct Configuration final {
+    std::string_view m_name;
+    dreamchess::Search::Options m_options;
+};
+
+dreamchess::Search::Options only(bool dreamchess::Search::Options::*technique) {
+    dreamchess::Search::Options options{false, false, false, false, false};
+
+    if (technique != nullptr) {
+        options.*technique = true;
+    }
+
+    return options;
+}
+}    // namespace
+
+int main(int argc, char *argv[]) {
+    using clock = std::chrono::steady_clock;
+    using dreamchess::Search;
+
+    const int16_t depth =
+        argc > 1 ? static_cast<int16_t>(std::atoi(argv[1])) : int16_t{5};
+
+    const std::array<Configuration, 7> configurations{
+        {{"none", only(nullptr)},
+         {"pvs", only(&Search::Options::m_pvs)},
+         {"aspiration", only(&Search::Options::m_aspiration)},
+         {"null move", only(&Search::Options::m_null_move)},
+         {"lmr", only(&Search::Options::m_late_move_reductions)},
+         {"futility", only(&Search::Options::m_futility)},
+         {"all", Search::Options{}}}};
+
+    std::vector<dreamchess::Board> boards(SUITE.size());
+
+    for (size_t i = 0; i < SUITE.size(); i++) {
+        boards[i].load_fen(SUITE[i]);
+    }
+
+    std::cout << "depth " << depth << ", " << SUITE.size() << " positions\n"
+              << std::left << std::setw(12) << "technique" << std::right
+              << std::setw(12) << "nodes" << std::setw(10) << "nodes %"
+              << std::setw(12) << "time ms" << std::setw(10) << "time %"
+              << std::setw(15) << "same best move" << '\n';
+
+    // Baseline of "none", the first configuration
+    uint64_t base_nodes = 0;
+    double base_time = 0;
+    std::vector<dreamchess::Move> base_moves;
+
+    for (const auto &configuration : configurations) {
+        Search search{};
+        search.set_options(configuration.m_options);
+
+        Search::Limits limits{};
+        limits.m_depth = depth;
+
+        uint64_t nodes = 0;
+        size_t same = 0;
+        std::vector<dreamchess::Move> moves;
+
+        const auto start = clock::now();
+
+        for (const auto &board : boards) {
+            const std::vector<dreamchess::Move> pv =
+                search.think(board, limits);
+            nodes += search.nodes();
+            moves.push_back(pv.empty() ? dreamchess::Move{} : pv.front());
+        }
+
+        const double time =
+            std::chrono::duration<double, std::milli>(clock::now() - start)
+                .count();
+
+        if (base_moves.empty()) {
+            base_nodes = nodes;
+            base_time = time;
+            base_moves = moves;
+        }
+
+        for (size_t i = 0; i < moves.size(); i++) {
+            same += moves[i] == base_moves[i];
+        }
+
+        std::cout << std::left << std::setw(12) << configuration.m_name
+                  << std::right << std::setw(12) << nodes << std::setw(10)
+                  << std::fixed << std::setprecision(1)
+                  << 100.0 * static_cast<double>(nodes) /
+                         static_cast<double>(base_nodes)
+                  << std::setw(12) << time << std::setw(10)
+                  << 100.0 * time / base_time << std::setw(13) << same << "/"
+                  << moves.size() << '\n';
+    }
+}
@@ -0,0 +1,455 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameServer.hpp"
+#include "MoveGenerator.hpp"
+
+namespace {
+using clock = std::chrono::steady_clock;
+
+/**
+ * @brief Plies after which a session is closed and a new one started
+ */
+constexpr uint16_t MAX_PLIES{200};
+
+/**
+ * @brief A game played by the load generator, mirrored on its side
+ */
+struct Session final {
+    uint64_t m_id{0};
+    dreamchess::Board m_board{};
+    uint16_t m_plies{0};
+};
+
+/**
+ * @brief A command waiting for its reply
+ */
+struct Request final {
+    enum Kind : uint8_t { NEW, MOVE, CLOSE };
+
+    Kind m_kind;
+    std::size_t m_session;
+    std::optional<dreamchess::Move> m_move;
+    clock::time_point m_sent;
+};
+
+/**
+ * @brief A connection and the sessions it carries
+ */
+struct Client final {
+    int m_fd{-1};
+    std::string m_input{};
+    std::string m_output{};
+    std::deque<Request> m_pending{};
+    bool m_writing{false};
+};
+
+/**
+ * @brief What a loader thread measured
+ */
+struct Result final {
+    uint64_t m_moves{0};
+    uint64_t m_games{0};
+    uint64_t m_errors{0};
+    std::vector<uint32_t> m_latencies{};
+};
+
+void usage() {
+    std::cerr << "usage: server_bench [-j workers] [-t threads] "
+                 "[-c connections] [-s sessions] [-d seconds] "
+                 "[port | unix-path]\n"
+                 "  without an address, a server is started in-process\n";
+}
+
+int connect_to(const std::string &address) {
+    const bool unix_socket = address.find('/') != std::string::npos;
+    const int fd = socket(unix_socket ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+    int status = -1;
+
+    if (unix_socket) {
+        sockaddr_un remote{};
+        remote.sun_family = AF_UNIX;
+        std::strncpy(remote.sun_path, address.c_str(),
+                     sizeof(remote.sun_path) - 1);
+        status = connect(fd, reinterpret_cast<sockaddr *>(&remote),
+                         sizeof(remote));
+    } else {
+        sockaddr_in remote{};
+        remote.sin_family = AF_INET;
+        remote.sin_port = htons(static_cast<uint16_t>(std::stoul(address)));
+        remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        status = connect(fd, reinterpret_cast<sockaddr *>(&remote),
+                         sizeof(remote));
+
+        const int no_delay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    }
+
+    if (status != 0) {
+        close(fd);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    return fd;
+}
+
+/**
+ * @brief Writes a Move the way Game::make_move() reads it
+ */
+void append_move(std::string &line, const dreamchess::Move &move) {
+    const auto append_square = [&line](int16_t square) {
+        line.push_back(static_cast<char>('a' + square % 8));
+        line.push_back(static_cast<char>('1' + square / 8));
+    };
+
+    append_square(move.source());
+    line.push_back('-');
+    append_square(move.destination());
+
+    if (move.promotion_piece() != dreamchess::Piece::NONE) {
+        line.push_back('=');
+        line.push_back(dreamchess::Piece::to_fen(move.promotion_piece()));
+    }
+}
+
+/**
+ * @brief Keeps every session of some connections busy until the deadline
+ */
+Result load(const std::string &address, std::size_t connections,
+            std::size_t sessions, clock::time_point deadline, uint64_t seed) {
+    Result result;
+    std::mt19937_64 random{seed};
+    std::vector<Session> games(sessions);
+    std::vector<Client> clients(connections);
+    const int epoll = epoll_create1(0);
+
+    const auto send = [&result](Client &client, Request::Kind kind,
+                                std::size_t session, std::string &&line,
+                                std::optional<dreamchess::Move> move = {}) {
+        client.m_output.append(line);
+        client.m_pending.push_back({kind, session, move, clock::now()});
+    };
+
+    const auto start = [&](Client &client, std::size_t session) {
+        if (clock::now() < deadline) {
+            send(client, Request::NEW, session, "new\n");
+        }
+    };
+
+    const auto play = [&](Client &client, std::size_t session) {
+        Session &game = games[session];
+        dreamchess::MoveList moves;
+        dreamchess::MoveGenerator::legal(game.m_board, moves);
+
+        if (moves.size() == 0 || game.m_plies >= MAX_PLIES) {
+            result.m_games++;
+            send(client, Request::CLOSE, session,
+                 "close " + std::to_string(game.m_id) + "\n");
+            start(client, session);
+            return;
+        }
+
+        if (clock::now() >= deadline) {
+            return;
+        }
+
+        const dreamchess::Move move = moves[random() % moves.size()];
+        std::string line = "move " + std::to_string(game.m_id) + " ";
+        append_move(line, move);
+        line.push_back('\n');
+        send(client, Request::MOVE, session, std::move(line), move);
+    };
+
+    const auto flush = [epoll](Client &client) {
+        std::size_t sent = 0;
+
+        while (sent < client.m_output.size()) {
+            const ssize_t bytes =
+                write(client.m_fd, client.m_output.data() + sent,
+                      client.m_output.size() - sent);
+
+            if (bytes <= 0) {
+                break;
+            }
+
+            sent += static_cast<std::size_t>(bytes);
+        }
+
+        client.m_output.erase(0, sent);
+
+        const bool writing = !client.m_output.empty();
+
+        if (writing != client.m_writing) {
+            epoll_event event{};
+            event.events = writing ? EPOLLIN | EPOLLOUT : EPOLLIN;
+            event.data.ptr = &client;
+            epoll_ctl(epoll, EPOLL_CTL_MOD, client.m_fd, &event);
+            client.m_writing = writing;
+        }
+    };
+
+    const auto reply = [&](Client &client, std::string_view line) {
+        const Request request = client.m_pending.front();
+        client.m_pending.pop_front();
+        Session &game = games[request.m_session];
+
+        switch (request.m_kind) {
+            case Request::NEW:
+                game.m_id = std::stoull(std::string{line.substr(3)});
+                game.m_board = dreamchess::Board::start_position();
+                game.m_plies = 0;
+                play(client, request.m_session);
+                break;
+            case Request::MOVE:
+                result.m_latencies.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        clock::now() - request.m_sent)
+                        .count()));
+
+                if (line == "ok") {
+                    result.m_moves++;
+                    game.m_board.make_move(*request.m_move);
+                    game.m_plies++;
+                    play(client, request.m_session);
+                    break;
+                }
+
+                // The Game is over, or rejected a Move
+                if (line.substr(0, 3) == "end") {
+                    result.m_moves++;
+                } else {
+                    result.m_errors++;
+                }
+
+                game.m_plies = MAX_PLIES;
+                play(client, request.m_session);
+                break;
+            case Request::CLOSE:
+                result.m_errors += line != "ok";
+                break;
+        }
+    };
+
+    for (std::size_t i = 0; i < connections; i++) {
+        clients[i].m_fd = connect_to(address);
+
+        if (clients[i].m_fd == -1) {
+            std::cerr << "cannot connect to " << address << "\n";
+            return result;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = &clients[i];
+        epoll_ctl(epoll, EPOLL_CTL_ADD, clients[i].m_fd, &event);
+    }
+
+    for (std::size_t session = 0; session < sessions; session++) {
+        start(clients[session % connections], session);
+    }
+
+    for (auto &client : clients) {
+        flush(client);
+    }
+
+    std::array<epoll_event, 64> events{};
+    std::array<char, 65536> buffer{};
+    std::size_t pending = sessions;
+
+    while (pending != 0) {
+        const int ready = epoll_wait(epoll, events.data(),
+                                     static_cast<int>(events.size()), 1000);
+
+        for (int i = 0; i < ready; i++) {
+            Client &client = *static_cast<Client *>(events[i].data.ptr);
+
+            for (;;) {
+                const ssize_t bytes =
+                    read(client.m_fd, buffer.data(), buffer.size());
+
+                if (bytes <= 0) {
+                    break;
+                }
+
+                client.m_input.append(buffer.data(),
+                                      static_cast<std::size_t>(bytes));
+            }
+
+            std::string_view input{client.m_input};
+
+            for (std::size_t end = input.find('\n');
+                 end != std::string_view::npos; end = input.find('\n')) {
+                reply(client, input.substr(0, end));
+                input.remove_prefix(end + 1);
+            }
+
+            client.m_input.erase(0, client.m_input.size() - input.size());
+            flush(client);
+        }
+
+        pending = 0;
+
+        for (const auto &client : clients) {
+            pending += client.m_pending.size();
+        }
+    }
+
+    for (auto &client : clients) {
+        close(client.m_fd);
+    }
+
+    close(epoll);
+
+    return result;
+}
+}    // namespace
+
+int main(int argc, char **argv) {
+    uint16_t workers = static_cast<uint16_t>(
+        std::max(1U, std::thread::hardware_concurrency()));
+    uint16_t threads = 1;
+    std::size_t connections = 100;
+    std::size_t sessions = 10000;
+    double seconds = 5;
+    std::string address;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument{argv[i]};
+
+        if (argument == "-j" && i + 1 < argc) {
+            workers = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else if (argument == "-t" && i + 1 < argc) {
+            threads = static_cast<uint16_t>(
+                std::max(1UL, std::stoul(argv[++i])));
+        } else if (argument == "-c" && i + 1 < argc) {
+            connections = std::max(1UL, std::stoul(argv[++i]));
+        } else if (argument == "-s" && i + 1 < argc) {
+            sessions = std::stoul(argv[++i]);
+        } else if (argument == "-d" && i + 1 < argc) {
+            seconds = std::stod(argv[++i]);
+        } else if (argument[0] != '-') {
+            address = argument;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    connections = std::max<std::size_t>(connections, threads);
+    sessions = std::max(sessions, connections);
+
+    dreamchess::GameServer server{workers};
+    std::thread hosting;
+
+    if (address.empty()) {
+        if (!server.listen_tcp(0)) {
+            std::cerr << "cannot listen\n";
+            return 1;
+        }
+
+        address = std::to_string(server.port());
+        hosting = std::thread{&dreamchess::GameServer::run, &server};
+    }
+
+    const auto start = clock::now();
+    const auto deadline =
+        start + std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(seconds));
+
+    std::vector<Result> results(threads);
+    std::vector<std::thread> loaders;
+
+    for (uint16_t thread = 0; thread < threads; thread++) {
+        const std::size_t first_connection = connections * thread / threads;
+        const std::size_t last_connection =
+            connections * (thread + 1) / threads;
+
+        loaders.emplace_back([&, thread, first_connection, last_connection] {
+            results[thread] =
+                load(address, last_connection - first_connection,
+                     sessions * (thread + 1) / threads -
+                         sessions * thread / threads,
+                     deadline, 2021 + thread);
+        });
+    }
+
+    for (auto &loader : loaders) {
+        loader.join();
+    }
+
+    const double elapsed =
+        std::chrono::duration<double>(clock::now() - start).count();
+
+    Result total;
+
+    for (auto &result : results) {
+        total.m_moves += result.m_moves;
+        total.m_games += result.m_games;
+        total.m_errors += result.m_errors;
+        total.m_latencies.insert(total.m_latencies.end(),
+                                 result.m_latencies.begin(),
+                                 result.m_latencies.end());
+    }
+
+    std::sort(total.m_latencies.begin(), total.m_latencies.end());
+
+    const auto percentile = [&total](double rank) -> uint32_t {
+        if (total.m_latencies.empty()) {
+            return 0;
+        }
+
+        return total.m_latencies[static_cast<std::size_t>(
+            rank * static_cast<double>(total.m_latencies.size() - 1))];
+    };
+
+    std::cout << sessions << " sessions over " << connections
+              << " connections, " << threads << " load threads\n"
+              << total.m_moves << " moves in " << elapsed << " s, "
+              << static_cast<double>(total.m_moves) / elapsed
+              << " moves/s, " << total.m_games << " games, "
+              << total.m_errors << " errors\n"
+              << "latency: p50 " << percentile(0.5) << " us, p99 "
+              << percentile(0.99) << " us, max " << percentile(1.0)
+              << " us\n";
+
+    if (hosting.joinable()) {
+        server.stop();
+        hosting.join();
+
+        std::cout << "server: " << workers << " workers, "
+                  << server.sessions().size() << " sessions left open, "
+                  << server.sessions().pooled() << " Games pooled\n";
+    }
+
+    return 0;
+}
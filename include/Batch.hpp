@@ -0,0 +1,137 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "Game.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Batch
+ * @brief Replays recorded games through Game::make_move(), with no rendering
+ * @details Every input line is a game from the initial position: moves in
+ * the interactive syntax, separated by blanks. Empty lines and lines starting
+ * with '#' are skipped. A game stops at its first rejected move. Every game
+ * gets one result line:
+ *
+ *     <game> ok <moves> <fen>
+ *     <game> over <moves> <fen>
+ *     <game> over <moves> <move> <fen>
+ *     <game> syntax <moves> <move> <fen>
+ *     <game> illegal <moves> <move> <fen>
+ *
+ * where "over" means the game ended on its last move, or before <move> which
+ * is then rejected, <moves> counts the moves played and <move> is the
+ * rejected one. Results are collected in a
+ * buffer, written out when it grows past BUFFER_SIZE and by finish()
+ */
+class Batch final {
+public:
+    /**
+     * @struct Totals
+     * @brief Counters over all the games replayed
+     */
+    struct Totals final {
+        /**
+         * @brief Games replayed
+         */
+        uint64_t m_games{0};
+
+        /**
+         * @brief Moves played
+         */
+        uint64_t m_moves{0};
+
+        /**
+         * @brief Games stopped by a rejected move
+         */
+        uint64_t m_rejected{0};
+    };
+
+    /**
+     * @brief Bytes of results collected before writing them out
+     */
+    static constexpr std::size_t BUFFER_SIZE{1 << 20};
+
+    /**
+     * @fn Batch(std::ostream &)
+     * @brief Creates a Batch
+     * @param output Where the results are written to
+     */
+    explicit Batch(std::ostream &);
+
+    /**
+     * @fn ~Batch()
+     * @brief Writes out the results still buffered
+     * @see finish()
+     */
+    ~Batch();
+
+    Batch(const Batch &) = delete;
+    Batch &operator=(const Batch &) = delete;
+
+    /**
+     * @fn void run(std::istream &)
+     * @brief Replays every game of an input and writes out the results
+     * @param input The games, one per line
+     */
+    void run(std::istream &);
+
+    /**
+     * @fn void play(std::string_view)
+     * @brief Replays a game and buffers its result
+     * @param line The game
+     */
+    void play(std::string_view);
+
+    /**
+     * @fn void finish()
+     * @brief Writes out the results still buffered and flushes the output
+     */
+    void finish();
+
+    /**
+     * @fn const Totals &totals()
+     * @brief Returns the counters over the games replayed so far
+     * @return The Totals
+     */
+    [[nodiscard]] const Totals &totals() const;
+
+private:
+    /**
+     * @brief Where the results are written to
+     */
+    std::ostream &m_output;
+
+    /**
+     * @brief The results not written yet
+     */
+    std::string m_buffer{};
+
+    /**
+     * @brief The Game every line is replayed on, reset between lines
+     */
+    Game m_game{};
+
+    /**
+     * @brief Counters over the games replayed
+     */
+    Totals m_totals{};
+};
+}    // namespace dreamchess
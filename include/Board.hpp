@@ -10,8 +10,9 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
-#include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Piece.hpp"
@@ -41,21 +42,119 @@ public:
      */
     using piece_array_t = std::array<piece_t, 64>;
 
+    /**
+     * @typedef Defines the packed_t type, a position in 32 bytes
+     * @see pack()
+     */
+    using packed_t = std::array<uint8_t, 32>;
+
+    /**
+     * @enum Castling
+     * @brief Castling rights as Flag Enum
+     */
+    enum Castling : uint8_t {
+        NO_CASTLING = 0,
+        WHITE_KINGSIDE = 1 << 0,
+        WHITE_QUEENSIDE = 1 << 1,
+        BLACK_KINGSIDE = 1 << 2,
+        BLACK_QUEENSIDE = 1 << 3,
+        ALL_CASTLING = WHITE_KINGSIDE | WHITE_QUEENSIDE | BLACK_KINGSIDE |
+                       BLACK_QUEENSIDE
+    };
+
+    /**
+     * @brief The neutral FEN string
+     */
+    static constexpr std::string_view START_FEN{
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
+
+    /**
+     * @brief Bits per Piece kind of the material key
+     */
+    static constexpr uint16_t MATERIAL_BITS{4};
+
+    /**
+     * @brief Value of en_passant() when no en-passant capture is possible
+     */
+    static constexpr int16_t NO_SQUARE{-1};
+
+    /**
+     * @struct Undo
+     * @brief What a Move destroys, enough to take it back
+     * @see undo()
+     * @see unmake_move()
+     */
+    struct Undo final {
+        /**
+         * @brief The captured Piece, NONE if the Move is not a capture
+         */
+        piece_t m_captured{Piece::NONE};
+
+        /**
+         * @brief Square of the captured Piece, it differs from the
+         * destination on en-passant captures
+         */
+        int16_t m_captured_square{NO_SQUARE};
+
+        /**
+         * @brief Castling rights before the Move
+         */
+        uint8_t m_castling{NO_CASTLING};
+
+        /**
+         * @brief En-passant square before the Move
+         */
+        int16_t m_en_passant{NO_SQUARE};
+
+        /**
+         * @brief Halfmove clock before the Move
+         */
+        uint16_t m_halfmove_clock{0};
+    };
+
+    /**
+     * @struct AttackMap
+     * @brief The squares a side attacks
+     * @details Follows the full chess rules: sliders are blocked, pawns
+     * attack diagonally, squares holding the side's own Pieces are attacked
+     * too when they are defended
+     * @see attack_map()
+     */
+    struct AttackMap final {
+        /**
+         * @brief One bit per attacked square, a1 is bit 0
+         */
+        uint64_t m_attacked{0};
+
+        /**
+         * @brief Number of Pieces attacking each square
+         */
+        std::array<uint8_t, 64> m_attackers{};
+    };
+
     /**
      * @fn Board()
      * @brief Constructs a Board
-     * @details Starts with the neutral FEN string, using init_board()
-     * @see init_board()
+     * @details Starts with the neutral FEN string, copied from
+     * start_position()
+     * @see start_position()
      */
     Board();
 
+    /**
+     * @fn const Board &start_position()
+     * @brief Returns the Board of the neutral FEN string
+     * @details The FEN string is parsed once, every other starting Board is
+     * a copy of this one
+     * @return The starting position
+     */
+    [[nodiscard]] static const Board &start_position();
+
     /**
      * @fn ~Board()
      * @breif Board's class destructor
-     * @details Clears the captures std::map
-     * @see std::map::clear()
      */
-    ~Board();
+    ~Board() = default;
 
     /**
      * @brief Overloads the out-stream operator for the Board
@@ -70,12 +169,84 @@ public:
      * @fn void make_move(const Move &)
      * @brief Makes a move in the current Board
      * @details Checks if the `Move` is a "special move", makes a "normal move
-     * otherwise
+     * otherwise. Castling rights, en-passant square and move counters are
+     * updated accordingly
      * @param move The Move to make
      * @see Piece::type
      */
     void make_move(const Move &);
 
+    /**
+     * @fn Undo undo(const Move &)
+     * @brief Collects what a Move about to be made destroys
+     * @param move The Move, not made yet
+     * @return The Undo to pass to unmake_move() after the Move is made
+     */
+    [[nodiscard]] Undo undo(const Move &) const;
+
+    /**
+     * @fn void unmake_move(const Move &, const Undo &)
+     * @brief Takes back the last Move made
+     * @details Restores the squares, the state and the captured pieces
+     * counters as they were before make_move()
+     * @param move The last Move made
+     * @param undo What undo() returned before the Move was made
+     */
+    void unmake_move(const Move &, const Undo &);
+
+    /**
+     * @fn void make_null_move()
+     * @brief Passes the turn without moving anything
+     * @details Used by the null Move pruning of Search, the en-passant square
+     * is cleared and the move counters are updated as by a quiet Move
+     * @see Search
+     */
+    void make_null_move();
+
+    /**
+     * @fn bool load_fen(std::string_view)
+     * @brief Sets the Board to the position described by a FEN string
+     * @details The halfmove clock and fullmove number fields are optional.
+     * On malformed input the Board is left untouched, as on impossible
+     * material: more than 16 Pieces or 8 pawns per side, not one KING per
+     * side or a pawn on the first or the last rank. The en-passant square
+     * has to be on the sixth rank with WHITE to move, on the third with
+     * BLACK, right behind a pawn of the side which just moved
+     * @param fen The FEN string
+     * @return true if the FEN string has been parsed, false otherwise
+     * @see Piece::to_enum()
+     */
+    bool load_fen(std::string_view);
+
+    /**
+     * @fn std::optional<packed_t> pack()
+     * @brief Packs the position in 32 bytes
+     * @details The occupied squares as a 64 bit set, a nibble per Piece in
+     * square order, then the side to move, castling rights, en-passant
+     * square, halfmove clock and fullmove number. The captured pieces
+     * counters are not stored, as in FEN
+     * @return The packed position, std::nullopt with more than 32 Pieces
+     * @see unpack()
+     */
+    [[nodiscard]] std::optional<packed_t> pack() const;
+
+    /**
+     * @fn bool unpack(const packed_t &)
+     * @brief Sets the Board to a position packed by pack()
+     * @details On malformed input the Board is left untouched, as on the
+     * impossible positions load_fen() rejects
+     * @param packed The packed position
+     * @return true if the position has been unpacked, false otherwise
+     */
+    bool unpack(const packed_t &);
+
+    /**
+     * @fn std::string fen()
+     * @brief Describes the current position as a FEN string
+     * @return The FEN string of the Board
+     */
+    [[nodiscard]] std::string fen() const;
+
     /**
      * @fn bool is_in_game()
      * @brief Checks if the Game is still in progress
@@ -133,14 +304,74 @@ public:
      */
     [[nodiscard]] piece_t piece_at(uint16_t) const;
 
+    /**
+     * @fn uint8_t castling_rights()
+     * @brief Returns the castling rights still available
+     * @return The ORed Castling flags
+     */
+    [[nodiscard]] uint8_t castling_rights() const;
+
+    /**
+     * @fn int16_t en_passant()
+     * @brief Returns the square a pawn can capture en-passant on
+     * @return The en-passant square, NO_SQUARE if there is none
+     */
+    [[nodiscard]] int16_t en_passant() const;
+
+    /**
+     * @fn uint16_t halfmove_clock()
+     * @brief Returns the number of halfmoves since the last capture or pawn
+     * move
+     * @return The halfmove clock
+     */
+    [[nodiscard]] uint16_t halfmove_clock() const;
+
+    /**
+     * @fn uint16_t fullmove_number()
+     * @brief Returns the current fullmove number
+     * @details Starts at 1 and is incremented after each BLACK's move
+     * @return The fullmove number
+     */
+    [[nodiscard]] uint16_t fullmove_number() const;
+
+    /**
+     * @fn uint64_t material_key()
+     * @brief Returns the material signature of the position
+     * @details MATERIAL_BITS bits per Piece kind count the Pieces on the
+     * Board, kings included. Kept up to date by make_move() and
+     * unmake_move(), so it's read in O(1)
+     * @return The material key
+     * @see material_count()
+     */
+    [[nodiscard]] uint64_t material_key() const;
+
+    /**
+     * @fn uint16_t material_count(uint64_t, piece_t)
+     * @brief Reads the number of Pieces of a kind from a material key
+     * @param key The material key
+     * @param piece The Piece kind, color included
+     * @return The number of Pieces, 0 for NONE
+     */
+    [[nodiscard]] static uint16_t material_count(uint64_t, piece_t);
+
+    /**
+     * @fn const AttackMap &attack_map(piece_t)
+     * @brief Returns the squares a side attacks
+     * @details Computed for all the squares at once on the first call, then
+     * kept until the Board changes. The cache is filled by const calls, so a
+     * Board shared between threads must not be asked for it
+     * @param color The attacking side
+     * @return The attack map of the side
+     */
+    [[nodiscard]] const AttackMap &attack_map(piece_t) const;
+
     /**
      * @fn bool square_attacked(uint64_t, piece_t)
      * @brief Checks if a given square is attached by another piece
      * @param index The index number of the square
      * @param turn The playing turn
      * @return The color of the piece which is attacked
-     * @see Piece::color()
-     * @see move_is_semi_valid()
+     * @see attack_map()
      */
     [[nodiscard]] bool square_attacked(uint64_t, piece_t) const;
 
@@ -207,15 +438,72 @@ private:
     piece_array_t m_squares{};
 
     /**
-     * @brief Keeps track of captured pieces
+     * @brief Castling rights still available
+     */
+    uint8_t m_castling{ALL_CASTLING};
+
+    /**
+     * @brief Square behind a pawn which just made a double step
+     */
+    int16_t m_en_passant{NO_SQUARE};
+
+    /**
+     * @brief Halfmoves since the last capture or pawn move
      */
-    std::map<piece_t, uint16_t> m_captured{};
+    uint16_t m_halfmove_clock{0};
+
+    /**
+     * @brief The fullmove number, as in FEN
+     */
+    uint16_t m_fullmove_number{1};
+
+    /**
+     * @brief Keeps track of captured pieces, indexed by color and type
+     * @details A fixed array instead of a map keeps copies of the Board
+     * allocation free
+     */
+    std::array<uint16_t, 12> m_captured{};
+
+    /**
+     * @brief The material signature
+     * @see material_key()
+     */
+    uint64_t m_material_key{0};
+
+    /**
+     * @brief The attack maps of WHITE and BLACK
+     * @see attack_map()
+     */
+    mutable std::array<AttackMap, 2> m_attack_maps{};
+
+    /**
+     * @brief Whether each attack map matches the Board
+     */
+    mutable std::array<bool, 2> m_attack_maps_valid{};
+
+    /**
+     * @fn void set_position(const piece_array_t &, piece_t, uint8_t,
+     * int16_t, uint16_t, uint16_t)
+     * @brief Replaces the whole position, once it has been checked
+     * @details Shared by load_fen() and unpack(), the captured pieces
+     * counters are cleared
+     */
+    void set_position(const piece_array_t &, piece_t, uint8_t, int16_t,
+                      uint16_t, uint16_t);
+
+    /**
+     * @fn Board(std::string_view)
+     * @brief Constructs a Board from a well-formed FEN string
+     * @details Only used to build start_position()
+     * @param fen The FEN string
+     */
+    explicit Board(std::string_view);
 
     /**
      * @fn void init_board()
      * @brief Used to init the board with the neutral FEN configuration
-     * @details Parses the FEN string and inits the Board
-     * @see Piece::to_enum()
+     * @details Copies start_position(), the FEN string is not parsed again
+     * @see start_position()
      */
     void init_board();
 
@@ -226,6 +514,16 @@ private:
      */
     void clear();
 
+    /**
+     * @fn bool move_is_semi_valid_for(const Move &)
+     * @brief move_is_semi_valid() specialized for the side to move
+     * @tparam US The side to move
+     * @param move The Move to check
+     * @return true if the Move is semi-valid, false otherwise
+     */
+    template <piece_t US>
+    [[nodiscard]] bool move_is_semi_valid_for(const Move &) const;
+
     /**
      * @fn int64_t horizontal_check(const Move &)
      * @brief Checks the number of horizontal squares a Move is making
@@ -245,5 +543,7 @@ private:
     [[nodiscard]] int64_t vertical_check(const Move &) const;
 
     friend class Game;
+    friend class MoveGenerator;
+    friend class Tablebase;
 };
 }    // namespace dreamchess
@@ -0,0 +1,137 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Book
+ * @brief Opening book reader
+ * @details Books use the Polyglot .bin entries, but their keys are
+ * Zobrist::key(), whose random values are not Polyglot's: published Polyglot
+ * books never match and books have to be built with Zobrist. The file is
+ * memory-mapped and its 16 bytes big-endian entries (key, move, weight,
+ * learn) are binary-searched. Probing never allocates
+ */
+class Book final {
+public:
+    /**
+     * @brief Size of an entry in bytes
+     */
+    static constexpr std::size_t ENTRY_SIZE{16};
+
+    /**
+     * @brief Maximum number of Moves returned for a position
+     */
+    static constexpr std::size_t MAX_ENTRIES{32};
+
+    /**
+     * @struct Entry
+     * @brief A book Move and its weight
+     */
+    struct Entry final {
+        Move m_move{};
+        uint16_t m_weight{0};
+    };
+
+    /**
+     * @typedef Defines the entry_list_t type, filled by probe()
+     */
+    using entry_list_t = std::array<Entry, MAX_ENTRIES>;
+
+    /**
+     * @fn Book()
+     * @brief Creates a Book with no file
+     */
+    Book() = default;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Maps a book
+     * @param path The .bin file path
+     * @return true if the file has been mapped and its size is a multiple of
+     * ENTRY_SIZE, false otherwise
+     * @see MappedFile::open()
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void close()
+     * @brief Unmaps the book
+     */
+    void close();
+
+    /**
+     * @fn bool is_open()
+     * @brief Checks if a book is mapped
+     * @return true if a book is mapped, false otherwise
+     */
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of entries in the book
+     * @return The number of entries
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @fn std::size_t probe(const Board &, entry_list_t &)
+     * @brief Looks for the legal book Moves of a position
+     * @param board The position
+     * @param entries Filled with the Moves found, in file order
+     * @return The number of Moves found
+     * @see Zobrist::key()
+     */
+    std::size_t probe(const Board &, entry_list_t &) const;
+
+    /**
+     * @fn std::optional<Move> pick(const Board &, uint64_t)
+     * @brief Picks a book Move with probability proportional to its weight
+     * @param board The position
+     * @param random A uniformly distributed random number
+     * @return The chosen Move, std::nullopt if the position is out of book
+     */
+    [[nodiscard]] std::optional<Move> pick(const Board &, uint64_t) const;
+
+    /**
+     * @fn uint16_t encode(const Move &)
+     * @brief Encodes a Move in the Polyglot format
+     * @details Castling is encoded as the KING capturing its ROOK
+     * @param move The Move
+     * @return The 16 bits Polyglot move
+     */
+    [[nodiscard]] static uint16_t encode(const Move &);
+
+private:
+    /**
+     * @brief The mapped book file
+     */
+    MappedFile m_file{};
+
+    /**
+     * @fn uint64_t key_at(std::size_t)
+     * @brief Reads the key of an entry
+     */
+    [[nodiscard]] uint64_t key_at(std::size_t) const;
+};
+}    // namespace dreamchess
@@ -0,0 +1,131 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class BoundedQueue
+ * @brief Blocking multi-producer multi-consumer FIFO with a fixed capacity
+ * @details Producers wait while the queue is full, which slows a pipeline
+ * down to the pace of its slowest stage. Once closed, pushes fail and pops
+ * drain the items left
+ * @tparam T The item type
+ */
+template <typename T>
+class BoundedQueue final {
+public:
+    /**
+     * @fn BoundedQueue(std::size_t)
+     * @brief Creates an empty queue
+     * @param capacity Maximum number of items, at least one
+     */
+    explicit BoundedQueue(std::size_t capacity)
+        : m_capacity{capacity == 0 ? 1 : capacity} {}
+
+    /**
+     * @fn bool push(T)
+     * @brief Appends an item, waiting for room
+     * @param item The item
+     * @return false if the queue has been closed, true otherwise
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_not_full.wait(lock, [this] {
+            return m_closed || m_items.size() < m_capacity;
+        });
+
+        if (m_closed) {
+            return false;
+        }
+
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_not_empty.notify_one();
+
+        return true;
+    }
+
+    /**
+     * @fn std::optional<T> pop()
+     * @brief Removes the first item, waiting for one
+     * @return The item, std::nullopt once the queue is closed and empty
+     */
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_not_empty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+
+        if (m_items.empty()) {
+            return std::nullopt;
+        }
+
+        std::optional<T> item{std::move(m_items.front())};
+        m_items.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+
+        return item;
+    }
+
+    /**
+     * @fn void close()
+     * @brief Wakes every waiting thread up, no item is accepted anymore
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_closed = true;
+        }
+
+        m_not_full.notify_all();
+        m_not_empty.notify_all();
+    }
+
+private:
+    /**
+     * @brief Maximum number of items
+     */
+    std::size_t m_capacity;
+
+    /**
+     * @brief The items, oldest first
+     */
+    std::deque<T> m_items{};
+
+    /**
+     * @brief Whether close() has been called
+     */
+    bool m_closed{false};
+
+    /**
+     * @brief Guards the items and the closed flag
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Signaled when an item is popped
+     */
+    std::condition_variable m_not_full;
+
+    /**
+     * @brief Signaled when an item is pushed
+     */
+    std::condition_variable m_not_empty;
+};
+}    // namespace dreamchess
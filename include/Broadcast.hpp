@@ -0,0 +1,198 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Broadcast
+ * @brief Publishes a Game to any number of reader threads
+ * @details One thread, the one playing the Game, publishes. The current
+ * position is kept behind a sequence lock: the writer never waits, a reader
+ * copies it and retries if a publication overlapped the copy. Every Move is
+ * also pushed to a ring of events, which readers follow at their own pace
+ * with a Cursor. A reader falling more than the ring's capacity behind
+ * loses the oldest events, the writer never waits for it either
+ */
+class Broadcast final {
+public:
+    /**
+     * @struct Snapshot
+     * @brief A published position
+     */
+    struct Snapshot final {
+        /**
+         * @brief The position
+         * @see Board::pack()
+         */
+        Board::packed_t m_board;
+
+        /**
+         * @brief Number of events published before it
+         */
+        uint64_t m_sequence;
+    };
+
+    /**
+     * @struct Event
+     * @brief A change of the Game
+     */
+    struct Event final {
+        /**
+         * @enum Kind
+         * @brief What happened
+         */
+        enum Kind : uint8_t { MOVE = 0, RESET };
+
+        /**
+         * @brief Index of the event, from 0
+         */
+        uint64_t m_sequence;
+
+        /**
+         * @brief What happened
+         */
+        Kind m_kind;
+
+        /**
+         * @brief The Move, for MOVE events
+         */
+        Move m_move;
+    };
+
+    /**
+     * @struct Cursor
+     * @brief Where a reader is in the ring of events
+     * @see subscribe()
+     */
+    struct Cursor final {
+        /**
+         * @brief The next event to read
+         */
+        uint64_t m_next{0};
+
+        /**
+         * @brief Events overwritten before the reader got to them
+         */
+        uint64_t m_lost{0};
+    };
+
+    /**
+     * @fn Broadcast(std::size_t)
+     * @brief Creates a Broadcast with nothing published
+     * @param capacity The number of events kept, rounded up to a power of 2
+     */
+    explicit Broadcast(std::size_t = 1024);
+
+    Broadcast(const Broadcast &) = delete;
+    Broadcast &operator=(const Broadcast &) = delete;
+
+    /**
+     * @fn void publish_move(const Move &, const Board &)
+     * @brief Publishes a Move and the position it led to
+     * @details Writer thread only
+     * @param move The Move made
+     * @param board The position after the Move
+     */
+    void publish_move(const Move &, const Board &);
+
+    /**
+     * @fn void publish_reset(const Board &)
+     * @brief Publishes the start of a new Game
+     * @details Writer thread only
+     * @param board The new position
+     */
+    void publish_reset(const Board &);
+
+    /**
+     * @fn std::optional<Snapshot> snapshot()
+     * @brief Copies the current position
+     * @details Never blocks the writer, retries while it publishes
+     * @return The position, std::nullopt if nothing has been published
+     */
+    [[nodiscard]] std::optional<Snapshot> snapshot() const;
+
+    /**
+     * @fn Cursor subscribe()
+     * @brief Starts following the events
+     * @return A Cursor on the next event to be published
+     */
+    [[nodiscard]] Cursor subscribe() const;
+
+    /**
+     * @fn std::optional<Event> poll(Cursor &)
+     * @brief Reads the next event of a reader
+     * @details Skips the events already overwritten, counting them as lost
+     * @param cursor The reader's Cursor, moved past the event
+     * @return The event, std::nullopt if the reader is up to date
+     */
+    [[nodiscard]] std::optional<Event> poll(Cursor &) const;
+
+    /**
+     * @fn std::size_t capacity()
+     * @brief Returns the number of events kept
+     * @return The capacity of the ring
+     */
+    [[nodiscard]] std::size_t capacity() const;
+
+private:
+    /**
+     * @brief Words of a published position: the packed Board, then the
+     * sequence
+     */
+    static constexpr std::size_t SNAPSHOT_WORDS{
+        sizeof(Board::packed_t) / sizeof(uint64_t) + 1};
+
+    /**
+     * @brief Odd while the position is written, 0 if never written
+     */
+    alignas(64) std::atomic<uint64_t> m_version{0};
+
+    /**
+     * @brief The position, written and read a word at a time
+     */
+    std::array<std::atomic<uint64_t>, SNAPSHOT_WORDS> m_snapshot{};
+
+    /**
+     * @brief The number of events published
+     */
+    alignas(64) std::atomic<uint64_t> m_head{0};
+
+    /**
+     * @brief capacity() - 1
+     */
+    std::size_t m_mask;
+
+    /**
+     * @brief The ring, each slot holds an event's index and its encoding
+     */
+    std::unique_ptr<std::atomic<uint64_t>[]> m_ring;
+
+    /**
+     * @fn void publish(uint32_t, const Board &)
+     * @brief Pushes an event, then publishes the position
+     * @param code The encoded event
+     * @param board The position after the event
+     */
+    void publish(uint32_t, const Board &);
+};
+}    // namespace dreamchess
@@ -0,0 +1,85 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "Board.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Endgame
+ * @brief Classifies positions by their material
+ * @details The classes of every material with at most a pawn, two knights,
+ * two bishops, a rook and a queen per side are computed at compile time.
+ * The material key of the Board indexes that table, so classifying a
+ * position costs a few shifts; any other material is GENERIC
+ * @see Board::material_key()
+ */
+class Endgame final {
+public:
+    /**
+     * @enum Class
+     * @brief Endgames with a known outcome or a specialized evaluation
+     */
+    enum Class : uint8_t {
+        GENERIC = 0,
+        INSUFFICIENT_MATERIAL,
+        BISHOPS_ONLY,
+        KNNK,
+        KPK,
+        KBNK,
+        KXK
+    };
+
+    /**
+     * @brief Per side: pawns (0-1) x knights (0-2) x bishops (0-2) x rooks
+     * (0-1) x queens (0-1)
+     */
+    static constexpr uint16_t SIDE_MATERIALS{2 * 3 * 3 * 2 * 2};
+
+    /**
+     * @fn Class classify(uint64_t)
+     * @brief Classifies a material
+     * @param key The material key
+     * @return The Class, GENERIC if the material is not in the table
+     * @details
+     * - INSUFFICIENT_MATERIAL: bare kings, or a single minor piece
+     * - BISHOPS_ONLY: a bishop per side, a dead draw if they share the
+     *   square color
+     * - KNNK: two knights against a bare king, which can't force a mate
+     * - KPK: king and pawn against king, solved by Kpk
+     * - KBNK: bishop and knight against a bare king, mated in a corner
+     * - KXK: a rook, a queen or two bishops against a bare king, mated on
+     *   an edge
+     */
+    [[nodiscard]] static Class classify(uint64_t);
+
+    /**
+     * @fn Class classify(const Board &)
+     * @brief Classifies a position by its material
+     * @param board The position
+     * @return The Class
+     */
+    [[nodiscard]] static Class classify(const Board &);
+
+    /**
+     * @fn bool is_dead_draw(const Board &)
+     * @brief Checks if neither side can ever mate
+     * @param board The position
+     * @return true for INSUFFICIENT_MATERIAL and for same colored BISHOPS_ONLY,
+     * false otherwise
+     */
+    [[nodiscard]] static bool is_dead_draw(const Board &);
+};
+}    // namespace dreamchess
@@ -0,0 +1,52 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Board.hpp"
+#include "Piece.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Evaluation
+ * @brief Static evaluation of a Board
+ * @details Material plus piece-square bonuses, in centipawns. Endgames
+ * classified by Endgame are dispatched to specialized evaluations
+ * @see Endgame::classify()
+ */
+class Evaluation final {
+public:
+    /**
+     * @brief Bonus of a position known to be won, below any mate score
+     */
+    static constexpr int32_t KNOWN_WIN{10000};
+
+    /**
+     * @fn int32_t evaluate(const Board &)
+     * @brief Evaluates a position
+     * @param board The position
+     * @return The score from the side to move's point of view
+     */
+    [[nodiscard]] static int32_t evaluate(const Board &);
+
+    /**
+     * @fn int32_t piece_value(Board::piece_t)
+     * @brief Returns the material value of a Piece, regardless of its color
+     * @param piece The Piece
+     * @return The value in centipawns, 0 for NONE and KING
+     */
+    [[nodiscard]] static int32_t piece_value(Board::piece_t);
+};
+}    // namespace dreamchess
@@ -7,14 +7,26 @@
  */
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "Board.hpp"
+#include "Book.hpp"
+#include "Broadcast.hpp"
 #include "History.hpp"
+#include "Journal.hpp"
+#include "Pgn.hpp"
 #include "Piece.hpp"
+#include "RepetitionTable.hpp"
+#include "Search.hpp"
+#include "TimeManager.hpp"
 
 /**
  * @namespace dreamchess
@@ -31,6 +43,17 @@ struct Move;
  */
 class Game final {
 public:
+    /**
+     * @enum DrawReason
+     * @brief Why a Game ended in a draw
+     */
+    enum DrawReason : uint8_t {
+        NO_DRAW = 0,
+        INSUFFICIENT_MATERIAL,
+        THREEFOLD_REPETITION,
+        FIFTY_MOVES
+    };
+
     /**
      * @fn Game()
      * @brief Creates a Game object
@@ -40,28 +63,85 @@ public:
     friend std::ostream &operator<<(std::ostream &, const Game &);
 
     /**
-     * @fn Board board()
-     * @breif The Board getter
+     * @fn const Board &board()
+     * @brief The Board getter
+     * @details Only for the thread playing the Game, other threads read the
+     * position from a Broadcast
      * @return The Board member of Game
+     * @see broadcast_to()
+     */
+    [[nodiscard]] const Board &board() const;
+
+    /**
+     * @fn const History &history()
+     * @brief The History getter
+     * @return The History member of Game
+     */
+    [[nodiscard]] const History &history() const;
+
+    /**
+     * @typedef Defines the destinations_t type, a square set per source
      */
-    [[nodiscard]] Board board() const;
+    using destinations_t = std::array<uint64_t, 64>;
+
+    /**
+     * @fn const destinations_t &destinations()
+     * @brief Returns where every Piece of the side to move can go
+     * @details Bit d of entry s is set if make_move() accepts the Move from s
+     * to d, promoting to a Queen. Computed on the first call after a change
+     * of the position, then cached
+     * @return The destinations, by source square
+     */
+    [[nodiscard]] const destinations_t &destinations() const;
+
+    /**
+     * @fn uint64_t destinations(uint16_t)
+     * @brief Returns where the Piece on a square can go
+     * @param source The square
+     * @return The destination squares, 0 if the Piece can't move or belongs
+     * to the side not to move
+     * @see destinations()
+     */
+    [[nodiscard]] uint64_t destinations(uint16_t) const;
 
     /**
      * @fn bool is_in_game()
      * @brief Checks if the game is still going on
      * @return true if a game is being played, false otherwise
      * @see Board::is_in_game()
+     * @see draw_reason()
      */
     [[nodiscard]] bool is_in_game() const;
 
     /**
-     * @fn bool is_move_syntax_correct(const std::string &)
-     * @brief Checks the input move syntactic correctness via regex
-     * @param input_move The std::string to be checked
+     * @fn DrawReason draw_reason()
+     * @brief Checks if the current position is a draw
+     * @details A position where neither side can mate, the third occurrence
+     * of a position and the hundredth halfmove without captures or pawn Moves
+     * end the Game, unless that last Move mates
+     * @return Why the Game is drawn, NO_DRAW if it isn't
+     * @see Endgame::is_dead_draw()
+     * @see RepetitionTable
+     */
+    [[nodiscard]] DrawReason draw_reason() const;
+
+    /**
+     * @fn std::string_view describe(DrawReason)
+     * @brief Describes a DrawReason
+     * @param reason The DrawReason
+     * @return A human readable description, empty for NO_DRAW
+     */
+    [[nodiscard]] static std::string_view describe(DrawReason);
+
+    /**
+     * @fn bool is_move_syntax_correct(std::string_view)
+     * @brief Checks the input move syntactic correctness, e2-e4 or e7-e8=Q
+     * @details Checked by hand, matching a std::regex costs more than playing
+     * the move
+     * @param input_move The move to be checked
      * @return true if input_move respects the syntax, false otherwise
-     * @see std::regex_match()
      */
-    [[nodiscard]] static bool is_move_syntax_correct(const std::string &);
+    [[nodiscard]] static bool is_move_syntax_correct(std::string_view);
 
     /**
      * @fn bool make_move(std::string_view)
@@ -76,6 +156,39 @@ public:
      */
     bool make_move(std::string_view);
 
+    /**
+     * @fn std::optional<Move> book_move(const Book &, uint64_t)
+     * @brief Looks the current position up in an opening book
+     * @details Meant to be queried before any thinking begins
+     * @param book The opening book
+     * @param random A uniformly distributed random number
+     * @return A weighted random book Move, std::nullopt if out of book
+     * @see Book::pick()
+     */
+    [[nodiscard]] std::optional<Move> book_move(const Book &, uint64_t) const;
+
+    /**
+     * @fn std::optional<Move> engine_move(const Search::Limits &)
+     * @brief Lets the engine play the side to move
+     * @details Searches on the calling thread, within the deadlines the
+     * TimeManager derives from the limits, then plays the best Move as
+     * make_move() does. The limits can't be infinite nor pondering
+     * @param limits The clock, increment and moves to go of the side to move,
+     * or a fixed move time, depth or node limit
+     * @return The Move played, std::nullopt if the Game is over or the side
+     * to move has no legal Move
+     * @see Search::think()
+     */
+    std::optional<Move> engine_move(const Search::Limits &);
+
+    /**
+     * @fn TimeManager::Statistics engine_statistics()
+     * @brief Returns the latencies of the engine's timed Moves
+     * @return The Statistics, empty if the engine never played
+     * @see TimeManager::Statistics
+     */
+    [[nodiscard]] TimeManager::Statistics engine_statistics() const;
+
     /**
      * @fn void export_to_file()
      * @brief Exports the Game's History to a file
@@ -87,11 +200,72 @@ public:
      */
     void export_to_file() const;
 
+    /**
+     * @fn bool export_pgn(const std::string &, const Pgn::Tags &)
+     * @brief Writes the Game to a PGN file
+     * @param path The destination file
+     * @param tags The Seven Tag Roster, the result is computed if empty
+     * @return true if the file has been written, false otherwise
+     * @see Pgn::write()
+     */
+    [[nodiscard]] bool export_pgn(const std::string &,
+                                  const Pgn::Tags & = {}) const;
+
+    /**
+     * @fn bool load_pgn(std::string_view)
+     * @brief Replaces the Game with the one described by a PGN game
+     * @details The Board and the History are left untouched if a Move is
+     * illegal
+     * @param game The text of the game
+     * @return true if every Move has been replayed, false otherwise
+     * @see Pgn::replay()
+     */
+    bool load_pgn(std::string_view);
+
+    /**
+     * @fn bool open_journal(const std::string &)
+     * @brief Starts writing every change of the Game to a Journal
+     * @details If the journal holds a game, the Game is replaced by it: this
+     * is how a Game is recovered after a crash. The Board is loaded from the
+     * last snapshot and only the Moves after it are checked and replayed,
+     * while the History and the repetitions are rebuilt from every journaled
+     * Move. Otherwise the Moves played so far are written first
+     * @param path The journal file
+     * @return true if the journal is open, false if it can't be written or
+     * its game can't be replayed, the Game is left untouched then
+     * @see Journal
+     */
+    bool open_journal(const std::string &);
+
+    /**
+     * @fn bool close_journal()
+     * @brief Stops journaling once every Move is on disk
+     * @return false if a journal write failed, true otherwise
+     */
+    bool close_journal();
+
+    /**
+     * @fn bool sync_journal()
+     * @brief Waits until every Move played so far is on disk
+     * @return false if a journal write failed, true otherwise
+     * @see Journal::sync()
+     */
+    bool sync_journal();
+
+    /**
+     * @fn void broadcast_to(std::shared_ptr<Broadcast>)
+     * @brief Publishes every change of the Game to reader threads
+     * @details The current position is published at once as a reset
+     * @param broadcast The Broadcast, nullptr to stop publishing
+     */
+    void broadcast_to(std::shared_ptr<Broadcast>);
+
     /**
      * @fn void reset()
      * @brief Resets the whole Board
      * @details First it whipe out every Piece in the Board, then it calls to
-     * Board::init_board() to set each Piece in the original position
+     * Board::init_board() to set each Piece in the original position. The
+     * History and the repetitions are cleared
      * @see Board::clear()
      * @see Board::init_board()
      */
@@ -131,9 +305,56 @@ private:
      */
     History m_history = History{};
 
+    /**
+     * @brief The positions since the last irreversible Move
+     */
+    RepetitionTable m_repetitions = RepetitionTable{m_board};
+
+    /**
+     * @brief Where the Moves are written to, null if not journaling
+     */
+    std::unique_ptr<Journal> m_journal{};
+
+    /**
+     * @brief Where the changes are published, null if not broadcasting
+     */
+    std::shared_ptr<Broadcast> m_broadcast{};
+
+    /**
+     * @brief The engine, created by its first Move
+     */
+    std::unique_ptr<Search> m_engine{};
+
+    /**
+     * @brief The cached destinations of the current position
+     * @see destinations()
+     */
+    mutable destinations_t m_destinations{};
+
+    /**
+     * @brief Whether m_destinations matches the Board
+     */
+    mutable bool m_destinations_valid{false};
+
+    /**
+     * @fn bool play(const Move &)
+     * @brief Validates and makes a Move, then journals it
+     * @return true if the Move has been made, false otherwise
+     */
+    bool play(const Move &);
+
+    /**
+     * @fn void journal_game()
+     * @brief Writes the whole Game to the journal as a new game
+     * @details A Game which doesn't start from the initial position starts
+     * with a snapshot. Stops journaling if that position can't be packed
+     */
+    void journal_game();
+
     /**
      * @fn void update_history(const Move &)
      * @brief Updates the Game's history
+     * @details Called before the Move is made on m_board
      * @see History::add_step()
      */
     void update_history(const Move &);
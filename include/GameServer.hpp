@@ -0,0 +1,248 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "SessionTable.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class GameServer
+ * @brief Hosts many Games over a local socket
+ * @details The thread calling run() accepts the connections and hands each
+ * one to a worker, round-robin. Every worker waits on its own epoll instance
+ * and owns its connections, so replies keep the order of the commands and
+ * sockets are never shared between threads. The protocol is line based, one
+ * reply per command:
+ * - `new`: `ok ID`, a new session
+ * - `move ID e2-e4`: `ok`, `end REASON` if the Move ends the Game, `illegal`
+ *   if it's rejected. Promotions are written as in Game::make_move()
+ * - `fen ID`: `ok FEN`
+ * - `close ID`: `ok`, the Game goes back to the pool
+ * - `stats`: `ok` followed by the counters
+ *
+ * Anything else gets `error` and a description
+ * @see SessionTable
+ */
+class GameServer final {
+public:
+    /**
+     * @brief Longest accepted command, the connection is dropped otherwise
+     */
+    static constexpr std::size_t MAX_LINE{256};
+
+    /**
+     * @brief Bytes read from a socket at once
+     */
+    static constexpr std::size_t READ_SIZE{16384};
+
+    /**
+     * @struct Statistics
+     * @brief Counters since the server has been created
+     */
+    struct Statistics final {
+        /**
+         * @brief Connections accepted
+         */
+        uint64_t m_connections{0};
+
+        /**
+         * @brief Commands executed
+         */
+        uint64_t m_commands{0};
+
+        /**
+         * @brief Moves made
+         */
+        uint64_t m_moves{0};
+
+        /**
+         * @brief Moves rejected
+         */
+        uint64_t m_illegal{0};
+    };
+
+    /**
+     * @fn GameServer(uint16_t)
+     * @brief Creates a GameServer, not listening yet
+     * @param workers The number of worker threads, at least 1
+     */
+    explicit GameServer(uint16_t = 1);
+
+    /**
+     * @fn ~GameServer()
+     * @brief Closes the sockets, removes the Unix socket file
+     */
+    ~GameServer();
+
+    GameServer(const GameServer &) = delete;
+    GameServer &operator=(const GameServer &) = delete;
+
+    /**
+     * @fn bool listen_tcp(uint16_t)
+     * @brief Listens on the loopback interface
+     * @param port The port, 0 for any free one
+     * @return true if the socket is listening, false otherwise
+     * @see port()
+     */
+    bool listen_tcp(uint16_t);
+
+    /**
+     * @fn bool listen_unix(const std::string &)
+     * @brief Listens on a Unix socket, replacing any file at that path
+     * @param path The socket path
+     * @return true if the socket is listening, false otherwise
+     */
+    bool listen_unix(const std::string &);
+
+    /**
+     * @fn uint16_t port()
+     * @brief Returns the TCP port
+     * @return The port listen_tcp() bound, 0 for Unix sockets
+     */
+    [[nodiscard]] uint16_t port() const;
+
+    /**
+     * @fn void run()
+     * @brief Serves the connections until stop() is called
+     */
+    void run();
+
+    /**
+     * @fn void stop()
+     * @brief Makes run() return, from any thread
+     */
+    void stop();
+
+    /**
+     * @fn void execute(std::string_view, std::string &)
+     * @brief Executes a command
+     * @param line The command, without the newline
+     * @param reply Where the reply and a newline are appended
+     */
+    void execute(std::string_view, std::string &);
+
+    /**
+     * @fn Statistics statistics()
+     * @brief Returns the counters
+     * @return A snapshot of the counters
+     */
+    [[nodiscard]] Statistics statistics() const;
+
+    /**
+     * @fn const SessionTable &sessions()
+     * @brief Returns the sessions
+     * @return The SessionTable
+     */
+    [[nodiscard]] const SessionTable &sessions() const;
+
+private:
+    /**
+     * @struct Connection
+     * @brief The buffers of a client
+     */
+    struct Connection final {
+        /**
+         * @brief Bytes received, up to an incomplete command
+         */
+        std::string m_input;
+
+        /**
+         * @brief Replies not sent yet
+         */
+        std::string m_output;
+
+        /**
+         * @brief Whether the worker waits for the socket to be writable
+         */
+        bool m_writing{false};
+    };
+
+    /**
+     * @brief Number of worker threads
+     */
+    uint16_t m_workers;
+
+    /**
+     * @brief The listening socket
+     */
+    int m_listener{-1};
+
+    /**
+     * @brief Event file descriptor, readable once stop() is called
+     */
+    int m_stop{-1};
+
+    /**
+     * @brief The bound TCP port
+     */
+    uint16_t m_port{0};
+
+    /**
+     * @brief The Unix socket path, removed on destruction
+     */
+    std::string m_path{};
+
+    /**
+     * @brief The Games
+     */
+    SessionTable m_sessions{};
+
+    /**
+     * @brief Connections accepted
+     */
+    std::atomic<uint64_t> m_connections{0};
+
+    /**
+     * @brief Commands executed
+     */
+    std::atomic<uint64_t> m_commands{0};
+
+    /**
+     * @brief Moves made
+     */
+    std::atomic<uint64_t> m_moves{0};
+
+    /**
+     * @brief Moves rejected
+     */
+    std::atomic<uint64_t> m_illegal{0};
+
+    /**
+     * @fn void serve(int)
+     * @brief The loop of a worker
+     * @param epoll The epoll instance of the worker
+     */
+    void serve(int);
+
+    /**
+     * @fn bool receive(int, Connection &)
+     * @brief Reads the available bytes and executes the complete commands
+     * @return false if the connection has to be closed
+     */
+    bool receive(int, Connection &);
+
+    /**
+     * @fn bool send(int, int, Connection &)
+     * @brief Writes as many replies as the socket takes
+     * @details Asks epoll for writability while replies are left
+     * @return false if the connection has to be closed
+     */
+    static bool send(int, int, Connection &);
+};
+}    // namespace dreamchess
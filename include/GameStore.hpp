@@ -0,0 +1,186 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+#include "Pgn.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class GameStore
+ * @brief Binary game database reader
+ * @details The file starts with a header (MAGIC, VERSION, the number of
+ * games and the offset of the index, little-endian) followed by the game
+ * records and by the index, one 64 bits offset per game plus the end of the
+ * last record, so that any game is found in O(1). A record holds:
+ * - a flags byte, FEN_FLAG if the game doesn't start from the neutral
+ *   position
+ * - the result, as an index of RESULTS
+ * - the values of the TAGS, each one prefixed by its length in a byte
+ * - the FEN string, prefixed by its length, if FEN_FLAG is set
+ * - one byte per ply up to the end of the record: the index of the Move in
+ *   MoveGenerator::pseudo_legal(), whose order is deterministic
+ *
+ * Moves are checked when stored, so decoding a ply only needs the
+ * pseudo-legal Moves of the position. The file is memory-mapped and reading
+ * never allocates
+ * @see GameStoreWriter
+ */
+class GameStore final {
+public:
+    /**
+     * @brief First bytes of a store file
+     */
+    static constexpr std::string_view MAGIC{"DCGS"};
+
+    /**
+     * @brief Format version
+     */
+    static constexpr uint32_t VERSION{1};
+
+    /**
+     * @brief Size of the file header: MAGIC, VERSION, number of games and
+     * index offset
+     */
+    static constexpr std::size_t HEADER_SIZE{24};
+
+    /**
+     * @brief File name extension
+     */
+    static constexpr std::string_view EXTENSION{".dcgs"};
+
+    /**
+     * @brief Flag of the records storing a FEN string
+     */
+    static constexpr uint8_t FEN_FLAG{1};
+
+    /**
+     * @brief The stored tags, in order
+     */
+    static constexpr std::array<std::string_view, 6> TAGS{
+        "Event", "Site", "Date", "Round", "White", "Black"};
+
+    /**
+     * @brief The results, a record stores the index
+     */
+    static constexpr std::array<std::string_view, 4> RESULTS{
+        "*", "1-0", "0-1", "1/2-1/2"};
+
+    /**
+     * @typedef Defines the tags_t type, the values of the TAGS
+     */
+    using tags_t = std::array<std::string_view, TAGS.size()>;
+
+    /**
+     * @struct Record
+     * @brief A stored game, as views of the mapping
+     */
+    struct Record final {
+        /**
+         * @brief The values of the TAGS
+         */
+        tags_t m_tags{};
+
+        /**
+         * @brief One of the RESULTS
+         */
+        std::string_view m_result{};
+
+        /**
+         * @brief The starting position, empty for the neutral one
+         */
+        std::string_view m_fen{};
+
+        /**
+         * @brief The Move indices, one per ply
+         */
+        const uint8_t *m_moves{nullptr};
+
+        /**
+         * @brief The number of plies
+         */
+        std::size_t m_plies{0};
+    };
+
+    /**
+     * @fn GameStore()
+     * @brief Creates a GameStore with no file
+     */
+    GameStore() = default;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Maps a store file
+     * @param path The .dcgs file path
+     * @return true if the header and the index are valid, false otherwise
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void close()
+     * @brief Unmaps the file
+     */
+    void close();
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of games
+     * @return The number of games, 0 if no file is open
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @fn std::optional<Record> record(std::size_t)
+     * @brief Looks a game up
+     * @param game The game number, lower than size()
+     * @return The Record, std::nullopt if out of range or malformed
+     */
+    [[nodiscard]] std::optional<Record> record(std::size_t) const;
+
+    /**
+     * @fn std::optional<uint32_t> replay(std::size_t, Board &, const
+     * Pgn::visitor_t &)
+     * @brief Plays the Moves of a game
+     * @param game The game number
+     * @param board The final position
+     * @param visit Called before each Move is made
+     * @return The number of plies, std::nullopt if the game is malformed
+     */
+    [[nodiscard]] std::optional<uint32_t> replay(
+        std::size_t, Board &, const Pgn::visitor_t & = {}) const;
+
+private:
+    /**
+     * @brief The mapped file
+     */
+    MappedFile m_file{};
+
+    /**
+     * @brief Number of games
+     */
+    std::size_t m_games{0};
+
+    /**
+     * @brief The index, m_games + 1 offsets
+     */
+    const uint8_t *m_index{nullptr};
+};
+}    // namespace dreamchess
@@ -0,0 +1,137 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "GameStore.hpp"
+#include "History.hpp"
+#include "Pgn.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class GameStoreWriter
+ * @brief Writes GameStore files
+ * @details Records are appended as games are added, the index is written by
+ * close(). A game with a Move the MoveGenerator doesn't consider legal is
+ * rejected
+ * @see GameStore
+ */
+class GameStoreWriter final {
+public:
+    /**
+     * @fn GameStoreWriter()
+     * @brief Creates a GameStoreWriter with no file
+     */
+    GameStoreWriter() = default;
+
+    /**
+     * @fn ~GameStoreWriter()
+     * @brief Closes the file
+     * @see close()
+     */
+    ~GameStoreWriter();
+
+    GameStoreWriter(const GameStoreWriter &) = delete;
+    GameStoreWriter &operator=(const GameStoreWriter &) = delete;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Creates a store file, closing the previous one
+     * @param path The file path
+     * @return true if the file has been created, false otherwise
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn bool add(const Pgn::Tags &, const Board &, const History &)
+     * @brief Appends a game
+     * @param tags The tags, the result is computed if empty
+     * @param board The current position
+     * @param history The moves which led to it
+     * @return true if the game has been stored, false otherwise
+     * @see History::position()
+     */
+    bool add(const Pgn::Tags &, const Board &, const History &);
+
+    /**
+     * @fn bool add_pgn(std::string_view)
+     * @brief Appends a PGN game
+     * @param game The text of the game
+     * @return true if the game has been stored, false otherwise
+     * @see Pgn::replay()
+     */
+    bool add_pgn(std::string_view);
+
+    /**
+     * @fn bool close()
+     * @brief Writes the index and the header, then closes the file
+     * @return true if the whole file has been written, false otherwise
+     */
+    bool close();
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of games stored so far
+     * @return The number of games
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /**
+     * @brief The file being written
+     */
+    std::ofstream m_file{};
+
+    /**
+     * @brief Offsets of the records written so far
+     */
+    std::vector<uint64_t> m_offsets{};
+
+    /**
+     * @brief Offset of the next record
+     */
+    uint64_t m_end{0};
+
+    /**
+     * @brief The record being built, reused across games
+     */
+    std::string m_record{};
+
+    /**
+     * @fn void begin_record(const GameStore::tags_t &, std::string_view,
+     * std::string_view)
+     * @brief Starts a record with its tags, result and starting position
+     */
+    void begin_record(const GameStore::tags_t &, std::string_view,
+                      std::string_view);
+
+    /**
+     * @fn bool add_move(const Board &, const Move &)
+     * @brief Appends the index of a Move to the record
+     * @return false if the Move is not legal
+     */
+    bool add_move(const Board &, const Move &);
+
+    /**
+     * @fn bool end_record()
+     * @brief Writes the record to the file
+     */
+    bool end_record();
+};
+}    // namespace dreamchess
@@ -7,9 +7,11 @@
  */
 #pragma once
 
-#include <list>
-#include <memory>
-#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
 
 #include "Board.hpp"
 #include "Move.hpp"
@@ -23,71 +25,173 @@ namespace dreamchess {
 /**
  * @class History
  * @brief The current game History
+ * @details A contiguous log of compact Steps, each one holding a Move and
+ * what it destroyed, so that any earlier position can be rebuilt from the
+ * current one by taking the moves back
  */
 class History final {
 private:
     /**
      * @struct Step
      * @brief A single step into the History
-     * @details Each Step is represented as the ALG notation representation of
-     * the move which brought the game in this state
+     * @details Squares and pieces are stored in a byte each, a Step is 10
+     * bytes long
      */
     struct Step final {
         /**
-         * @brief Last Move which has been made
+         * @brief Source square of the Move
          */
-        std::string m_move;
+        uint8_t m_source;
+
+        /**
+         * @brief Destination square of the Move
+         */
+        uint8_t m_destination;
+
+        /**
+         * @brief The Piece which made the Move
+         */
+        uint8_t m_piece;
+
+        /**
+         * @brief The promotion Piece, NONE if the Move is not a promotion
+         */
+        uint8_t m_promotion;
+
+        /**
+         * @brief The captured Piece, NONE if the Move is not a capture
+         */
+        uint8_t m_captured;
+
+        /**
+         * @brief Square of the captured Piece, -1 if none
+         */
+        int8_t m_captured_square;
+
+        /**
+         * @brief Castling rights before the Move
+         */
+        uint8_t m_castling;
+
+        /**
+         * @brief En-passant square before the Move, -1 if none
+         */
+        int8_t m_en_passant;
+
+        /**
+         * @brief Halfmove clock before the Move
+         */
+        uint16_t m_halfmove_clock;
 
         /**
          * @brief Constructs the Step
-         * @details Each Step is the algebraic notation representation of the
-         * Move
-         * @see Move::to_alg()
+         * @param move The Move
+         * @param undo What the Move destroys
+         * @see Board::undo()
+         */
+        Step(const Move &, const Board::Undo &);
+
+        /**
+         * @fn Move move()
+         * @brief Expands the stored Move
          */
-        explicit Step(const Move &);
+        [[nodiscard]] Move move() const;
+
+        /**
+         * @fn Board::Undo undo()
+         * @brief Expands the stored undo data
+         */
+        [[nodiscard]] Board::Undo undo() const;
     };
 
     /**
      * @typedef Defines the step_list_t type to improve readability
      */
-    using step_list_t = std::list<Step>;
+    using step_list_t = std::vector<Step>;
 
     /**
      * @brief Game History so far
      */
     step_list_t m_game_history{};
 
+    /**
+     * @fn void append_step(std::string &, std::size_t)
+     * @brief Appends an exported Step to a buffer
+     * @param buffer The output buffer
+     * @param ply The index of the Step
+     */
+    void append_step(std::string &, std::size_t) const;
+
 public:
+    /**
+     * @brief Number of Steps the History has room for before growing
+     */
+    static constexpr std::size_t RESERVED_STEPS{1024};
+
     /**
      * @fn History()
      * @brief Constructs a History object
+     * @details Room for RESERVED_STEPS is allocated upfront
      */
-    History() = default;
+    History();
 
     /**
-     * @fn ~History()
-     * @brief The History class destructor
-     * @details Clears the History
+     * @fn void add_step(const Board &, const Move &)
+     * @brief Adds a step to the History
+     * @param board The referenced board, before the Move is made
+     * @param move The Move about to be made
+     * @see Board::undo()
      */
-    ~History();
+    void add_step(const Board &, const Move &);
 
     /**
-     * @fn void add_step(const Move &)
-     * @brief Adds a step to the History list
-     * @param move The last move made in the referenced board
-     * @see std::list::emplace_back()
+     * @fn void clear()
+     * @brief Removes every Step, keeping the allocated room
      */
-    void add_step(const Move &);
+    void clear();
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of Steps, i.e. the plies played
+     * @return The number of Steps
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @fn Move move(std::size_t)
+     * @brief Returns the Move of a Step
+     * @param ply The index of the Step, lower than size()
+     * @return The Move
+     */
+    [[nodiscard]] Move move(std::size_t) const;
+
+    /**
+     * @fn Board position(const Board &, std::size_t)
+     * @brief Rebuilds the position before a Step
+     * @details The moves after ply are taken back, in reverse order
+     * @param board The current position, after the last Step
+     * @param ply The index of the Step, size() for the current position
+     * @return The position
+     * @see Board::unmake_move()
+     */
+    [[nodiscard]] Board position(const Board &, std::size_t) const;
+
+    /**
+     * @fn void export_all(std::ostream &)
+     * @brief Writes the History to a stream, in a single pass
+     * @details Every Step is exported as "<Move number>. <Move in algebraic>"
+     * on its own line. Lines are collected in a small buffer which is written
+     * whenever it fills up
+     * @param stream The output stream
+     * @see Move::to_alg()
+     */
+    void export_all(std::ostream &) const;
 
     /**
      * @fn std::string export_all()
      * @brief Exports the History as a string
-     * @details Every Step is exported as "<Move number>. <Move in algebraic>"
      * @return The whole Game's History as a string
-     * @see std::to_string()
-     * @see std::list::front()
-     * @see std::list::push_back()
-     * @see std::list::pop_front()
+     * @see export_all(std::ostream &)
      */
     [[nodiscard]] std::string export_all() const;
 };
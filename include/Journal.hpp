@@ -0,0 +1,271 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Journal
+ * @brief Append-only log of the Moves of a Game, written in the background
+ * @details append() only stores a 4 bytes record in memory, a writer thread
+ * writes every pending record with a single write() followed by a single
+ * fdatasync(). Records appended while the disk is busy are written together,
+ * so the cost of a Move doesn't depend on the length of the Game.
+ *
+ * The file starts with MAGIC, then every record holds a Move and a check
+ * word. Every SNAPSHOT_INTERVAL plies a Game also appends its packed Board,
+ * so that any ply is rebuilt by replaying at most SNAPSHOT_INTERVAL Moves.
+ * A record torn by a crash fails its check: read() stops there and open()
+ * cuts the file back to the last whole record
+ */
+class Journal final {
+public:
+    /**
+     * @brief The first bytes of every journal
+     */
+    static constexpr std::string_view MAGIC{"DCJRNL1\n"};
+
+    /**
+     * @brief Size of a record in bytes
+     */
+    static constexpr std::size_t RECORD_SIZE{4};
+
+    /**
+     * @brief Size of a snapshot in bytes: a record, the Board and a checksum
+     */
+    static constexpr std::size_t SNAPSHOT_SIZE{
+        RECORD_SIZE + sizeof(Board::packed_t) + 4};
+
+    /**
+     * @brief Plies between two snapshots of a Game
+     */
+    static constexpr std::size_t SNAPSHOT_INTERVAL{64};
+
+    /**
+     * @struct Snapshot
+     * @brief A packed Board and the ply it was taken at
+     */
+    struct Snapshot final {
+        /**
+         * @brief The number of Moves played before the snapshot
+         */
+        std::size_t m_ply;
+
+        /**
+         * @brief The position
+         */
+        Board::packed_t m_board;
+    };
+
+    /**
+     * @struct Contents
+     * @brief The last Game of a journal
+     * @details The Game starts from the initial position, unless it has a
+     * Snapshot at ply 0
+     */
+    struct Contents final {
+        /**
+         * @brief The Moves, with no Piece and a colorless promotion Piece
+         * @see resolve()
+         */
+        std::vector<Move> m_moves{};
+
+        /**
+         * @brief The snapshots, by increasing ply
+         */
+        std::vector<Snapshot> m_snapshots{};
+    };
+
+    /**
+     * @fn Journal()
+     * @brief Creates a Journal with no file
+     */
+    Journal() = default;
+
+    /**
+     * @fn ~Journal()
+     * @brief Writes the pending records and closes the file
+     * @see close()
+     */
+    ~Journal();
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Opens a journal to append records to, creating it if needed
+     * @details A torn record at the end of the file is cut off
+     * @param path The file path
+     * @return true if the file can be written, false otherwise
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void append(const Move &)
+     * @brief Queues a Move for the writer thread
+     * @param move The Move, its promotion Piece's color is not stored
+     */
+    void append(const Move &);
+
+    /**
+     * @fn void append_reset()
+     * @brief Queues a record starting a new Game
+     */
+    void append_reset();
+
+    /**
+     * @fn bool append_snapshot(const Board &)
+     * @brief Queues a snapshot of the current position of the Game
+     * @param board The position
+     * @return false if the Board can't be packed, true otherwise
+     * @see Board::pack()
+     */
+    bool append_snapshot(const Board &);
+
+    /**
+     * @fn bool sync()
+     * @brief Waits until every record appended so far is on disk
+     * @return false if a write failed, true otherwise
+     */
+    bool sync();
+
+    /**
+     * @fn bool close()
+     * @brief Writes the pending records, stops the writer and closes the file
+     * @return false if a write failed, true otherwise
+     */
+    bool close();
+
+    /**
+     * @fn bool is_open()
+     * @brief Tells whether records are being written
+     * @return true if a file is open, false otherwise
+     */
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * @fn uint64_t syncs()
+     * @brief Returns the number of fdatasync() calls made so far
+     * @return The number of batches written
+     */
+    [[nodiscard]] uint64_t syncs() const;
+
+    /**
+     * @fn std::optional<Contents> read(const std::string &)
+     * @brief Reads the last Game of a journal
+     * @details The records after a torn one are ignored
+     * @param path The file path
+     * @return The Game since the last reset, std::nullopt if the file can't
+     * be read or is not a journal
+     */
+    [[nodiscard]] static std::optional<Contents> read(const std::string &);
+
+    /**
+     * @fn std::optional<Board> seek(const Contents &, std::size_t)
+     * @brief Rebuilds the position of a journaled Game at a given ply
+     * @details Starts from the nearest Snapshot before the ply, the Moves are
+     * made with no validation
+     * @param contents The Game
+     * @param ply The number of Moves played
+     * @return The position, std::nullopt if the Game is shorter
+     */
+    [[nodiscard]] static std::optional<Board> seek(const Contents &,
+                                                   std::size_t);
+
+    /**
+     * @fn Move resolve(const Move &, const Board &)
+     * @brief Completes a journaled Move with its Pieces
+     * @param move The journaled Move
+     * @param board The position the Move is played in
+     * @return The Move as made on the Board
+     */
+    [[nodiscard]] static Move resolve(const Move &, const Board &);
+
+private:
+    /**
+     * @brief The file descriptor, -1 if closed
+     */
+    int m_fd{-1};
+
+    /**
+     * @brief Guards every member below
+     */
+    mutable std::mutex m_mutex{};
+
+    /**
+     * @brief Signals new records to the writer and written ones to sync()
+     */
+    std::condition_variable m_changed{};
+
+    /**
+     * @brief Records appended and not yet taken by the writer
+     */
+    std::string m_pending{};
+
+    /**
+     * @brief Number of records appended
+     */
+    uint64_t m_appended{0};
+
+    /**
+     * @brief Number of records on disk
+     */
+    uint64_t m_synced{0};
+
+    /**
+     * @brief Number of fdatasync() calls
+     */
+    uint64_t m_syncs{0};
+
+    /**
+     * @brief Whether a write failed
+     */
+    bool m_failed{false};
+
+    /**
+     * @brief Whether the writer has to stop once the records are written
+     */
+    bool m_closing{false};
+
+    /**
+     * @brief The writer thread
+     */
+    std::thread m_writer{};
+
+    /**
+     * @fn void push(uint16_t)
+     * @brief Queues a record
+     * @param code The encoded Move
+     */
+    void push(uint16_t);
+
+    /**
+     * @fn void write_loop()
+     * @brief Body of the writer thread
+     */
+    void write_loop();
+};
+}    // namespace dreamchess
@@ -0,0 +1,78 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "Board.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Kpk
+ * @brief King and pawn versus king bitbase
+ * @details Every position with the pawn on the a-d files, seen from the side
+ * owning the pawn, is classified by retrograde analysis and stored as one
+ * bit (win or draw). The table is generated once, the first time it's
+ * needed
+ */
+class Kpk final {
+public:
+    /**
+     * @brief Side to move (2) x defending king (64) x attacking king (64) x
+     * pawn (4 files x 6 ranks)
+     */
+    static constexpr uint32_t MAX_INDEX{2 * 64 * 64 * 24};
+
+    /**
+     * @typedef Defines the table_t type, one bit per position
+     */
+    using table_t = std::array<uint64_t, MAX_INDEX / 64>;
+
+    /**
+     * @fn table_t generate()
+     * @brief Runs the retrograde analysis
+     * @return The packed table, a bit is set if the pawn side wins
+     */
+    [[nodiscard]] static table_t generate();
+
+    /**
+     * @fn const table_t &table()
+     * @brief Returns the shared table, generating it on the first call
+     * @return The packed table
+     */
+    [[nodiscard]] static const table_t &table();
+
+    /**
+     * @fn bool probe(uint16_t, uint16_t, uint16_t, bool)
+     * @brief Looks a normalized position up
+     * @param strong_king The square of the pawn side's KING
+     * @param pawn The pawn square, on the a-d files, WHITE's point of view
+     * @param weak_king The square of the lone KING
+     * @param strong_to_move true if the pawn side is to move
+     * @return true if the pawn side wins, false if it's a draw
+     */
+    [[nodiscard]] static bool probe(uint16_t, uint16_t, uint16_t, bool);
+
+    /**
+     * @fn std::optional<bool> probe(const Board &)
+     * @brief Looks a position up
+     * @param board The position, with either side owning the pawn
+     * @return true if the pawn side wins, false if it's a draw, std::nullopt
+     * if the material is not KPK or the pawn stands on the first or the
+     * last rank
+     */
+    [[nodiscard]] static std::optional<bool> probe(const Board &);
+};
+}    // namespace dreamchess
@@ -0,0 +1,109 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file
+ * @details The mapping is released on destruction. Empty files are opened
+ * successfully and have a null data() pointer
+ */
+class MappedFile final {
+public:
+    /**
+     * @fn MappedFile()
+     * @brief Creates a closed MappedFile
+     */
+    MappedFile() = default;
+
+    /**
+     * @fn ~MappedFile()
+     * @brief Unmaps the file
+     * @see close()
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @fn MappedFile(MappedFile &&)
+     * @brief Takes over the mapping of another MappedFile
+     */
+    MappedFile(MappedFile &&) noexcept;
+
+    /**
+     * @brief Takes over the mapping of another MappedFile
+     * @return This MappedFile
+     */
+    MappedFile &operator=(MappedFile &&) noexcept;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Maps a file in memory, closing the previous one
+     * @param path The file path
+     * @return true if the file has been mapped, false otherwise
+     * @see mmap()
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void close()
+     * @brief Unmaps the file, if any
+     * @see munmap()
+     */
+    void close();
+
+    /**
+     * @fn bool is_open()
+     * @brief Checks if a file is mapped
+     * @return true if open() succeeded, false otherwise
+     */
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * @fn const uint8_t *data()
+     * @brief Returns the first byte of the mapping
+     * @return The mapped bytes
+     */
+    [[nodiscard]] const uint8_t *data() const;
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the size of the mapping
+     * @return The file size in bytes
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /**
+     * @brief The mapped bytes
+     */
+    const uint8_t *m_data{nullptr};
+
+    /**
+     * @brief The mapping size in bytes
+     */
+    std::size_t m_size{0};
+
+    /**
+     * @brief Whether open() succeeded
+     */
+    bool m_open{false};
+};
+}    // namespace dreamchess
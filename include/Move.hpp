@@ -7,7 +7,7 @@
  */
 #pragma once
 
-#include <regex>
+#include <string>
 #include <string_view>
 
 #include "Board.hpp"
@@ -25,6 +25,12 @@ namespace dreamchess {
  */
 struct Move final {
 public:
+    /**
+     * @fn Move()
+     * @brief Constructs an empty Move, used to fill move buffers
+     */
+    Move() = default;
+
     /**
      * @fn Move(int64_t, int64_t, Board::piece_t, Board::piece_t)
      * @brief Constructs a move with 'hard' source and destination
@@ -63,20 +69,6 @@ public:
      */
     [[nodiscard]] Board::piece_t promotion_piece() const;
 
-    /**
-     * @fn std::regex move_regex()
-     * @brief Getter for the move regex
-     * @return The object pointed by the m_move_regex shared pointer
-     */
-    [[nodiscard]] static std::regex move_regex();
-
-    /**
-     * @fn std::regex promotion_regex()
-     * @brief Getter for the promotion regex
-     * @return The object pointed by the m_promotion_regex shared pointer
-     */
-    [[nodiscard]] static std::regex promotion_regex();
-
     /**
      * @fn std::string to_alg()
      * @brief Converts a Move to his its algebraic notation
@@ -86,35 +78,49 @@ public:
      */
     [[nodiscard]] std::string to_alg() const;
 
-private:
     /**
-     * @brief The Move's source square
+     * @fn std::string to_uci()
+     * @brief Converts a Move to its UCI long algebraic notation
+     * @details The promotion Piece, if any, is appended in lowercase, e.g.
+     * "e7e8q"
+     * @return The Move in UCI notation
+     * @see Piece::to_fen()
      */
-    int16_t m_source;
+    [[nodiscard]] std::string to_uci() const;
 
     /**
-     * @brief The Move's destination square
+     * @brief Compares two Moves
+     * @param other The Move to compare with
+     * @return true if every field matches, false otherwise
      */
-    int16_t m_destination;
+    bool operator==(const Move &) const;
 
     /**
-     * @brief The Piece which is making the move
+     * @brief Compares two Moves
+     * @param other The Move to compare with
+     * @return true if at least a field differs, false otherwise
      */
-    Board::piece_t m_piece;
+    bool operator!=(const Move &) const;
 
+private:
     /**
-     * @brief The declared promotion present, if promotion
+     * @brief The Move's source square
      */
-    Board::piece_t m_promotion_piece;
+    int16_t m_source{0};
 
     /**
-     * @brief Pointer to the standard move regex pattern
+     * @brief The Move's destination square
      */
-    static const std::shared_ptr<std::regex> m_move_regex;
+    int16_t m_destination{0};
 
     /**
-     * @brief Pointer to the promotion move regex pattern
+     * @brief The Piece which is making the move
+     */
+    Board::piece_t m_piece{Piece::NONE};
+
+    /**
+     * @brief The declared promotion present, if promotion
      */
-    static const std::shared_ptr<std::regex> m_promotion_regex;
+    Board::piece_t m_promotion_piece{Piece::NONE};
 };
 }    // namespace dreamchess
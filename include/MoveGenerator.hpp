@@ -0,0 +1,247 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class MoveList
+ * @brief Fixed capacity list of Moves
+ * @details Lives on the stack, no chess position has more than 218 legal
+ * moves
+ */
+class MoveList final {
+public:
+    /**
+     * @typedef Defines the move_array_t type to improve readability
+     */
+    using move_array_t = std::array<Move, 256>;
+
+    /**
+     * @fn void push_back(const Move &)
+     * @brief Appends a Move to the list
+     * @details Moves past the capacity are dropped, Board never sets a
+     * position with that many
+     * @param move The Move to append
+     */
+    void push_back(const Move &move) {
+        if (m_size < m_moves.size()) {
+            m_moves[m_size++] = move;
+        }
+    }
+
+    /**
+     * @fn void clear()
+     * @brief Empties the list
+     */
+    void clear() { m_size = 0; }
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of Moves in the list
+     * @return The size of the list
+     */
+    [[nodiscard]] std::size_t size() const { return m_size; }
+
+    /**
+     * @fn bool empty()
+     * @brief Checks if the list is empty
+     * @return true if there are no Moves, false otherwise
+     */
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Accesses a Move of the list
+     * @param index The index of the Move
+     * @return A reference to the Move
+     */
+    Move &operator[](std::size_t index) { return m_moves[index]; }
+
+    /**
+     * @brief Accesses a Move of the list
+     * @param index The index of the Move
+     * @return A const reference to the Move
+     */
+    const Move &operator[](std::size_t index) const { return m_moves[index]; }
+
+    /**
+     * @brief Returns an iterator to the first Move
+     * @return The begin iterator
+     */
+    [[nodiscard]] move_array_t::iterator begin() { return m_moves.begin(); }
+
+    /**
+     * @brief Returns an iterator past the last Move
+     * @return The end iterator
+     */
+    [[nodiscard]] move_array_t::iterator end() {
+        return m_moves.begin() + static_cast<std::ptrdiff_t>(m_size);
+    }
+
+    /**
+     * @brief Returns an iterator to the first Move
+     * @return The begin const iterator
+     */
+    [[nodiscard]] move_array_t::const_iterator begin() const {
+        return m_moves.begin();
+    }
+
+    /**
+     * @brief Returns an iterator past the last Move
+     * @return The end const iterator
+     */
+    [[nodiscard]] move_array_t::const_iterator end() const {
+        return m_moves.begin() + static_cast<std::ptrdiff_t>(m_size);
+    }
+
+private:
+    /**
+     * @brief The Moves storage
+     */
+    move_array_t m_moves;
+
+    /**
+     * @brief The number of Moves in the list
+     */
+    std::size_t m_size{0};
+};
+
+/**
+ * @class MoveGenerator
+ * @brief Generates the legal Moves of a Board
+ * @details Unlike Board::move_is_valid(), which implements the permissive
+ * rules of the interactive Game, the generator follows the full chess rules:
+ * sliders are blocked, castling needs the rights and safe squares, and a
+ * Move may not leave the own KING attacked
+ */
+class MoveGenerator final {
+public:
+    /**
+     * @fn void pseudo_legal(const Board &, MoveList &)
+     * @brief Generates the Moves of the side to move, ignoring KING safety
+     * @details Castling is only generated if legal
+     * @param board The position
+     * @param moves The list the Moves are appended to
+     */
+    static void pseudo_legal(const Board &, MoveList &);
+
+    /**
+     * @fn void legal(const Board &, MoveList &)
+     * @brief Generates the legal Moves of the side to move
+     * @param board The position
+     * @param moves The list the Moves are appended to
+     * @see pseudo_legal()
+     * @see leaves_king_safe()
+     */
+    static void legal(const Board &, MoveList &);
+
+    /**
+     * @fn bool leaves_king_safe(const Board &, const Move &)
+     * @brief Checks that a pseudo-legal Move doesn't expose the own KING
+     * @param board The position
+     * @param move The pseudo-legal Move
+     * @return true if the KING is not attacked after the Move
+     */
+    [[nodiscard]] static bool leaves_king_safe(const Board &, const Move &);
+
+    /**
+     * @fn bool is_legal(const Board &, const Move &)
+     * @brief Checks if a Move is legal
+     * @param board The position
+     * @param move The Move to check
+     * @return true if the Move is among the legal ones, false otherwise
+     */
+    [[nodiscard]] static bool is_legal(const Board &, const Move &);
+
+    /**
+     * @fn bool attacked(const Board &, int16_t, Board::piece_t)
+     * @brief Checks if a square is attacked by the given side
+     * @param board The position
+     * @param square The square to check
+     * @param by The attacking color
+     * @return true if at least one Piece of the side attacks the square
+     */
+    [[nodiscard]] static bool attacked(const Board &, int16_t,
+                                       Board::piece_t);
+
+    /**
+     * @fn bool in_check(const Board &)
+     * @brief Checks if the side to move is in check
+     * @param board The position
+     * @return true if the side to move's KING is attacked
+     */
+    [[nodiscard]] static bool in_check(const Board &);
+
+    /**
+     * @fn int16_t king_square(const Board &, Board::piece_t)
+     * @brief Looks for the KING of a side
+     * @param board The position
+     * @param color The KING's color
+     * @return The KING square, Board::NO_SQUARE if there is no KING
+     */
+    [[nodiscard]] static int16_t king_square(const Board &, Board::piece_t);
+
+    /**
+     * @fn std::optional<Move> from_uci(const Board &, std::string_view)
+     * @brief Finds the legal Move matching a UCI string
+     * @param board The position
+     * @param uci The Move in UCI notation, e.g. "e2e4" or "a7a8q"
+     * @return The matching Move, std::nullopt if it's not legal
+     * @see Move::to_uci()
+     */
+    [[nodiscard]] static std::optional<Move> from_uci(const Board &,
+                                                      std::string_view);
+
+private:
+    /**
+     * @fn void pseudo_legal_for(const Board &, MoveList &)
+     * @brief pseudo_legal() specialized for the side to move
+     * @tparam US The side to move
+     * @param board The position
+     * @param moves The list the Moves are appended to
+     */
+    template <Piece::Enum US>
+    static void pseudo_legal_for(const Board &, MoveList &);
+
+    /**
+     * @fn void piece_moves(const Board &, int16_t, MoveList &)
+     * @brief Generates the Moves of a single Piece
+     * @tparam US The side to move
+     * @tparam TYPE The Piece type
+     * @param board The position
+     * @param source The Piece square
+     * @param moves The list the Moves are appended to
+     */
+    template <Piece::Enum US, Piece::Enum TYPE>
+    static void piece_moves(const Board &, int16_t, MoveList &);
+
+    /**
+     * @fn bool attacked_by(const Board &, int16_t)
+     * @brief attacked() specialized for the attacking side
+     * @tparam BY The attacking color
+     * @param board The position
+     * @param square The square to check
+     * @return true if at least one Piece of the side attacks the square
+     */
+    template <Piece::Enum BY>
+    [[nodiscard]] static bool attacked_by(const Board &, int16_t);
+};
+}    // namespace dreamchess
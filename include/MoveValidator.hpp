@@ -0,0 +1,93 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Board.hpp"
+#include "Move.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class MoveValidator
+ * @brief Checks batches of Moves against the full chess rules
+ * @details Each position is analysed once for the Moves that follow it in
+ * the batch: the squares the opponent attacks, the checking Pieces and the
+ * pinned ones. A Move is then checked in a few operations, with no copy of
+ * the Board and no move generation. The answers are the same as
+ * MoveGenerator::is_legal()'s
+ * @see MoveGenerator
+ */
+class MoveValidator final {
+public:
+    /**
+     * @struct Query
+     * @brief A Move to check in one of the positions of a batch
+     */
+    struct Query final {
+        /**
+         * @brief Index of the position in the batch
+         */
+        uint32_t m_position;
+
+        /**
+         * @brief The Move to check
+         */
+        Move m_move;
+    };
+
+    /**
+     * @typedef Defines the bitmap_t type, one bit per Query
+     */
+    using bitmap_t = std::vector<uint64_t>;
+
+    /**
+     * @fn MoveValidator(uint16_t)
+     * @brief Creates a MoveValidator
+     * @param threads The number of threads a batch is split across
+     */
+    explicit MoveValidator(uint16_t = 1);
+
+    /**
+     * @fn bitmap_t validate(const std::vector<Board> &,
+     * const std::vector<Query> &)
+     * @brief Checks a batch of Moves
+     * @details Queries on the same position should be next to each other, a
+     * position is analysed again every time it changes
+     * @param positions The positions
+     * @param queries The Moves and the positions they are played in
+     * @return Bit i set if the i-th Move is legal, cleared if it's not or if
+     * its position is out of range
+     * @see is_set()
+     */
+    [[nodiscard]] bitmap_t validate(const std::vector<Board> &,
+                                    const std::vector<Query> &) const;
+
+    /**
+     * @fn bool is_set(const bitmap_t &, std::size_t)
+     * @brief Reads a bit of a validity bitmap
+     * @param bitmap The bitmap
+     * @param index The Query index
+     * @return true if the Move is legal, false otherwise
+     */
+    [[nodiscard]] static bool is_set(const bitmap_t &, std::size_t);
+
+private:
+    /**
+     * @brief The number of threads
+     */
+    uint16_t m_threads;
+};
+}    // namespace dreamchess
@@ -0,0 +1,133 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+#include "History.hpp"
+#include "Move.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Pgn
+ * @brief Portable Game Notation writer and parser
+ * @details Moves are written and read in Standard Algebraic Notation (SAN),
+ * following the full chess rules of MoveGenerator. Parsing works on views of
+ * the input and never allocates per Move
+ * @see PgnReader
+ */
+class Pgn final {
+public:
+    /**
+     * @struct Tags
+     * @brief The Seven Tag Roster
+     * @details An empty m_result is computed from the final position
+     */
+    struct Tags final {
+        std::string m_event{"?"};
+        std::string m_site{"?"};
+        std::string m_date{"????.??.??"};
+        std::string m_round{"?"};
+        std::string m_white{"?"};
+        std::string m_black{"?"};
+        std::string m_result{};
+    };
+
+    /**
+     * @typedef Defines the visitor_t type, called by replay() with the
+     * position before each Move
+     */
+    using visitor_t = std::function<void(const Board &, const Move &)>;
+
+    /**
+     * @brief Maximum length of an exported movetext line
+     */
+    static constexpr std::size_t LINE_LENGTH{79};
+
+    /**
+     * @fn std::string san(const Board &, const Move &)
+     * @brief Converts a legal Move to SAN, e.g. "Nbd7", "exd6", "e8=Q+"
+     * @param board The position before the Move
+     * @param move The Move
+     * @return The Move in SAN, with the check or mate suffix
+     */
+    [[nodiscard]] static std::string san(const Board &, const Move &);
+
+    /**
+     * @fn std::optional<Move> parse_san(const Board &, std::string_view)
+     * @brief Finds the legal Move matching a SAN string
+     * @details Check, mate and annotation suffixes are ignored, castling may
+     * be written with zeros
+     * @param board The position
+     * @param text The Move in SAN
+     * @return The Move, std::nullopt if illegal, malformed or ambiguous
+     */
+    [[nodiscard]] static std::optional<Move> parse_san(const Board &,
+                                                       std::string_view);
+
+    /**
+     * @fn std::string_view result(const Board &)
+     * @brief Returns the result of a final position
+     * @param board The position
+     * @return "1-0", "0-1" or "1/2-1/2" if the side to move is mated or
+     * stalemated, "*" otherwise
+     */
+    [[nodiscard]] static std::string_view result(const Board &);
+
+    /**
+     * @fn void write(std::ostream &, const Tags &, const Board &, const
+     * History &)
+     * @brief Writes a game in PGN export format
+     * @details A game not starting from the neutral position gets the SetUp
+     * and FEN tags
+     * @param stream The output stream
+     * @param tags The Seven Tag Roster
+     * @param board The current position
+     * @param history The moves which led to it
+     * @see History::position()
+     */
+    static void write(std::ostream &, const Tags &, const Board &,
+                      const History &);
+
+    /**
+     * @fn std::string_view tag(std::string_view, std::string_view)
+     * @brief Looks a tag up in the text of a game
+     * @param game The game text
+     * @param name The tag name
+     * @return The tag value, escapes left as they are, empty if missing
+     */
+    [[nodiscard]] static std::string_view tag(std::string_view,
+                                              std::string_view);
+
+    /**
+     * @fn std::optional<uint32_t> replay(std::string_view, Board &, const
+     * visitor_t &)
+     * @brief Plays the movetext of a game
+     * @details The Board starts from the FEN tag, or the neutral position.
+     * Comments, variations, NAGs and move numbers are skipped, the game
+     * ends at its result
+     * @param game The game text
+     * @param board The final position
+     * @param visit Called before each Move is made
+     * @return The number of plies, std::nullopt on an illegal Move
+     */
+    [[nodiscard]] static std::optional<uint32_t> replay(
+        std::string_view, Board &, const visitor_t & = {});
+};
+}    // namespace dreamchess
@@ -0,0 +1,133 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "PgnReader.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class PgnPipeline
+ * @brief Parallel PGN ingest
+ * @details A splitter thread cuts the text at game boundaries into chunks of
+ * about chunk_bytes, a pool of workers replays the games of each chunk
+ * through a Board and the calling thread hands the results to the sink in
+ * the order of the games. Chunks and results travel through BoundedQueues,
+ * so the splitter never gets more than queue_capacity chunks ahead of the
+ * workers, and the workers never more than queue_capacity chunks ahead of
+ * the sink. Chunks finished out of order wait for the earlier ones, the
+ * splitter stops once 2 * queue_capacity + workers chunks are not handed to
+ * the sink yet, so that a slow chunk doesn't let the others pile up
+ * @see PgnReader
+ * @see BoundedQueue
+ */
+class PgnPipeline final {
+public:
+    /**
+     * @brief Default size of the chunks, in bytes
+     */
+    static constexpr std::size_t CHUNK_BYTES{1 << 18};
+
+    /**
+     * @struct Result
+     * @brief Outcome of the replay of a game
+     */
+    struct Result final {
+        /**
+         * @brief Position of the game in the text, starting from 0
+         */
+        uint64_t m_index{0};
+
+        /**
+         * @brief The text of the game
+         */
+        std::string_view m_game{};
+
+        /**
+         * @brief The number of plies, std::nullopt on an illegal Move
+         */
+        std::optional<uint32_t> m_plies{};
+
+        /**
+         * @brief The final position, or where the illegal Move was found
+         */
+        Board m_board{};
+    };
+
+    /**
+     * @typedef Defines the sink_t type, called on the thread running run()
+     */
+    using sink_t = std::function<void(const Result &)>;
+
+    /**
+     * @fn PgnPipeline(uint16_t, std::size_t, std::size_t)
+     * @brief Creates a pipeline
+     * @param workers Number of worker threads, at least one is used
+     * @param queue_capacity Capacity of both queues, in chunks
+     * @param chunk_bytes Size the games are grouped by
+     */
+    explicit PgnPipeline(uint16_t, std::size_t = 0,
+                         std::size_t = CHUNK_BYTES);
+
+    /**
+     * @fn PgnReader::Statistics run(std::string_view, const sink_t &)
+     * @brief Replays every game of a PGN text
+     * @param text The PGN text, e.g. PgnReader::text()
+     * @param sink Called with each Result, in order
+     * @return The Statistics, as PgnReader::replay_all()
+     */
+    PgnReader::Statistics run(std::string_view, const sink_t & = {}) const;
+
+private:
+    /**
+     * @struct Chunk
+     * @brief Consecutive games, the unit of work
+     */
+    struct Chunk final {
+        uint64_t m_sequence{0};
+        uint64_t m_first_game{0};
+        std::vector<std::string_view> m_games{};
+    };
+
+    /**
+     * @struct Replayed
+     * @brief The Results of a Chunk
+     */
+    struct Replayed final {
+        uint64_t m_sequence{0};
+        std::vector<Result> m_results{};
+    };
+
+    /**
+     * @brief Number of worker threads
+     */
+    uint16_t m_workers;
+
+    /**
+     * @brief Capacity of the queues
+     */
+    std::size_t m_queue_capacity;
+
+    /**
+     * @brief Size the games are grouped by
+     */
+    std::size_t m_chunk_bytes;
+};
+}    // namespace dreamchess
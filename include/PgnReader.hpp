@@ -0,0 +1,125 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "MappedFile.hpp"
+#include "Pgn.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class PgnReader
+ * @brief Streaming reader of PGN files
+ * @details The file is memory-mapped and split at game boundaries, each game
+ * being a view of the mapping: nothing is copied and the page cache does the
+ * buffering, so files larger than the memory are read at disk speed
+ * @see Pgn
+ */
+class PgnReader final {
+public:
+    /**
+     * @struct Statistics
+     * @brief Outcome of replay_all()
+     */
+    struct Statistics final {
+        uint64_t m_games{0};
+        uint64_t m_plies{0};
+        uint64_t m_errors{0};
+        uint64_t m_bytes{0};
+        double m_seconds{0};
+
+        /**
+         * @fn double games_per_second()
+         * @brief Returns the throughput in games
+         */
+        [[nodiscard]] double games_per_second() const;
+
+        /**
+         * @fn double megabytes_per_second()
+         * @brief Returns the throughput in MB (10^6 bytes)
+         */
+        [[nodiscard]] double megabytes_per_second() const;
+    };
+
+    /**
+     * @fn PgnReader()
+     * @brief Creates a PgnReader with no file
+     */
+    PgnReader() = default;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Maps a PGN file and rewinds to its first game
+     * @param path The file path
+     * @return true if the file has been mapped, false otherwise
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void rewind()
+     * @brief Goes back to the first game
+     */
+    void rewind();
+
+    /**
+     * @fn std::optional<std::string_view> next()
+     * @brief Returns the next game
+     * @return The text of the game, tags and movetext, std::nullopt at the
+     * end of the file
+     */
+    [[nodiscard]] std::optional<std::string_view> next();
+
+    /**
+     * @fn std::string_view text()
+     * @brief Returns the whole mapped file
+     * @return The file contents
+     */
+    [[nodiscard]] std::string_view text() const;
+
+    /**
+     * @fn Statistics replay_all(const Pgn::visitor_t &)
+     * @brief Replays every game left through a Board
+     * @details A game with an illegal or unreadable Move counts as an error
+     * @param visit Called before each Move is made
+     * @return The Statistics
+     * @see Pgn::replay()
+     */
+    Statistics replay_all(const Pgn::visitor_t & = {});
+
+    /**
+     * @fn std::size_t game_length(std::string_view)
+     * @brief Finds where the first game of a text ends
+     * @details A game ends where a tag line follows its movetext, braces
+     * comments spanning several lines are taken into account
+     * @param text PGN text starting with a game
+     * @return The length of the game
+     */
+    [[nodiscard]] static std::size_t game_length(std::string_view);
+
+private:
+    /**
+     * @brief The mapped file
+     */
+    MappedFile m_file{};
+
+    /**
+     * @brief Offset of the next game
+     */
+    std::size_t m_offset{0};
+};
+}    // namespace dreamchess
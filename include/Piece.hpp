@@ -7,10 +7,10 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <map>
-#include <string>
-#include <utility>
+#include <string_view>
 
 /**
  * @namespace dreamchess
@@ -56,26 +56,41 @@ struct Piece final {
     };
 
     /**
-     * @typedef Defines the enum_to_char_map_t type to improve readability
+     * @struct Traits
+     * @brief What is known about a Piece at compile time
+     * @see traits()
      */
-    using enum_to_char_map_t = std::map<Enum, std::string>;
+    struct Traits final {
+        /**
+         * @brief The FEN char, ' ' for NONE
+         */
+        char m_fen;
 
-    /**
-     * @typedef Defines the char_to_enum_map_t type to improve readability
-     */
-    using char_to_enum_map_t = std::map<char, Enum>;
+        /**
+         * @brief The Unicode glyph, " " for NONE
+         */
+        std::string_view m_glyph;
 
-    /**
-     * @brief Maps a Piece::Enum representation of a Piece into the
-     * corresponding unicode character
-     */
-    static const enum_to_char_map_t m_piece_repr;
+        /**
+         * @brief The material value in centipawns, 0 for KINGs and NONE
+         */
+        int32_t m_value;
+
+        /**
+         * @brief true if the Piece slides along diagonals
+         */
+        bool m_diagonal_slider;
+
+        /**
+         * @brief true if the Piece slides along ranks and files
+         */
+        bool m_orthogonal_slider;
+    };
 
     /**
-     * @brief Maps a FEN notation Piece char representation into the
-     * corresponding Piece::Enum value
+     * @brief Number of Traits entries, every Enum value is lower
      */
-    static const char_to_enum_map_t m_fen_to_piece;
+    static constexpr std::size_t TRAITS_SIZE{256};
 
     /**
      * @brief Overloads the bitwise OR operator
@@ -83,7 +98,10 @@ struct Piece final {
      * @param rhs The second piece
      * @return The result of the ORed pieces values
      */
-    friend Enum operator|(Enum, Enum);
+    friend constexpr Enum operator|(Enum lhs, Enum rhs) {
+        return static_cast<Enum>(static_cast<uint16_t>(lhs) |
+                                 static_cast<uint16_t>(rhs));
+    }
 
     /**
      * @brief Overloads the bitwise AND operator
@@ -91,21 +109,28 @@ struct Piece final {
      * @param rhs The second piece
      * @return The result of the ANDed pieces values
      */
-    friend Enum operator&(Enum, Enum);
+    friend constexpr Enum operator&(Enum lhs, Enum rhs) {
+        return static_cast<Enum>(static_cast<uint16_t>(lhs) &
+                                 static_cast<uint16_t>(rhs));
+    }
 
     /**
      * @brief Calculates the given piece's type
      * @param target The piece which I want to know the type
      * @return The piece's type
      */
-    static Enum type(Enum);
+    static constexpr Enum type(Enum target) {
+        return target & (PAWN | KNIGHT | BISHOP | ROOK | QUEEN | KING);
+    }
 
     /**
      * @brief Calculates the given piece's color
      * @param target The piece which I want to know the color
      * @return The piece's color
      */
-    static Enum color(Enum);
+    static constexpr Enum color(Enum target) {
+        return target & (WHITE | BLACK);
+    }
 
     /**
      * @brief Calculates the target's opposite side color
@@ -113,20 +138,108 @@ struct Piece final {
      * @return The opposite side's color
      * @see color()
      */
-    static Enum opposite_side_color(Enum);
+    static constexpr Enum opposite_side_color(Enum target) {
+        return color(target) == WHITE ? BLACK : WHITE;
+    }
+
+    /**
+     * @brief Returns the Traits of a Piece
+     * @details A single load from a table built at compile time
+     * @param piece The Piece, or a bare type for the value and the slider
+     * flags
+     * @return The Traits of the Piece
+     */
+    static constexpr const Traits &traits(Enum);
 
     /**
      * @brief Returns th unicode representation of a given Piece
      * @param piece The Piece which we want to represent
      * @return The unicode representation of the Piece
      */
-    static std::string unicode_representation(Enum);
+    static constexpr std::string_view unicode_representation(Enum piece) {
+        return traits(piece).m_glyph;
+    }
 
     /**
      * @brief Returns the Piece::Enum corresponding to the given Piece
      * @param char_piece The FEN char representation of a Piece
-     * @return The FEN char of the Piece
+     * @return The Piece, NONE if the char is not a FEN Piece
      */
-    static Enum to_enum(char);
+    static constexpr Enum to_enum(char);
+
+    /**
+     * @brief Returns the FEN char corresponding to the given Piece
+     * @param piece The Piece to convert
+     * @return The FEN char of the Piece, ' ' for NONE
+     */
+    static constexpr char to_fen(Enum piece) { return traits(piece).m_fen; }
 };
-}    // namespace dreamchess
\ No newline at end of file
+
+/**
+ * @brief The Traits of every Piece::Enum value, indexed by the value
+ */
+inline constexpr std::array<Piece::Traits, Piece::TRAITS_SIZE> PIECE_TRAITS =
+    [] {
+        constexpr std::array<Piece::Enum, 6> types{
+            Piece::PAWN, Piece::KNIGHT, Piece::BISHOP,
+            Piece::ROOK, Piece::QUEEN,  Piece::KING};
+        constexpr std::string_view white_fen{"PNBRQK"};
+        constexpr std::string_view black_fen{"pnbrqk"};
+        constexpr std::array<std::string_view, 6> white_glyphs{
+            "♙", "♘", "♗", "♖", "♕", "♔"};
+        constexpr std::array<std::string_view, 6> black_glyphs{
+            "♟", "♞", "♝", "♜", "♛", "♚"};
+        constexpr std::array<int32_t, 6> values{100, 320, 330, 500, 900, 0};
+
+        std::array<Piece::Traits, Piece::TRAITS_SIZE> traits{};
+
+        for (auto &entry : traits) {
+            entry = Piece::Traits{' ', " ", 0, false, false};
+        }
+
+        for (std::size_t i = 0; i < types.size(); i++) {
+            const bool diagonal =
+                types[i] == Piece::BISHOP || types[i] == Piece::QUEEN;
+            const bool orthogonal =
+                types[i] == Piece::ROOK || types[i] == Piece::QUEEN;
+
+            // A bare type has no char nor glyph, its value is the same
+            traits[types[i]] =
+                Piece::Traits{' ', " ", values[i], diagonal, orthogonal};
+            traits[types[i] | Piece::WHITE] = Piece::Traits{
+                white_fen[i], white_glyphs[i], values[i], diagonal,
+                orthogonal};
+            traits[types[i] | Piece::BLACK] = Piece::Traits{
+                black_fen[i], black_glyphs[i], values[i], diagonal,
+                orthogonal};
+        }
+
+        return traits;
+    }();
+
+/**
+ * @brief The Piece of every FEN char, NONE for the other chars
+ */
+inline constexpr std::array<Piece::Enum, 128> PIECE_FROM_FEN = [] {
+    std::array<Piece::Enum, 128> pieces{};
+
+    for (std::size_t piece = 0; piece < PIECE_TRAITS.size(); piece++) {
+        if (PIECE_TRAITS[piece].m_fen != ' ') {
+            pieces[static_cast<std::size_t>(PIECE_TRAITS[piece].m_fen)] =
+                static_cast<Piece::Enum>(piece);
+        }
+    }
+
+    return pieces;
+}();
+
+constexpr const Piece::Traits &Piece::traits(Enum piece) {
+    return PIECE_TRAITS[piece];
+}
+
+constexpr Piece::Enum Piece::to_enum(char char_piece) {
+    const auto index = static_cast<unsigned char>(char_piece);
+
+    return index < PIECE_FROM_FEN.size() ? PIECE_FROM_FEN[index] : NONE;
+}
+}    // namespace dreamchess
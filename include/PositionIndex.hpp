@@ -0,0 +1,175 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class PositionIndex
+ * @brief On-disk index of the positions reached by stored games
+ * @details The file starts with a header (MAGIC, VERSION, the number of
+ * bucket bits and the number of entries), followed by the buckets and by
+ * the entries sorted by key, game and ply. The n-th bucket holds the first
+ * entry whose key starts with the bits of n, so a lookup binary-searches a
+ * few dozen entries. Buckets and entries are stored in the native byte order
+ * and used in place: the file is memory-mapped and lookups never allocate
+ * @see PositionIndexBuilder
+ * @see Zobrist::key()
+ */
+class PositionIndex final {
+public:
+    /**
+     * @brief First bytes of an index file
+     */
+    static constexpr std::string_view MAGIC{"DCPI"};
+
+    /**
+     * @brief Format version
+     */
+    static constexpr uint16_t VERSION{1};
+
+    /**
+     * @brief Size of the file header
+     */
+    static constexpr std::size_t HEADER_SIZE{16};
+
+    /**
+     * @brief File name extension
+     */
+    static constexpr std::string_view EXTENSION{".dcpi"};
+
+    /**
+     * @struct Entry
+     * @brief A position reached by a game
+     */
+    struct Entry final {
+        /**
+         * @brief The position key
+         */
+        uint64_t m_key;
+
+        /**
+         * @brief The game number in its GameStore
+         */
+        uint32_t m_game;
+
+        /**
+         * @brief The ply the position is reached at, 0 for the starting one
+         */
+        uint32_t m_ply;
+
+        /**
+         * @brief Orders the entries by key, game and ply
+         * @param other The Entry to compare with
+         * @return true if this Entry comes first, false otherwise
+         */
+        bool operator<(const Entry &) const;
+    };
+
+    /**
+     * @fn PositionIndex()
+     * @brief Creates a PositionIndex with no file
+     */
+    PositionIndex() = default;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Maps an index file
+     * @param path The .dcpi file path
+     * @return true if the header and the size are valid, false otherwise
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void close()
+     * @brief Unmaps the file
+     */
+    void close();
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of entries
+     * @return The number of entries, 0 if no file is open
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @fn const Entry *entries()
+     * @brief Returns the sorted entries
+     * @return The first of size() entries
+     */
+    [[nodiscard]] const Entry *entries() const;
+
+    /**
+     * @fn std::pair<const Entry *, const Entry *> find(uint64_t)
+     * @brief Looks a position key up
+     * @param key The position key
+     * @return The entries with that key, sorted by game and ply
+     */
+    [[nodiscard]] std::pair<const Entry *, const Entry *> find(
+        uint64_t) const;
+
+    /**
+     * @fn std::pair<const Entry *, const Entry *> find(const Board &)
+     * @brief Looks a position up
+     * @param board The position
+     * @return The entries of the games reaching it, sorted by game and ply
+     * @see Zobrist::key()
+     */
+    [[nodiscard]] std::pair<const Entry *, const Entry *> find(
+        const Board &) const;
+
+    /**
+     * @fn uint16_t bucket_bits(std::size_t)
+     * @brief Returns the number of bucket bits of an index
+     * @param entries The number of entries
+     * @return About 32 entries per bucket, at most 2^24 buckets
+     */
+    [[nodiscard]] static uint16_t bucket_bits(std::size_t);
+
+private:
+    /**
+     * @brief The mapped file
+     */
+    MappedFile m_file{};
+
+    /**
+     * @brief Number of bucket bits
+     */
+    uint16_t m_bits{0};
+
+    /**
+     * @brief The buckets, 2^m_bits + 1 entry positions
+     */
+    const uint64_t *m_buckets{nullptr};
+
+    /**
+     * @brief The entries
+     */
+    const Entry *m_entries{nullptr};
+
+    /**
+     * @brief Number of entries
+     */
+    std::size_t m_size{0};
+};
+}    // namespace dreamchess
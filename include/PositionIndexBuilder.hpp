@@ -0,0 +1,89 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GameStore.hpp"
+#include "PositionIndex.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class PositionIndexBuilder
+ * @brief Writes PositionIndex files
+ * @details Games are split among the threads, each one replays its share and
+ * sorts the entries it found; the sorted runs are then merged into the file.
+ * The entries are held in memory until written, 16 bytes per position.
+ * An index can be updated without replaying the whole store: the games
+ * appended to it are indexed on their own and the result is merged with the
+ * previous index
+ * @see PositionIndex
+ */
+class PositionIndexBuilder final {
+public:
+    /**
+     * @fn PositionIndexBuilder(uint16_t)
+     * @brief Creates a PositionIndexBuilder
+     * @param threads The number of worker threads, at least 1
+     */
+    explicit PositionIndexBuilder(uint16_t = 1);
+
+    /**
+     * @fn bool build(const GameStore &, const std::string &, std::size_t)
+     * @brief Indexes every position of the stored games
+     * @param store The games
+     * @param path The .dcpi file path
+     * @param first The first game to index, the previous ones are skipped
+     * @return true if the whole file has been written, false otherwise
+     * @details Malformed games are left out
+     */
+    bool build(const GameStore &, const std::string &,
+               std::size_t = 0) const;
+
+    /**
+     * @fn bool merge(const std::vector<std::string> &, const std::string &)
+     * @brief Merges index files into one
+     * @param inputs The .dcpi files, which must all refer to the same store
+     * @param path The merged file path, which can't be one of the inputs
+     * @return true if every input is valid and the whole file has been
+     * written, false otherwise
+     * @details Entries found in more than one input are written once
+     */
+    static bool merge(const std::vector<std::string> &, const std::string &);
+
+private:
+    /**
+     * @typedef Defines the run_t type, a sorted range of entries
+     */
+    using run_t =
+        std::pair<const PositionIndex::Entry *, const PositionIndex::Entry *>;
+
+    /**
+     * @brief Number of worker threads
+     */
+    uint16_t m_threads;
+
+    /**
+     * @fn bool write(std::vector<run_t>, const std::string &)
+     * @brief Merges sorted runs into an index file
+     * @param runs The runs, consumed
+     * @param path The file path
+     * @return true if the whole file has been written, false otherwise
+     */
+    static bool write(std::vector<run_t>, const std::string &);
+};
+}    // namespace dreamchess
@@ -0,0 +1,128 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Renderer
+ * @brief Draws a Board on a terminal
+ * @details Remembers the last frame: once the whole Board has been drawn,
+ * only the squares that changed are written again, each reached with an
+ * ANSI cursor movement. A frame is built in memory and written with a single
+ * write and flush. Without ANSI sequences, the whole Board is printed every
+ * time, as Board::operator<< does
+ */
+class Renderer final {
+public:
+    /**
+     * @brief Line drawn above and below the Board
+     */
+    static constexpr std::string_view SEPARATOR{"---------------------"};
+
+    /**
+     * @brief Terminal row of the first rank drawn, rows start at 1
+     */
+    static constexpr uint16_t BOARD_ROW{2};
+
+    /**
+     * @brief Terminal row the cursor is left on after a frame
+     */
+    static constexpr uint16_t PROMPT_ROW{BOARD_ROW + 9};
+
+    /**
+     * @fn Renderer(std::ostream &, bool)
+     * @brief Creates a Renderer
+     * @param stream The terminal stream
+     * @param ansi true if the terminal understands ANSI sequences
+     */
+    explicit Renderer(std::ostream &, bool = true);
+
+    /**
+     * @fn void draw(const Board &)
+     * @brief Draws a Board
+     * @details The area below the Board is cleared and the cursor is left at
+     * its start, on PROMPT_ROW
+     * @param board The Board to draw
+     */
+    void draw(const Board &);
+
+    /**
+     * @fn void invalidate()
+     * @brief Forgets the last frame, the next one redraws the whole screen
+     * @details To be called when the terminal may have scrolled
+     */
+    void invalidate();
+
+    /**
+     * @fn const std::string &frame()
+     * @brief Returns the bytes written by the last draw()
+     * @return The last frame
+     */
+    [[nodiscard]] const std::string &frame() const;
+
+private:
+    /**
+     * @brief The terminal stream
+     */
+    std::ostream &m_stream;
+
+    /**
+     * @brief Whether ANSI sequences are used
+     */
+    bool m_ansi;
+
+    /**
+     * @brief Whether m_last is on the screen
+     */
+    bool m_drawn{false};
+
+    /**
+     * @brief The squares on the screen
+     */
+    Board::piece_array_t m_last{};
+
+    /**
+     * @brief The last frame, its storage is reused
+     */
+    std::string m_frame{};
+
+    /**
+     * @fn void full_frame(const Board &)
+     * @brief Builds a frame holding the whole Board
+     * @param board The Board to draw
+     */
+    void full_frame(const Board &);
+
+    /**
+     * @fn void changes_frame(const Board &)
+     * @brief Builds a frame holding the squares changed since the last one
+     * @param board The Board to draw
+     */
+    void changes_frame(const Board &);
+
+    /**
+     * @fn void move_to(uint16_t, uint16_t)
+     * @brief Appends a cursor movement to the frame
+     * @param row The terminal row, from 1
+     * @param column The terminal column, from 1
+     */
+    void move_to(uint16_t, uint16_t);
+};
+}    // namespace dreamchess
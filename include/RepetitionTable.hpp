@@ -0,0 +1,109 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Board.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class RepetitionTable
+ * @brief Counts the repetitions of the positions of a game
+ * @details Only the positions since the last irreversible Move (a capture or
+ * a pawn Move, which reset the halfmove clock) can repeat, so the table keeps
+ * the keys of that window only. A small filter indexed by the low bits of the
+ * keys tells whether a position may have occurred before: most of the times
+ * it hasn't and no scan is needed. Each position stores how many times it has
+ * occurred, so repetitions() is O(1)
+ * @see Zobrist::key()
+ */
+class RepetitionTable final {
+public:
+    /**
+     * @brief Number of filter slots, a power of 2
+     */
+    static constexpr std::size_t FILTER_SIZE{1024};
+
+    /**
+     * @fn RepetitionTable()
+     * @brief Creates an empty RepetitionTable
+     */
+    RepetitionTable() = default;
+
+    /**
+     * @fn RepetitionTable(const Board &)
+     * @brief Creates a RepetitionTable starting from a position
+     * @param board The starting position
+     */
+    explicit RepetitionTable(const Board &);
+
+    /**
+     * @fn void clear()
+     * @brief Forgets every position
+     */
+    void clear();
+
+    /**
+     * @fn void push(const Board &)
+     * @brief Adds the position reached by a Move
+     * @param board The position
+     * @details A position with a zero halfmove clock starts a new window
+     */
+    void push(const Board &);
+
+    /**
+     * @fn uint16_t repetitions()
+     * @brief Returns how many times the last position has occurred
+     * @return 1 the first time it occurs, 0 if the table is empty
+     */
+    [[nodiscard]] uint16_t repetitions() const;
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of positions since the last irreversible Move
+     * @return The size of the window, the last position included
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /**
+     * @struct Entry
+     * @brief A position of the window
+     */
+    struct Entry final {
+        /**
+         * @brief The position key
+         */
+        uint64_t m_key;
+
+        /**
+         * @brief The occurrences of the position, this one included
+         */
+        uint16_t m_count;
+    };
+
+    /**
+     * @brief The positions since the last irreversible Move
+     */
+    std::vector<Entry> m_window{};
+
+    /**
+     * @brief The number of keys of the window per filter slot
+     */
+    std::array<uint16_t, FILTER_SIZE> m_filter{};
+};
+}    // namespace dreamchess
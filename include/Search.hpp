@@ -0,0 +1,363 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "MoveGenerator.hpp"
+#include "TimeManager.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Search
+ * @brief Iterative deepening alpha-beta search over a Board
+ * @details think() searches on the calling thread, start() on a worker
+ * thread owned by the Search. stop() and ponderhit() may be called from any
+ * thread: the stop flag is polled at every node.
+ *
+ * Principal variation search, aspiration windows, null Move pruning, late
+ * Move reductions and futility pruning with razoring are each switched by
+ * Options, so that what every technique buys can be measured
+ */
+class Search final {
+public:
+    /**
+     * @brief Maximum search depth, in plies
+     */
+    static constexpr int16_t MAX_PLY{64};
+
+    /**
+     * @brief Score of a mate at the root
+     */
+    static constexpr int32_t MATE_SCORE{32000};
+
+    /**
+     * @brief Bound larger than any score
+     */
+    static constexpr int32_t INFINITE_SCORE{32001};
+
+    /**
+     * @struct Limits
+     * @brief When the search has to end
+     * @details Times are in milliseconds, indexed by color (0 WHITE, 1
+     * BLACK). Zero means "no limit"
+     */
+    struct Limits final {
+        int16_t m_depth{MAX_PLY};
+        uint64_t m_nodes{0};
+        int64_t m_movetime{0};
+        std::array<int64_t, 2> m_time{0, 0};
+        std::array<int64_t, 2> m_increment{0, 0};
+        uint16_t m_moves_to_go{0};
+        bool m_infinite{false};
+        bool m_ponder{false};
+    };
+
+    /**
+     * @struct Report
+     * @brief Result of a completed iteration
+     */
+    struct Report final {
+        int16_t m_depth{0};
+        int32_t m_score{0};
+        uint64_t m_nodes{0};
+        int64_t m_elapsed{0};
+        std::vector<Move> m_pv{};
+    };
+
+    /**
+     * @struct Options
+     * @brief The search techniques in use, all enabled by default
+     */
+    struct Options final {
+        /**
+         * @brief Searches the Moves after the first with a null window,
+         * again with the full window only if they turn out better
+         */
+        bool m_pvs{true};
+
+        /**
+         * @brief Starts every iteration from a narrow window around the
+         * previous score, widened when the score falls out of it
+         */
+        bool m_aspiration{true};
+
+        /**
+         * @brief Passes the turn and cuts the node off if a reduced search
+         * still fails high
+         */
+        bool m_null_move{true};
+
+        /**
+         * @brief Searches late quiet Moves to a reduced depth, to the full
+         * depth only if they raise alpha
+         */
+        bool m_late_move_reductions{true};
+
+        /**
+         * @brief Skips the quiet Moves of frontier nodes too far below
+         * alpha, drops hopeless nodes to the quiescence search (razoring)
+         */
+        bool m_futility{true};
+    };
+
+    /**
+     * @typedef Defines the report_callback_t type, called after every
+     * completed iteration
+     */
+    using report_callback_t = std::function<void(const Report &)>;
+
+    /**
+     * @typedef Defines the done_callback_t type, called with the principal
+     * variation when a background search ends
+     */
+    using done_callback_t = std::function<void(const std::vector<Move> &)>;
+
+    /**
+     * @fn Search()
+     * @brief Creates an idle Search
+     */
+    Search() = default;
+
+    Search(const Search &) = delete;
+    Search &operator=(const Search &) = delete;
+
+    /**
+     * @fn ~Search()
+     * @brief Stops and joins a running background search
+     */
+    ~Search();
+
+    /**
+     * @fn std::vector<Move> think(const Board &, const Limits &, const
+     * report_callback_t &)
+     * @brief Searches the position on the calling thread
+     * @param board The position
+     * @param limits When to stop
+     * @param report Called after every completed iteration
+     * @return The principal variation, empty if there is no legal Move
+     */
+    std::vector<Move> think(const Board &, const Limits &,
+                            const report_callback_t & = {});
+
+    /**
+     * @fn void start(const Board &, const Limits &, report_callback_t,
+     * done_callback_t)
+     * @brief Searches the position on a worker thread
+     * @details Waits for the previous background search to end first
+     * @param board The position
+     * @param limits When to stop
+     * @param report Called after every completed iteration
+     * @param done Called with the principal variation at the end
+     */
+    void start(const Board &, const Limits &, report_callback_t,
+               done_callback_t);
+
+    /**
+     * @fn void stop()
+     * @brief Asks the running search to end as soon as possible
+     */
+    void stop();
+
+    /**
+     * @fn void ponderhit()
+     * @brief Turns a pondering search into a normal one
+     * @details The time budget starts counting from now
+     */
+    void ponderhit();
+
+    /**
+     * @fn void wait()
+     * @brief Joins the background search, if any
+     */
+    void wait();
+
+    /**
+     * @fn uint64_t nodes()
+     * @brief Returns the nodes visited by the last search
+     * @details May be called from any thread, while searching too
+     * @return The number of nodes
+     */
+    [[nodiscard]] uint64_t nodes() const;
+
+    /**
+     * @fn void set_options(const Options &)
+     * @brief Sets the techniques used from the next search on
+     * @details A running search keeps the Options it started with
+     * @param options The techniques to use
+     */
+    void set_options(const Options &);
+
+    /**
+     * @fn Options options()
+     * @brief Returns the techniques used by the next search
+     * @return The Options
+     */
+    [[nodiscard]] Options options() const;
+
+    /**
+     * @fn TimeManager::Statistics statistics()
+     * @brief Returns the latencies of the searches with a deadline
+     * @details May be called from any thread
+     * @return The Statistics of the TimeManager
+     * @see TimeManager::Statistics
+     */
+    [[nodiscard]] TimeManager::Statistics statistics() const;
+
+    /**
+     * @fn void reset_statistics()
+     * @brief Clears the latencies recorded so far
+     */
+    void reset_statistics();
+
+private:
+    /**
+     * @brief Set to end the search
+     */
+    std::atomic<bool> m_stop{false};
+
+    /**
+     * @brief Set while the search ponders, the time budget is ignored
+     */
+    std::atomic<bool> m_pondering{false};
+
+    /**
+     * @brief The deadlines of the current search
+     */
+    TimeManager m_time{};
+
+    /**
+     * @brief Guards the ponderhit/stop wake-up
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Wakes an infinite or pondering search waiting for stop
+     */
+    std::condition_variable m_wakeup;
+
+    /**
+     * @brief The background search thread
+     */
+    std::thread m_worker;
+
+    /**
+     * @brief The limits of the current search
+     */
+    Limits m_limits{};
+
+    /**
+     * @brief The Options of the next search
+     */
+    Options m_options{};
+
+    /**
+     * @brief The Options of the current search
+     */
+    Options m_enabled{};
+
+    /**
+     * @brief Nodes visited by the current search, only written by the
+     * searching thread and read by any
+     */
+    std::atomic<uint64_t> m_nodes{0};
+
+    /**
+     * @brief Triangular principal variation table
+     */
+    std::array<std::array<Move, MAX_PLY + 1>, MAX_PLY + 1> m_pv{};
+
+    /**
+     * @brief Length of each principal variation in m_pv
+     */
+    std::array<int16_t, MAX_PLY + 1> m_pv_length{};
+
+    /**
+     * @brief The principal variation of the last completed iteration, its
+     * Moves are searched first
+     */
+    std::array<Move, MAX_PLY + 1> m_previous_pv{};
+
+    /**
+     * @brief Length of m_previous_pv
+     */
+    int16_t m_previous_pv_length{0};
+
+    /**
+     * @fn void prepare(const Board &, const Limits &)
+     * @brief Resets the flags and starts the TimeManager
+     */
+    void prepare(const Board &, const Limits &);
+
+    /**
+     * @fn std::vector<Move> iterate(const Board &, const report_callback_t &)
+     * @brief The iterative deepening loop
+     */
+    std::vector<Move> iterate(const Board &, const report_callback_t &);
+
+    /**
+     * @fn int32_t aspiration(const Board &, int16_t, int32_t)
+     * @brief Searches the root in a window around the previous score
+     * @details The window is widened on the failing side until the score
+     * falls inside it
+     * @param board The position
+     * @param depth The depth of the iteration
+     * @param previous The score of the previous iteration
+     * @return The score of the root
+     */
+    int32_t aspiration(const Board &, int16_t, int32_t);
+
+    /**
+     * @fn int32_t negamax(const Board &, int16_t, int32_t, int32_t, int16_t,
+     * bool)
+     * @brief Principal variation search of a node
+     * @param board The position
+     * @param depth Remaining depth
+     * @param alpha Lower bound
+     * @param beta Upper bound
+     * @param ply Distance from the root
+     * @param null_move Whether a null Move may be tried, false right after
+     * one
+     * @return The score from the side to move's point of view
+     */
+    int32_t negamax(const Board &, int16_t, int32_t, int32_t, int16_t, bool);
+
+    /**
+     * @fn int32_t quiescence(const Board &, int32_t, int32_t, int16_t)
+     * @brief Searches captures only, until the position is quiet
+     */
+    int32_t quiescence(const Board &, int32_t, int32_t, int16_t);
+
+    /**
+     * @fn void order(const Board &, MoveList &, int16_t)
+     * @brief Sorts Moves: previous principal variation Move, captures
+     * (MVV-LVA), promotions, quiet Moves
+     */
+    void order(const Board &, MoveList &, int16_t) const;
+
+    /**
+     * @fn bool should_stop()
+     * @brief Polls the stop flag, the node limit and the hard deadline
+     */
+    bool should_stop();
+};
+}    // namespace dreamchess
@@ -0,0 +1,144 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Game.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class SessionTable
+ * @brief Thread-safe set of Games keyed by session id
+ * @details Sessions are spread over SHARDS maps, each one with its own
+ * mutex, so threads working on different sessions rarely wait for each
+ * other. Closed sessions give their Game back to a pool, where it's reset
+ * and handed to the next session: a Game and its reserved History are
+ * allocated once
+ */
+class SessionTable final {
+public:
+    /**
+     * @typedef Defines the session_t type, the session ids
+     */
+    using session_t = uint64_t;
+
+    /**
+     * @brief Number of shards, a power of 2
+     */
+    static constexpr std::size_t SHARDS{64};
+
+    /**
+     * @fn SessionTable()
+     * @brief Creates an empty SessionTable
+     */
+    SessionTable() = default;
+
+    SessionTable(const SessionTable &) = delete;
+    SessionTable &operator=(const SessionTable &) = delete;
+
+    /**
+     * @fn session_t open()
+     * @brief Starts a session, with a Game from the pool if any
+     * @return The session id, never 0
+     */
+    session_t open();
+
+    /**
+     * @fn bool close(session_t)
+     * @brief Ends a session and gives its Game back to the pool
+     * @param session The session id
+     * @return false if there is no such session, true otherwise
+     */
+    bool close(session_t);
+
+    /**
+     * @fn bool with(session_t, const std::function<void(Game &)> &)
+     * @brief Works on the Game of a session
+     * @param session The session id
+     * @param work Called with the Game, while no other thread can reach it
+     * @return false if there is no such session, true otherwise
+     */
+    bool with(session_t, const std::function<void(Game &)> &);
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of open sessions
+     * @return The number of sessions
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @fn std::size_t pooled()
+     * @brief Returns the number of Games waiting in the pool
+     * @return The number of pooled Games
+     */
+    [[nodiscard]] std::size_t pooled() const;
+
+private:
+    /**
+     * @struct Shard
+     * @brief A part of the sessions, with its lock
+     */
+    struct Shard final {
+        /**
+         * @brief Guards the sessions
+         */
+        std::mutex m_mutex;
+
+        /**
+         * @brief The Games, by session id
+         */
+        std::unordered_map<session_t, std::unique_ptr<Game>> m_games;
+    };
+
+    /**
+     * @brief The shards, indexed by the low bits of the session ids
+     */
+    std::array<Shard, SHARDS> m_shards{};
+
+    /**
+     * @brief The next session id
+     */
+    std::atomic<session_t> m_next{1};
+
+    /**
+     * @brief The number of open sessions
+     */
+    std::atomic<std::size_t> m_size{0};
+
+    /**
+     * @brief Guards the pool
+     */
+    mutable std::mutex m_pool_mutex;
+
+    /**
+     * @brief Reset Games, ready for a new session
+     */
+    std::vector<std::unique_ptr<Game>> m_pool{};
+
+    /**
+     * @fn Shard &shard(session_t)
+     * @brief Returns the shard of a session
+     */
+    Shard &shard(session_t);
+};
+}    // namespace dreamchess
@@ -0,0 +1,189 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+#ifdef DREAMCHESS_STATS
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Stats
+ * @brief Hot-path instrumentation counters
+ * @details Every instrumented call site owns a Probe. Each thread counts
+ * calls and elapsed ticks into its own block, the blocks are only summed
+ * when collect() or dump() is called. Unless the library is compiled with
+ * DREAMCHESS_STATS the probes expand to nothing
+ */
+class Stats final {
+public:
+    /**
+     * @enum Probe
+     * @brief The instrumented call sites
+     */
+    enum Probe : uint16_t {
+        BOARD_MOVE_IS_VALID,
+        BOARD_SQUARE_ATTACKED,
+        BOARD_ATTACK_MAP,
+        BOARD_MAKE_MOVE,
+        GAME_MAKE_MOVE,
+        HISTORY_ADD_STEP,
+
+        PROBE_COUNT
+    };
+
+    /**
+     * @struct Counter
+     * @brief Aggregated values of a single Probe
+     */
+    struct Counter final {
+        /**
+         * @brief How many times the call site has been entered
+         */
+        uint64_t m_calls{0};
+
+        /**
+         * @brief Ticks spent inside the call site (nested calls included)
+         */
+        uint64_t m_ticks{0};
+    };
+
+    /**
+     * @typedef Defines the snapshot_t type to improve readability
+     */
+    using snapshot_t = std::array<Counter, PROBE_COUNT>;
+
+    /**
+     * @class Scope
+     * @brief Scoped timer, counts a call and the ticks until its destruction
+     */
+    class Scope final {
+    public:
+        /**
+         * @fn Scope(Probe)
+         * @brief Starts timing the given Probe
+         * @param probe The instrumented call site
+         */
+        explicit Scope(Probe probe) : m_probe{probe}, m_start{ticks()} {}
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        /**
+         * @fn ~Scope()
+         * @brief Records the call and the elapsed ticks
+         * @see Stats::record()
+         */
+        ~Scope() { record(m_probe, ticks() - m_start); }
+
+    private:
+        /**
+         * @brief The instrumented call site
+         */
+        Probe m_probe;
+
+        /**
+         * @brief Tick counter value at construction
+         */
+        uint64_t m_start;
+    };
+
+    /**
+     * @fn bool enabled()
+     * @brief Tells whether the instrumentation has been compiled in
+     * @return true if built with DREAMCHESS_STATS, false otherwise
+     */
+    static constexpr bool enabled() {
+#ifdef DREAMCHESS_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @fn uint64_t ticks()
+     * @brief Reads the cheapest available monotonic tick counter
+     * @details Uses the TSC on x86, std::chrono::steady_clock nanoseconds
+     * elsewhere
+     * @return The current tick count, 0 if instrumentation is disabled
+     */
+    static uint64_t ticks() {
+#ifdef DREAMCHESS_STATS
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @fn void record(Probe, uint64_t)
+     * @brief Adds a call and its ticks to the calling thread's counters
+     * @param probe The instrumented call site
+     * @param elapsed The ticks spent in the call
+     */
+    static void record(Probe, uint64_t);
+
+    /**
+     * @fn snapshot_t collect()
+     * @brief Sums the counters of every live and exited thread
+     * @return The aggregated counters, indexed by Probe
+     */
+    [[nodiscard]] static snapshot_t collect();
+
+    /**
+     * @fn void reset()
+     * @brief Zeroes the counters of every thread
+     */
+    static void reset();
+
+    /**
+     * @fn void dump(std::ostream &)
+     * @brief Prints calls, total and average ticks per Probe
+     * @param stream The output stream
+     * @see collect()
+     */
+    static void dump(std::ostream &);
+
+    /**
+     * @fn std::string_view name(Probe)
+     * @brief Returns the call site name of a Probe
+     * @param probe The Probe to name
+     * @return The qualified name of the instrumented function
+     */
+    [[nodiscard]] static std::string_view name(Probe);
+};
+}    // namespace dreamchess
+
+#ifdef DREAMCHESS_STATS
+#define DREAMCHESS_STATS_SCOPE(probe)                  \
+    const ::dreamchess::Stats::Scope dreamchess_stats_scope_ { \
+        ::dreamchess::Stats::probe                     \
+    }
+#else
+#define DREAMCHESS_STATS_SCOPE(probe) static_cast<void>(0)
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Tablebase
+ * @brief Endgame tablebase reader
+ * @details A table holds every position of a material signature (e.g.
+ * "KRKP", the stronger side first) with one byte per position: 0 is a draw,
+ * 1-127 a win in that many moves and 128-254 a loss in (byte - 128) moves,
+ * for the side to move. The stronger side is stored as WHITE and its KING is
+ * mirrored on the a-d files (and on the first four ranks when there are no
+ * pawns). Files are memory-mapped, probing never allocates. Castling rights
+ * are not covered and en-passant captures are ignored
+ * @see TablebaseGenerator
+ */
+class Tablebase final {
+public:
+    /**
+     * @brief Maximum number of pieces in a table, KINGs included
+     */
+    static constexpr std::size_t MAX_PIECES{4};
+
+    /**
+     * @brief First bytes of a table file
+     */
+    static constexpr std::string_view MAGIC{"DCTB"};
+
+    /**
+     * @brief Size of the file header: MAGIC, then the signature padded with
+     * zeros
+     */
+    static constexpr std::size_t HEADER_SIZE{16};
+
+    /**
+     * @brief File name extension, the file name is the signature
+     */
+    static constexpr std::string_view EXTENSION{".dctb"};
+
+    /**
+     * @enum Wdl
+     * @brief Game theoretical value for the side to move
+     */
+    enum Wdl : int8_t { LOSS = -1, DRAW = 0, WIN = 1 };
+
+    /**
+     * @struct Result
+     * @brief Value of a position and distance to mate, in moves
+     */
+    struct Result final {
+        Wdl m_wdl{DRAW};
+        uint16_t m_moves{0};
+    };
+
+    /**
+     * @struct Key
+     * @brief Where a position is stored
+     */
+    struct Key final {
+        std::string m_signature{};
+        uint64_t m_index{0};
+    };
+
+    /**
+     * @fn Tablebase()
+     * @brief Creates a Tablebase with no tables
+     */
+    Tablebase() = default;
+
+    /**
+     * @fn bool open(const std::string &)
+     * @brief Maps a table file and adds it to the Tablebase
+     * @param path The .dctb file path
+     * @return true if the header and the size match a table, false otherwise
+     */
+    bool open(const std::string &);
+
+    /**
+     * @fn void close()
+     * @brief Unmaps every table
+     */
+    void close();
+
+    /**
+     * @fn std::size_t size()
+     * @brief Returns the number of mapped tables
+     * @return The number of tables
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @fn std::optional<Result> probe(const Board &)
+     * @brief Looks a position up
+     * @param board The position
+     * @return The Result, std::nullopt if no table covers the position
+     */
+    [[nodiscard]] std::optional<Result> probe(const Board &) const;
+
+    /**
+     * @fn std::optional<std::string> signature(std::string_view)
+     * @brief Normalizes a material signature
+     * @param text The pieces of both sides, each one starting with its KING
+     * (e.g. "kpkr")
+     * @return The signature with the stronger side first and the pieces
+     * sorted (e.g. "KRKP"), std::nullopt if malformed or too large
+     */
+    [[nodiscard]] static std::optional<std::string> signature(
+        std::string_view);
+
+    /**
+     * @fn uint64_t entries(std::string_view)
+     * @brief Returns the number of positions of a table
+     * @param signature A normalized signature
+     * @return The number of indices, half of them with WHITE to move
+     */
+    [[nodiscard]] static uint64_t entries(std::string_view);
+
+    /**
+     * @fn std::optional<Key> key(const Board &)
+     * @brief Computes the table and the index of a position
+     * @param board The position
+     * @return The Key, std::nullopt with castling rights or too many pieces
+     */
+    [[nodiscard]] static std::optional<Key> key(const Board &);
+
+    /**
+     * @fn std::optional<Board> position(std::string_view, uint64_t)
+     * @brief The inverse of key()
+     * @param signature A normalized signature
+     * @param index An index lower than entries()
+     * @return The position, std::nullopt if two pieces share a square. The
+     * position may be illegal
+     */
+    [[nodiscard]] static std::optional<Board> position(std::string_view,
+                                                       uint64_t);
+
+    /**
+     * @fn Result decode(uint8_t)
+     * @brief Converts a table byte
+     * @param value The stored byte
+     * @return The Result
+     */
+    [[nodiscard]] static Result decode(uint8_t);
+
+private:
+    /**
+     * @brief The mapped tables, by signature
+     */
+    std::map<std::string, MappedFile, std::less<>> m_tables{};
+};
+}    // namespace dreamchess
@@ -0,0 +1,165 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Board.hpp"
+#include "Tablebase.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class TablebaseGenerator
+ * @brief Builds Tablebase tables by retrograde analysis
+ * @details Every position is evaluated once, counting its successors in the
+ * same table. Then the analysis proceeds one ply at a time from the
+ * positions resolved at the previous ply: their predecessors win if they
+ * were lost, or have one successor less to wait for if they were won. A
+ * position left without successors to wait for is evaluated again, and so
+ * are the positions whose value depends on smaller tables (reached by
+ * captures and promotions) when it is due. Each ply is split among the
+ * worker threads, which only read the tables while results are collected
+ * and written back at the end of the ply. Smaller tables are generated
+ * first and kept in memory
+ * @see Tablebase
+ */
+class TablebaseGenerator final {
+public:
+    /**
+     * @typedef Defines the table_t type, one Tablebase byte per index
+     */
+    using table_t = std::vector<uint8_t>;
+
+    /**
+     * @typedef Defines the progress_callback_t type, called with the
+     * signature, the ply just completed and the positions resolved at it
+     */
+    using progress_callback_t =
+        std::function<void(std::string_view, uint16_t, uint64_t)>;
+
+    /**
+     * @fn TablebaseGenerator(uint16_t)
+     * @brief Creates a generator
+     * @param threads Number of worker threads, at least one is used
+     */
+    explicit TablebaseGenerator(uint16_t);
+
+    /**
+     * @fn const table_t &generate(std::string_view, const
+     * progress_callback_t &)
+     * @brief Generates a table and, before it, every table it depends on
+     * @param signature A normalized signature
+     * @param progress Called at the end of every ply
+     * @return The table
+     * @see Tablebase::signature()
+     */
+    const table_t &generate(std::string_view, const progress_callback_t & = {});
+
+    /**
+     * @fn const std::map<std::string, table_t, std::less<>> &tables()
+     * @brief Returns every table generated so far
+     * @return The tables, by signature
+     */
+    [[nodiscard]] const std::map<std::string, table_t, std::less<>> &tables()
+        const;
+
+    /**
+     * @fn bool write(std::string_view, const std::string &)
+     * @brief Writes a generated table in the Tablebase format
+     * @param signature The signature of a generated table
+     * @param path The destination file
+     * @return true if the file has been written, false otherwise
+     */
+    [[nodiscard]] bool write(std::string_view, const std::string &) const;
+
+    /**
+     * @fn std::vector<std::string> dependencies(std::string_view)
+     * @brief Lists the tables reached by a capture or a promotion
+     * @param signature A normalized signature
+     * @return The normalized signatures, without duplicates
+     */
+    [[nodiscard]] static std::vector<std::string> dependencies(
+        std::string_view);
+
+private:
+    /**
+     * @struct Verdict
+     * @brief Outcome of the evaluation of a position at a given ply
+     * @details m_value is UNKNOWN while the position is unresolved, m_ply
+     * is the later ply at which a known value is due, 0 if none.
+     * m_unknown counts the successors in the same table not resolved yet
+     */
+    struct Verdict final {
+        uint8_t m_value;
+        uint16_t m_ply;
+        uint8_t m_unknown;
+    };
+
+    /**
+     * @brief Number of worker threads
+     */
+    uint16_t m_threads;
+
+    /**
+     * @brief The generated tables
+     */
+    std::map<std::string, table_t, std::less<>> m_tables{};
+
+    /**
+     * @fn Verdict evaluate(std::string_view, const table_t &, uint64_t,
+     * uint16_t)
+     * @brief Evaluates a position from the values of its successors
+     * @param signature The signature of the table being generated
+     * @param values The table being generated
+     * @param index The position
+     * @param ply The current ply
+     * @return The Verdict
+     */
+    [[nodiscard]] Verdict evaluate(std::string_view, const table_t &,
+                                   uint64_t, uint16_t) const;
+
+    /**
+     * @fn uint8_t lookup(std::string_view, const table_t &, const Board &)
+     * @brief Reads the value of a successor, in this or a smaller table
+     */
+    [[nodiscard]] uint8_t lookup(std::string_view, const table_t &,
+                                 const Board &) const;
+
+    /**
+     * @fn void predecessors(std::string_view, uint64_t,
+     * std::vector<uint64_t> &)
+     * @brief Appends the positions which reach a position without capturing
+     * or promoting
+     * @details Illegal predecessors are appended too, they are resolved as
+     * draws before the first ply
+     */
+    static void predecessors(std::string_view, uint64_t,
+                             std::vector<uint64_t> &);
+
+    /**
+     * @fn void parallel_for(std::size_t, const std::function<void(uint16_t,
+     * std::size_t, std::size_t)> &)
+     * @brief Splits [0, size) among the worker threads
+     * @param size The number of items
+     * @param work Called with the thread number and its range
+     */
+    void parallel_for(
+        std::size_t,
+        const std::function<void(uint16_t, std::size_t, std::size_t)> &) const;
+};
+}    // namespace dreamchess
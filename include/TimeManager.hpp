@@ -0,0 +1,253 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class TimeManager
+ * @brief Decides how long the Search thinks about a Move
+ * @details start() splits the clock in two deadlines. The soft one is the
+ * time the Move is expected to take: no iteration starts once it can't end
+ * before it. The hard one is never crossed: the Search polls it every
+ * CHECK_INTERVAL nodes, so the clock is read once per thousand nodes and
+ * not at each one. A best Move which keeps changing between iterations
+ * stretches the soft deadline, up to the hard one.
+ *
+ * Every Move searched with a deadline is recorded in the Statistics, with
+ * how late it was, so that latency percentiles can be checked under load
+ */
+class TimeManager final {
+public:
+    /**
+     * @brief Nodes between two reads of the clock
+     */
+    static constexpr uint64_t CHECK_INTERVAL{1024};
+
+    /**
+     * @brief Time kept in reserve when the deadlines come from the clock,
+     * in milliseconds
+     */
+    static constexpr int64_t MOVE_OVERHEAD{50};
+
+    /**
+     * @brief Moves the clock is split among when the moves to go are
+     * unknown
+     */
+    static constexpr uint16_t DEFAULT_MOVES_TO_GO{30};
+
+    /**
+     * @brief The hard deadline is at most this many soft ones
+     */
+    static constexpr int64_t HARD_RATIO{4};
+
+    /**
+     * @struct Statistics
+     * @brief Latencies of the Moves searched with a deadline
+     * @details Times are in milliseconds
+     */
+    struct Statistics final {
+        /**
+         * @brief Number of buckets of m_overruns
+         */
+        static constexpr std::size_t BUCKETS{256};
+
+        /**
+         * @brief Moves searched with a deadline
+         */
+        uint64_t m_moves{0};
+
+        /**
+         * @brief Moves given an iteration past the soft deadline because
+         * their best Move was unstable
+         */
+        uint64_t m_extended{0};
+
+        /**
+         * @brief Moves which took longer than the soft deadline
+         */
+        uint64_t m_soft_overruns{0};
+
+        /**
+         * @brief Moves which took longer than the hard deadline
+         */
+        uint64_t m_hard_overruns{0};
+
+        /**
+         * @brief The longest Move
+         */
+        int64_t m_max_latency{0};
+
+        /**
+         * @brief The longest time past a hard deadline
+         */
+        int64_t m_max_overrun{0};
+
+        /**
+         * @brief Moves by time past the hard deadline, a bucket per
+         * millisecond. The first one also holds the Moves on time, the
+         * last one the Moves later than that
+         */
+        std::array<uint64_t, BUCKETS> m_overruns{};
+
+        /**
+         * @fn int64_t overrun_percentile(double)
+         * @brief Returns the time past the hard deadline below which a
+         * fraction of the Moves ended
+         * @param fraction The fraction, 0.99 for the 99th percentile
+         * @return The overrun, 0 if the Moves were on time, BUCKETS - 1 or
+         * more if it's beyond the histogram
+         */
+        [[nodiscard]] int64_t overrun_percentile(double) const;
+    };
+
+    /**
+     * @fn TimeManager()
+     * @brief Creates a TimeManager with no deadline
+     */
+    TimeManager() = default;
+
+    TimeManager(const TimeManager &) = delete;
+    TimeManager &operator=(const TimeManager &) = delete;
+
+    /**
+     * @fn void start(int64_t, int64_t, uint16_t, int64_t)
+     * @brief Starts the clock of a Move and computes its deadlines
+     * @details A fixed move time makes both deadlines. Otherwise the soft
+     * deadline is an even share of the clock plus most of the increment,
+     * the hard one HARD_RATIO times that, within a quarter of the clock.
+     * Zero times mean no deadline
+     * @param time The time left on the clock
+     * @param increment The time added after the Move
+     * @param moves_to_go Moves until the next time control, 0 if unknown
+     * @param movetime The exact time to think, 0 if not fixed
+     */
+    void start(int64_t, int64_t, uint16_t, int64_t);
+
+    /**
+     * @fn void restart()
+     * @brief Starts the clock again, with the same deadlines
+     * @details May be called from any thread, used on ponderhit
+     */
+    void restart();
+
+    /**
+     * @fn bool out_of_time(uint64_t)
+     * @brief Tells whether the hard deadline has passed
+     * @details The clock is only read every CHECK_INTERVAL nodes
+     * @param nodes The nodes searched so far
+     * @return true if the search has to stop, false otherwise
+     */
+    [[nodiscard]] bool out_of_time(uint64_t) const;
+
+    /**
+     * @fn bool completed(bool)
+     * @brief Records a completed iteration
+     * @details A changed best Move stretches the soft deadline, a stable
+     * one lets the stretch decay
+     * @param changed Whether the best Move differs from the previous
+     * iteration's
+     * @return true if another iteration can end before the soft deadline,
+     * false otherwise
+     */
+    bool completed(bool);
+
+    /**
+     * @fn void finish()
+     * @brief Records the latency of the Move in the Statistics
+     * @details Moves searched with no deadline are not recorded
+     */
+    void finish();
+
+    /**
+     * @fn int64_t elapsed()
+     * @brief Milliseconds since the clock started
+     * @return The time spent on the Move
+     */
+    [[nodiscard]] int64_t elapsed() const;
+
+    /**
+     * @fn int64_t soft_deadline()
+     * @brief Returns the soft deadline, before any stretch
+     * @return The deadline in milliseconds, 0 if none
+     */
+    [[nodiscard]] int64_t soft_deadline() const;
+
+    /**
+     * @fn int64_t hard_deadline()
+     * @brief Returns the hard deadline
+     * @return The deadline in milliseconds, 0 if none
+     */
+    [[nodiscard]] int64_t hard_deadline() const;
+
+    /**
+     * @fn Statistics statistics()
+     * @brief Copies the Statistics, may be called from any thread
+     * @return The Statistics since the last reset
+     */
+    [[nodiscard]] Statistics statistics() const;
+
+    /**
+     * @fn void reset_statistics()
+     * @brief Clears the Statistics
+     */
+    void reset_statistics();
+
+private:
+    /**
+     * @typedef Defines the clock_t type to improve readability
+     */
+    using clock_t = std::chrono::steady_clock;
+
+    /**
+     * @brief Start of the clock, as clock_t ticks
+     */
+    std::atomic<clock_t::rep> m_start{0};
+
+    /**
+     * @brief The soft deadline in milliseconds, 0 if none
+     */
+    int64_t m_soft{0};
+
+    /**
+     * @brief The hard deadline in milliseconds, 0 if none
+     */
+    int64_t m_hard{0};
+
+    /**
+     * @brief Stretch of the soft deadline, in percent of it
+     */
+    int64_t m_stretch{0};
+
+    /**
+     * @brief Whether the stretch granted an iteration to the current Move
+     */
+    bool m_extended{false};
+
+    /**
+     * @brief Guards m_statistics
+     */
+    mutable std::mutex m_mutex{};
+
+    /**
+     * @brief The Statistics since the last reset
+     */
+    Statistics m_statistics{};
+};
+}    // namespace dreamchess
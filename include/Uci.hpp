@@ -0,0 +1,172 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "Board.hpp"
+#include "Book.hpp"
+#include "Search.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Uci
+ * @brief Universal Chess Interface front-end
+ * @details Commands are parsed on the thread calling loop() or execute(),
+ * the engine thinks on the Search worker thread. Both threads write to the
+ * output stream, one full line at a time
+ */
+class Uci final {
+public:
+    /**
+     * @fn Uci(std::istream &, std::ostream &)
+     * @brief Creates the front-end on the given streams
+     * @param input Where commands are read from
+     * @param output Where answers are written to
+     */
+    Uci(std::istream &, std::ostream &);
+
+    /**
+     * @fn ~Uci()
+     * @brief Stops the running search, if any
+     */
+    ~Uci();
+
+    Uci(const Uci &) = delete;
+    Uci &operator=(const Uci &) = delete;
+
+    /**
+     * @fn void loop()
+     * @brief Reads and executes commands until "quit" or end of input
+     * @see execute()
+     */
+    void loop();
+
+    /**
+     * @fn bool execute(std::string_view)
+     * @brief Executes a single command line
+     * @param line The command line
+     * @return false if the command was "quit", true otherwise
+     */
+    bool execute(std::string_view);
+
+    /**
+     * @fn void wait()
+     * @brief Waits for the running search to send its bestmove
+     * @see Search::wait()
+     */
+    void wait();
+
+    /**
+     * @fn const Board &board()
+     * @brief The position set by the last "position" command
+     * @return The current Board
+     */
+    [[nodiscard]] const Board &board() const;
+
+private:
+    /**
+     * @brief The command stream
+     */
+    std::istream &m_input;
+
+    /**
+     * @brief The answer stream
+     */
+    std::ostream &m_output;
+
+    /**
+     * @brief Serializes the writes of the two threads
+     */
+    std::mutex m_output_mutex;
+
+    /**
+     * @brief The position to search
+     */
+    Board m_board{};
+
+    /**
+     * @brief The engine
+     */
+    Search m_search{};
+
+    /**
+     * @brief Value of the "Ponder" option
+     */
+    std::atomic<bool> m_ponder{false};
+
+    /**
+     * @brief The opening book, set by the "BookFile" option
+     */
+    Book m_book{};
+
+    /**
+     * @brief Picks among the book Moves
+     */
+    std::mt19937_64 m_random{std::random_device{}()};
+
+    /**
+     * @fn void send(std::string_view)
+     * @brief Writes and flushes a line
+     * @param line The line, without the trailing newline
+     */
+    void send(std::string_view);
+
+    /**
+     * @fn void identify()
+     * @brief Answers "uci" with the engine name and options
+     */
+    void identify();
+
+    /**
+     * @fn void position(std::istringstream &)
+     * @brief Handles "position [startpos | fen <fen>] [moves <m1> ...]"
+     * @param args The arguments of the command
+     */
+    void position(std::istringstream &);
+
+    /**
+     * @fn void go(std::istringstream &)
+     * @brief Handles "go", starting a background search
+     * @param args The arguments of the command
+     */
+    void go(std::istringstream &);
+
+    /**
+     * @fn void set_option(std::istringstream &)
+     * @brief Handles "setoption name <id> [value <x>]"
+     * @param args The arguments of the command
+     */
+    void set_option(std::istringstream &);
+
+    /**
+     * @fn void report(const Search::Report &)
+     * @brief Sends an "info" line for a completed iteration
+     * @param report The iteration result
+     */
+    void report(const Search::Report &);
+
+    /**
+     * @fn void best_move(const std::vector<Move> &)
+     * @brief Sends the "bestmove" line
+     * @param pv The principal variation
+     */
+    void best_move(const std::vector<Move> &);
+};
+}    // namespace dreamchess
@@ -0,0 +1,76 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "Board.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+/**
+ * @class Zobrist
+ * @brief 64-bit position keys
+ * @details Keys follow the Polyglot layout: 768 piece-square values, 4
+ * castling values, 8 en-passant file values and the side to move value. The
+ * en-passant file only counts when a pawn can actually capture. The random
+ * values are generated at compile time and are not Polyglot's, so the keys
+ * differ from the ones of Polyglot books
+ */
+class Zobrist final {
+public:
+    /**
+     * @brief Number of random values in the table
+     */
+    static constexpr uint16_t TABLE_SIZE{781};
+
+    /**
+     * @fn uint64_t key(const Board &)
+     * @brief Computes the key of a position from scratch
+     * @param board The position
+     * @return The position key
+     */
+    [[nodiscard]] static uint64_t key(const Board &);
+
+    /**
+     * @fn uint64_t piece(Board::piece_t, uint16_t)
+     * @brief Returns the value of a Piece standing on a square
+     * @param piece The Piece, must not be NONE
+     * @param square The square
+     * @return The random value
+     */
+    [[nodiscard]] static uint64_t piece(Board::piece_t, uint16_t);
+
+    /**
+     * @fn uint64_t castling(uint8_t)
+     * @brief Returns the value of a set of castling rights
+     * @param rights The ORed Board::Castling flags
+     * @return The XOR of the values of every right
+     */
+    [[nodiscard]] static uint64_t castling(uint8_t);
+
+    /**
+     * @fn uint64_t en_passant(const Board &)
+     * @brief Returns the en-passant contribution of a position
+     * @param board The position
+     * @return The file value if a pawn can capture en-passant, 0 otherwise
+     */
+    [[nodiscard]] static uint64_t en_passant(const Board &);
+
+    /**
+     * @fn uint64_t turn()
+     * @brief Returns the value toggled when WHITE is to move
+     * @return The random value
+     */
+    [[nodiscard]] static uint64_t turn();
+};
+}    // namespace dreamchess
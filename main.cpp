@@ -5,39 +5,214 @@
  * @date July-October, 2021
  * @file
  */
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 
+#include "Batch.hpp"
 #include "Game.hpp"
+#include "Renderer.hpp"
+#include "Stats.hpp"
+
+namespace {
+void usage() {
+    std::cerr
+        << "usage: dreamchess++ [-j journal | -b [file] | -e seconds[+inc]]\n"
+           "  -j journals the game, resuming the one it holds\n"
+           "  -b replays the games of file, or of stdin, one per line\n"
+           "  -e lets the engine play black, with a clock of seconds plus\n"
+           "     inc seconds per move\n";
+}
+
+/**
+ * @brief Parses "seconds[+increment]" into milliseconds
+ */
+std::optional<std::pair<int64_t, int64_t>> parse_clock(std::string_view text) {
+    const char *const end = text.data() + text.size();
+    int64_t seconds = 0;
+    int64_t increment = 0;
+
+    std::from_chars_result parsed =
+        std::from_chars(text.data(), end, seconds);
+
+    if (parsed.ec != std::errc{} || seconds <= 0) {
+        return std::nullopt;
+    }
+
+    if (parsed.ptr != end) {
+        if (*parsed.ptr != '+') {
+            return std::nullopt;
+        }
+
+        parsed = std::from_chars(parsed.ptr + 1, end, increment);
+
+        if (parsed.ec != std::errc{} || parsed.ptr != end || increment < 0) {
+            return std::nullopt;
+        }
+    }
+
+    return std::pair{seconds * 1000, increment * 1000};
+}
+
+int replay(std::istream &input) {
+    const auto start = std::chrono::steady_clock::now();
+
+    dreamchess::Batch batch{std::cout};
+    batch.run(input);
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const dreamchess::Batch::Totals &totals = batch.totals();
+
+    const auto rate =
+        static_cast<uint64_t>(static_cast<double>(totals.m_moves) /
+                              std::max(elapsed.count(), 1e-9));
+
+    std::cerr << totals.m_games << " games, " << totals.m_moves << " moves, "
+              << totals.m_rejected << " rejected in " << elapsed.count()
+              << " s (" << rate << " moves/s)\n";
+
+    return 0;
+}
+}    // namespace
+
+int main(int argc, char **argv) {
+    const bool journaled = argc == 3 && std::string{argv[1]} == "-j";
+    const bool engine = argc == 3 && std::string{argv[1]} == "-e";
+
+    if (argc > 1 && !journaled && !engine) {
+        if (std::string{argv[1]} != "-b" || argc > 3) {
+            usage();
+            return 1;
+        }
+
+        std::ios::sync_with_stdio(false);
+
+        if (argc == 2) {
+            return replay(std::cin);
+        }
+
+        std::ifstream file{argv[2]};
+
+        if (!file) {
+            std::cerr << "cannot open " << argv[2] << "\n";
+            return 1;
+        }
+
+        return replay(file);
+    }
 
-int main() {
     dreamchess::Game game{};
+    dreamchess::Renderer renderer{std::cout, isatty(STDOUT_FILENO) == 1};
+
+    if (journaled && !game.open_journal(argv[2])) {
+        std::cerr << "cannot journal to " << argv[2] << "\n";
+        return 1;
+    }
+
+    // The engine's clock and increment, in milliseconds
+    std::optional<std::pair<int64_t, int64_t>> clock;
+
+    if (engine && !(clock = parse_clock(argv[2]))) {
+        usage();
+        return 1;
+    }
 
     std::string input_move;
 
     while (game.is_in_game()) {
-        std::cout << "---------------------" << std::endl;
-        std::cout << game;
-        std::cout << "---------------------" << std::endl;
+        renderer.draw(game.board());
+
+        if (game.board().is_in_check()) {
+            std::cout << "Check!" << std::endl;
+        }
+
+        if (engine && game.board().turn() == dreamchess::Piece::BLACK) {
+            dreamchess::Search::Limits limits{};
+            limits.m_time[1] = clock->first;
+            limits.m_increment[1] = clock->second;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            if (!game.engine_move(limits)) {
+                std::cout << "The engine has no move!" << std::endl;
+                break;
+            }
+
+            const auto spent =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start);
+
+            clock->first += clock->second - spent.count();
+
+            if (clock->first <= 0) {
+                std::cout << "The engine lost on time!" << std::endl;
+                break;
+            }
+
+            continue;
+        }
 
         bool valid{false};
 
+        // A command which doesn't end the turn, the prompt comes back with
+        // no error
+        bool handled{false};
+
         do {
             std::cout << "Input move: ";
             std::cin >> input_move;
+            handled = false;
 
             if (input_move == "export_history") {
                 game.export_to_file();
                 valid = true;
+            } else if (input_move == "stats") {
+                dreamchess::Stats::dump(std::cout);
+                // The dump scrolls the Board off the screen
+                renderer.invalidate();
+                handled = true;
             } else {
                 if (dreamchess::Game::is_move_syntax_correct(input_move)) {
                     valid = game.make_move(input_move);
                 }
             }
-        } while (!valid && (std::cout << "Invalid move! Retry!" << std::endl));
+
+            if (!valid && !handled) {
+                std::cout << "Invalid move! Retry!" << std::endl;
+                // Repeated retries can scroll the Board too
+                renderer.invalidate();
+            }
+        } while (!valid);
     }
 
     std::cout << "Game is over!" << std::endl;
 
+    if (game.draw_reason() != dreamchess::Game::NO_DRAW) {
+        std::cout << "Draw by "
+                  << dreamchess::Game::describe(game.draw_reason())
+                  << std::endl;
+    }
+
+    if (engine) {
+        const dreamchess::TimeManager::Statistics statistics =
+            game.engine_statistics();
+
+        std::cerr << "engine: " << statistics.m_moves << " moves, max "
+                  << statistics.m_max_latency << " ms, "
+                  << statistics.m_hard_overruns
+                  << " past the hard deadline, p99 overrun "
+                  << statistics.overrun_percentile(0.99) << " ms\n";
+    }
+
     return 0;
 }
@@ -0,0 +1,122 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Batch.hpp"
+
+#include <algorithm>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Characters separating the moves of a game
+ */
+constexpr std::string_view BLANKS{" \t\r"};
+
+/**
+ * @brief Splits the first move off a game
+ */
+std::string_view next_move(std::string_view &line) {
+    const std::size_t begin =
+        std::min(line.find_first_not_of(BLANKS), line.size());
+    const std::size_t end = std::min(line.find_first_of(BLANKS, begin),
+                                     line.size());
+    const std::string_view move = line.substr(begin, end - begin);
+    line.remove_prefix(end);
+
+    return move;
+}
+}    // namespace
+
+Batch::Batch(std::ostream &output) : m_output{output} {
+    m_buffer.reserve(BUFFER_SIZE + 256);
+}
+
+Batch::~Batch() { finish(); }
+
+void Batch::run(std::istream &input) {
+    std::string line;
+
+    while (std::getline(input, line)) {
+        play(line);
+    }
+
+    finish();
+}
+
+void Batch::play(std::string_view line) {
+    const std::size_t first = line.find_first_not_of(BLANKS);
+
+    if (first == std::string_view::npos || line[first] == '#') {
+        return;
+    }
+
+    m_game.reset();
+
+    uint64_t played = 0;
+    std::string_view rejected{};
+    std::string_view result{"ok"};
+
+    for (std::string_view move = next_move(line); !move.empty();
+         move = next_move(line)) {
+        if (!m_game.is_in_game()) {
+            result = "over";
+        } else if (!Game::is_move_syntax_correct(move)) {
+            result = "syntax";
+        } else if (!m_game.make_move(move)) {
+            result = "illegal";
+        } else {
+            played++;
+            continue;
+        }
+
+        rejected = move;
+        break;
+    }
+
+    if (rejected.empty() && !m_game.is_in_game()) {
+        result = "over";
+    }
+
+    m_totals.m_games++;
+    m_totals.m_moves += played;
+    m_totals.m_rejected += !rejected.empty();
+
+    m_buffer.append(std::to_string(m_totals.m_games))
+        .append(" ")
+        .append(result)
+        .append(" ")
+        .append(std::to_string(played))
+        .append(" ");
+
+    if (!rejected.empty()) {
+        m_buffer.append(rejected).append(" ");
+    }
+
+    m_buffer.append(m_game.board().fen()).append("\n");
+
+    if (m_buffer.size() >= BUFFER_SIZE) {
+        m_output.write(m_buffer.data(),
+                       static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+    }
+}
+
+void Batch::finish() {
+    m_output.write(m_buffer.data(),
+                   static_cast<std::streamsize>(m_buffer.size()));
+    m_output.flush();
+    m_buffer.clear();
+}
+
+[[nodiscard]] const Batch::Totals &Batch::totals() const { return m_totals; }
+}    // namespace dreamchess
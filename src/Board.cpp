@@ -14,6 +14,7 @@
 #include <sstream>
 
 #include "Move.hpp"
+#include "Stats.hpp"
 
 /**
  * @namespace dreamchess
@@ -21,17 +22,207 @@
  * @details Used to avoid the std namespace pollution
  */
 namespace dreamchess {
+namespace {
+/**
+ * @brief Maps a Piece to its slot in the captured pieces array
+ * @param piece The captured Piece
+ * @return WHITE pieces in [0,5], BLACK pieces in [6,11]
+ */
+uint16_t captured_index(Piece::Enum piece) {
+    uint16_t index = Piece::color(piece) == Piece::WHITE ? 0 : 6;
+
+    for (uint16_t type = Piece::type(piece); type > 1; type >>= 1) {
+        index++;
+    }
+
+    return index;
+}
+
+/**
+ * @brief The material key of a single Piece
+ * @param piece The Piece
+ * @return The value added to the key for each Piece of its kind
+ */
+uint64_t material_unit(Piece::Enum piece) {
+    return piece == Piece::NONE
+               ? 0
+               : uint64_t{1} << (Board::MATERIAL_BITS * captured_index(piece));
+}
+
+/**
+ * @brief Castling rights kept after a Move touches a square
+ * @param square The source or destination square of the Move
+ * @return The mask to AND the castling rights with
+ */
+uint8_t castling_mask(int16_t square) {
+    switch (square) {
+        case 0:
+            return ~Board::WHITE_QUEENSIDE;
+        case 4:
+            return ~(Board::WHITE_KINGSIDE | Board::WHITE_QUEENSIDE);
+        case 7:
+            return ~Board::WHITE_KINGSIDE;
+        case 56:
+            return ~Board::BLACK_QUEENSIDE;
+        case 60:
+            return ~(Board::BLACK_KINGSIDE | Board::BLACK_QUEENSIDE);
+        case 63:
+            return ~Board::BLACK_KINGSIDE;
+        default:
+            return Board::ALL_CASTLING;
+    }
+}
+
+/**
+ * @typedef Defines the square_table_t type, a set of squares for each square
+ */
+using square_table_t = std::array<uint64_t, 64>;
+
+constexpr uint64_t FILE_A{0x0101010101010101};
+constexpr uint64_t FILE_H{FILE_A << 7};
+
+/**
+ * @brief Builds the squares a KNIGHT or a KING reaches from every square
+ * @param steps The (file, rank) offsets of the Piece
+ * @return The table of the reached squares
+ */
+constexpr square_table_t step_table(const int16_t (&steps)[8][2]) {
+    square_table_t table{};
 
-Board::Board() { init_board(); }
+    for (int16_t square = 0; square < 64; square++) {
+        for (const auto &step : steps) {
+            const int16_t file = square % 8 + step[0];
+            const int16_t rank = square / 8 + step[1];
 
-Board::~Board() { m_captured.clear(); }
+            if (file >= 0 && file < 8 && rank >= 0 && rank < 8) {
+                table[square] |= uint64_t{1} << (rank * 8 + file);
+            }
+        }
+    }
+
+    return table;
+}
+
+constexpr int16_t KNIGHT_STEPS[8][2]{{1, 2},   {2, 1},   {2, -1}, {1, -2},
+                                     {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+
+constexpr int16_t KING_STEPS[8][2]{{1, 0},   {1, 1},   {0, 1},  {-1, 1},
+                                   {-1, 0},  {-1, -1}, {0, -1}, {1, -1}};
+
+constexpr square_table_t KNIGHT_ATTACKS{step_table(KNIGHT_STEPS)};
+constexpr square_table_t KING_ATTACKS{step_table(KING_STEPS)};
+
+/**
+ * @brief Adds one attacker to each square of a set
+ * @param squares The attacked squares
+ * @param map The attack map to update
+ */
+void add_attacks(uint64_t squares, Board::AttackMap &map) {
+    map.m_attacked |= squares;
+
+    for (; squares != 0; squares &= squares - 1) {
+        map.m_attackers[__builtin_ctzll(squares)]++;
+    }
+}
+
+/**
+ * @brief Collects the squares a slider reaches along a line
+ * @param square The slider's square
+ * @param step The (file, rank) offset of the line
+ * @param occupied The occupied squares, blocking the slider
+ * @return The reached squares, the first occupied one included
+ */
+uint64_t ray(int16_t square, const int16_t (&step)[2], uint64_t occupied) {
+    uint64_t squares = 0;
+    int16_t file = square % 8 + step[0];
+    int16_t rank = square / 8 + step[1];
+
+    for (; file >= 0 && file < 8 && rank >= 0 && rank < 8;
+         file += step[0], rank += step[1]) {
+        const uint64_t target = uint64_t{1} << (rank * 8 + file);
+        squares |= target;
+
+        if ((occupied & target) != 0) {
+            break;
+        }
+    }
+
+    return squares;
+}
+
+/**
+ * @brief Checks a position before it's set
+ * @details At most 16 Pieces and 8 pawns per side, exactly one KING per
+ * side and no pawn on the first or the last rank, anything else could
+ * overflow a MoveList. The en-passant square lies behind a pawn of the side
+ * which just moved, else make_move() could take the mover's own pawn
+ * @param squares The Pieces of the position
+ * @param turn The side to move
+ * @param en_passant The en-passant square, NO_SQUARE if none
+ * @return true if the position is possible, false otherwise
+ */
+bool is_valid_position(const Board::piece_array_t &squares,
+                       Board::piece_t turn, int16_t en_passant) {
+    std::array<uint16_t, 2> pieces{};
+    std::array<uint16_t, 2> pawns{};
+    std::array<uint16_t, 2> kings{};
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Piece::Enum piece = squares[square];
+
+        if (piece == Piece::NONE) {
+            continue;
+        }
+
+        const std::size_t side = Piece::color(piece) == Piece::WHITE ? 0 : 1;
+        pieces[side]++;
+
+        if (Piece::type(piece) == Piece::KING) {
+            kings[side]++;
+        } else if (Piece::type(piece) == Piece::PAWN) {
+            if (square < 8 || square >= 56) {
+                return false;
+            }
+
+            pawns[side]++;
+        }
+    }
+
+    for (std::size_t side = 0; side < 2; side++) {
+        if (pieces[side] > 16 || pawns[side] > 8 || kings[side] != 1) {
+            return false;
+        }
+    }
+
+    if (en_passant == Board::NO_SQUARE) {
+        return true;
+    }
+
+    const bool white = turn == Piece::WHITE;
+    const int16_t pawn = white ? en_passant - 8 : en_passant + 8;
+
+    return en_passant / 8 == (white ? 5 : 2) &&
+           squares[en_passant] == Piece::NONE &&
+           squares[pawn] == (white ? Piece::BLACK_PAWN : Piece::WHITE_PAWN);
+}
+}    // namespace
+
+Board::Board() : Board{start_position()} {}
+
+Board::Board(std::string_view fen) { load_fen(fen); }
+
+[[nodiscard]] const Board &Board::start_position() {
+    static const Board board{START_FEN};
+
+    return board;
+}
 
 std::ostream &operator<<(std::ostream &stream, const Board &board) {
     for (uint64_t i = 0; i < 64; i++) {
         stream << Piece::unicode_representation(board.m_squares[i]) << " ";
 
         if ((i + 1) % 8 == 0) {
-            stream << std::endl;
+            stream << '\n';
         }
     }
 
@@ -39,19 +230,30 @@ std::ostream &operator<<(std::ostream &stream, const Board &board) {
 }
 
 void Board::make_move(const Move &move) {
+    DREAMCHESS_STATS_SCOPE(BOARD_MAKE_MOVE);
+
+    m_attack_maps_valid.fill(false);
+
     // En-passant
     if (Piece::type(move.piece()) == Piece::PAWN &&
         (m_squares[move.destination()] == Piece::NONE &&
          move.source() % 8 != move.destination() % 8)) {
         uint16_t en_passant = move.destination() -
                               8 * (move.destination() > move.source() ? 1 : -1);
-        m_captured[m_squares[en_passant]]++;
+        if (m_squares[en_passant] != Piece::NONE) {
+            m_captured[captured_index(m_squares[en_passant])]++;
+            m_material_key -= material_unit(m_squares[en_passant]);
+        }
         m_squares[en_passant] = Piece::NONE;
     }
 
+    const bool irreversible = Piece::type(move.piece()) == Piece::PAWN ||
+                              m_squares[move.destination()] != Piece::NONE;
+
     // Updating captured pieces
     if (m_squares[move.destination()] != Piece::NONE) {
-        m_captured[m_squares[move.destination()]]++;
+        m_captured[captured_index(m_squares[move.destination()])]++;
+        m_material_key -= material_unit(m_squares[move.destination()]);
     }
 
     // kingside castle
@@ -71,6 +273,8 @@ void Board::make_move(const Move &move) {
     if (move_is_promotion(move)) {
         // Promotion
         m_squares[move.destination()] = move.promotion_piece();
+        m_material_key += material_unit(move.promotion_piece()) -
+                          material_unit(m_squares[move.source()]);
     } else {
         // The actual "common" move
         m_squares[move.destination()] = m_squares[move.source()];
@@ -78,9 +282,354 @@ void Board::make_move(const Move &move) {
 
     m_squares[move.source()] = Piece::NONE;
 
+    // Updating the position state
+    m_castling &= castling_mask(move.source()) &
+                  castling_mask(move.destination());
+
+    m_en_passant = NO_SQUARE;
+
+    if (Piece::type(move.piece()) == Piece::PAWN &&
+        std::abs(move.destination() - move.source()) == 16) {
+        m_en_passant =
+            static_cast<int16_t>((move.source() + move.destination()) / 2);
+    }
+
+    m_halfmove_clock = irreversible ? 0 : m_halfmove_clock + 1;
+
+    if (m_turn == Piece::BLACK) {
+        m_fullmove_number++;
+    }
+
+    m_turn = opponent_turn();
+}
+
+[[nodiscard]] Board::Undo Board::undo(const Move &move) const {
+    Undo result{m_squares[move.destination()], move.destination(),
+                m_castling, m_en_passant, m_halfmove_clock};
+
+    // En-passant, the captured pawn is behind the destination
+    if (Piece::type(move.piece()) == Piece::PAWN &&
+        (m_squares[move.destination()] == Piece::NONE &&
+         move.source() % 8 != move.destination() % 8)) {
+        result.m_captured_square = static_cast<int16_t>(
+            move.destination() -
+            8 * (move.destination() > move.source() ? 1 : -1));
+        result.m_captured = m_squares[result.m_captured_square];
+    }
+
+    if (result.m_captured == Piece::NONE) {
+        result.m_captured_square = NO_SQUARE;
+    }
+
+    return result;
+}
+
+void Board::unmake_move(const Move &move, const Undo &undo) {
+    m_attack_maps_valid.fill(false);
+    m_turn = opponent_turn();
+
+    if (m_turn == Piece::BLACK) {
+        m_fullmove_number--;
+    }
+
+    if (move_is_promotion(move)) {
+        m_material_key += material_unit(move.piece()) -
+                          material_unit(m_squares[move.destination()]);
+    }
+
+    m_squares[move.source()] = move_is_promotion(move)
+                                   ? move.piece()
+                                   : m_squares[move.destination()];
+    m_squares[move.destination()] = Piece::NONE;
+
+    // kingside castle
+    if (Piece::type(move.piece()) == Piece::KING &&
+        move.destination() - move.source() == 2) {
+        m_squares[move.destination() + 1] = m_squares[move.destination() - 1];
+        m_squares[move.destination() - 1] = Piece::NONE;
+    }
+
+    // Queenside castle
+    if (Piece::type(move.piece()) == Piece::KING &&
+        move.source() - move.destination() == 2) {
+        m_squares[move.destination() - 2] = m_squares[move.destination() + 1];
+        m_squares[move.destination() + 1] = Piece::NONE;
+    }
+
+    if (undo.m_captured != Piece::NONE) {
+        m_squares[undo.m_captured_square] = undo.m_captured;
+        m_captured[captured_index(undo.m_captured)]--;
+        m_material_key += material_unit(undo.m_captured);
+    }
+
+    m_castling = undo.m_castling;
+    m_en_passant = undo.m_en_passant;
+    m_halfmove_clock = undo.m_halfmove_clock;
+}
+
+void Board::make_null_move() {
+    // The squares don't change, neither do the attack maps
+    m_en_passant = NO_SQUARE;
+    m_halfmove_clock++;
+
+    if (m_turn == Piece::BLACK) {
+        m_fullmove_number++;
+    }
+
     m_turn = opponent_turn();
 }
 
+bool Board::load_fen(std::string_view fen) {
+    std::array<std::string, 6> splitted_fen{"", "", "", "", "0", "1"};
+    std::stringstream stream{std::string{fen}};
+
+    uint64_t fields = 0;
+
+    for (; fields < 6 && stream >> splitted_fen[fields]; fields++) {
+    }
+
+    if (fields < 4) {
+        return false;
+    }
+
+    piece_array_t squares{};
+    int16_t file = 0;
+    int16_t rank = 7;
+
+    for (const auto &sym : splitted_fen[0]) {
+        if (sym == '/') {
+            if (file != 8 || rank == 0) {
+                return false;
+            }
+
+            file = 0;
+            rank--;
+        } else if (isdigit(sym)) {
+            file += sym - '0';
+        } else {
+            if (file > 7 || std::string_view{"pnbrqkPNBRQK"}.find(sym) ==
+                                std::string_view::npos) {
+                return false;
+            }
+
+            squares[rank * 8 + file] = Piece::to_enum(sym);
+            file++;
+        }
+
+        if (file > 8) {
+            return false;
+        }
+    }
+
+    if (file != 8 || rank != 0) {
+        return false;
+    }
+
+    if (splitted_fen[1] != "w" && splitted_fen[1] != "b") {
+        return false;
+    }
+
+    uint8_t castling = NO_CASTLING;
+
+    for (const auto &sym : splitted_fen[2]) {
+        switch (sym) {
+            case 'K':
+                castling |= WHITE_KINGSIDE;
+                break;
+            case 'Q':
+                castling |= WHITE_QUEENSIDE;
+                break;
+            case 'k':
+                castling |= BLACK_KINGSIDE;
+                break;
+            case 'q':
+                castling |= BLACK_QUEENSIDE;
+                break;
+            case '-':
+                break;
+            default:
+                return false;
+        }
+    }
+
+    int16_t en_passant = NO_SQUARE;
+
+    if (splitted_fen[3] != "-") {
+        if (splitted_fen[3].size() != 2 || splitted_fen[3][0] < 'a' ||
+            splitted_fen[3][0] > 'h' ||
+            (splitted_fen[3][1] != '3' && splitted_fen[3][1] != '6')) {
+            return false;
+        }
+
+        en_passant = static_cast<int16_t>((splitted_fen[3][1] - '1') * 8 +
+                                          (splitted_fen[3][0] - 'a'));
+    }
+
+    const auto is_number = [](const std::string &field) {
+        return !field.empty() && field.size() < 5 &&
+               std::all_of(field.begin(), field.end(),
+                           [](char sym) { return isdigit(sym); });
+    };
+
+    if (!is_number(splitted_fen[4]) || !is_number(splitted_fen[5])) {
+        return false;
+    }
+
+    const piece_t turn = splitted_fen[1] == "w" ? Piece::WHITE : Piece::BLACK;
+
+    if (!is_valid_position(squares, turn, en_passant)) {
+        return false;
+    }
+
+    set_position(squares, turn, castling, en_passant,
+                 static_cast<uint16_t>(std::stoul(splitted_fen[4])),
+                 static_cast<uint16_t>(std::stoul(splitted_fen[5])));
+
+    return true;
+}
+
+[[nodiscard]] std::optional<Board::packed_t> Board::pack() const {
+    packed_t packed{};
+    uint64_t occupied = 0;
+    std::size_t nibble = 16;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const piece_t piece = m_squares[square];
+
+        if (piece == Piece::NONE) {
+            continue;
+        }
+
+        if (nibble == 48) {
+            return std::nullopt;
+        }
+
+        const auto code = static_cast<uint8_t>(
+            __builtin_ctz(Piece::type(piece)) + 1 +
+            (Piece::color(piece) == Piece::BLACK ? 8 : 0));
+
+        occupied |= 1ULL << square;
+        packed[nibble / 2] |= nibble % 2 == 0 ? code : code << 4;
+        nibble++;
+    }
+
+    for (std::size_t byte = 0; byte < 8; byte++) {
+        packed[byte] = static_cast<uint8_t>(occupied >> (byte * 8));
+    }
+
+    packed[24] = static_cast<uint8_t>((m_turn == Piece::BLACK ? 1 : 0) |
+                                      m_castling << 1);
+    packed[25] = static_cast<uint8_t>(m_en_passant);
+    packed[26] = static_cast<uint8_t>(m_halfmove_clock);
+    packed[27] = static_cast<uint8_t>(m_halfmove_clock >> 8);
+    packed[28] = static_cast<uint8_t>(m_fullmove_number);
+    packed[29] = static_cast<uint8_t>(m_fullmove_number >> 8);
+
+    return packed;
+}
+
+bool Board::unpack(const packed_t &packed) {
+    uint64_t occupied = 0;
+
+    for (std::size_t byte = 0; byte < 8; byte++) {
+        occupied |= static_cast<uint64_t>(packed[byte]) << (byte * 8);
+    }
+
+    if (__builtin_popcountll(occupied) > 32 || packed[24] >> 5 != 0 ||
+        (packed[25] != 0xFF && packed[25] > 63)) {
+        return false;
+    }
+
+    piece_array_t squares{};
+    std::size_t nibble = 16;
+
+    for (; occupied != 0; occupied &= occupied - 1, nibble++) {
+        const uint8_t code = nibble % 2 == 0 ? packed[nibble / 2] & 0x0F
+                                             : packed[nibble / 2] >> 4;
+        const uint8_t type = code & 7;
+
+        if (type == 0 || type > 6) {
+            return false;
+        }
+
+        squares[__builtin_ctzll(occupied)] =
+            static_cast<Piece::Enum>(1 << (type - 1)) |
+            (code & 8 ? Piece::BLACK : Piece::WHITE);
+    }
+
+    const piece_t turn = packed[24] & 1 ? Piece::BLACK : Piece::WHITE;
+    const int16_t en_passant =
+        packed[25] == 0xFF ? NO_SQUARE : static_cast<int16_t>(packed[25]);
+
+    if (!is_valid_position(squares, turn, en_passant)) {
+        return false;
+    }
+
+    set_position(squares, turn, static_cast<uint8_t>(packed[24] >> 1),
+                 en_passant,
+                 static_cast<uint16_t>(packed[26] | packed[27] << 8),
+                 static_cast<uint16_t>(packed[28] | packed[29] << 8));
+
+    return true;
+}
+
+[[nodiscard]] std::string Board::fen() const {
+    std::string fen;
+
+    for (int16_t rank = 7; rank >= 0; rank--) {
+        uint16_t empty = 0;
+
+        for (int16_t file = 0; file < 8; file++) {
+            const piece_t piece = m_squares[rank * 8 + file];
+
+            if (piece == Piece::NONE) {
+                empty++;
+                continue;
+            }
+
+            if (empty != 0) {
+                fen.push_back(static_cast<char>('0' + empty));
+                empty = 0;
+            }
+
+            fen.push_back(Piece::to_fen(piece));
+        }
+
+        if (empty != 0) {
+            fen.push_back(static_cast<char>('0' + empty));
+        }
+
+        if (rank != 0) {
+            fen.push_back('/');
+        }
+    }
+
+    fen.append(m_turn == Piece::WHITE ? " w " : " b ");
+
+    if (m_castling == NO_CASTLING) {
+        fen.push_back('-');
+    } else {
+        if (m_castling & WHITE_KINGSIDE) fen.push_back('K');
+        if (m_castling & WHITE_QUEENSIDE) fen.push_back('Q');
+        if (m_castling & BLACK_KINGSIDE) fen.push_back('k');
+        if (m_castling & BLACK_QUEENSIDE) fen.push_back('q');
+    }
+
+    fen.push_back(' ');
+
+    if (m_en_passant == NO_SQUARE) {
+        fen.push_back('-');
+    } else {
+        fen.push_back(static_cast<char>('a' + m_en_passant % 8));
+        fen.push_back(static_cast<char>('1' + m_en_passant / 8));
+    }
+
+    fen.append(" " + std::to_string(m_halfmove_clock) + " " +
+               std::to_string(m_fullmove_number));
+
+    return fen;
+}
+
 [[nodiscard]] bool Board::is_in_game() const { return is_king_dead(); }
 
 [[nodiscard]] bool Board::is_in_check() const {
@@ -112,54 +661,149 @@ void Board::make_move(const Move &move) {
     return m_squares[index];
 }
 
-[[nodiscard]] bool Board::square_attacked(uint64_t index,
-                                          Board::piece_t turn) const {
-    for (uint64_t i = 0; i < 64; i++) {
-        if (Piece::color(m_squares[i]) == turn) {
-            Move move{static_cast<int64_t>(i), static_cast<int64_t>(index),
-                      m_squares[i], Piece::NONE};
+[[nodiscard]] uint8_t Board::castling_rights() const { return m_castling; }
+
+[[nodiscard]] int16_t Board::en_passant() const { return m_en_passant; }
 
-            if (move_is_semi_valid(move)) {
-                return true;
+[[nodiscard]] uint16_t Board::halfmove_clock() const {
+    return m_halfmove_clock;
+}
+
+[[nodiscard]] uint16_t Board::fullmove_number() const {
+    return m_fullmove_number;
+}
+
+[[nodiscard]] uint64_t Board::material_key() const { return m_material_key; }
+
+[[nodiscard]] uint16_t Board::material_count(uint64_t key, piece_t piece) {
+    if (piece == Piece::NONE) {
+        return 0;
+    }
+
+    return static_cast<uint16_t>(
+        (key >> (MATERIAL_BITS * captured_index(piece))) &
+        ((uint64_t{1} << MATERIAL_BITS) - 1));
+}
+
+[[nodiscard]] const Board::AttackMap &Board::attack_map(
+    piece_t color) const {
+    const std::size_t side = color == Piece::WHITE ? 0 : 1;
+    AttackMap &map = m_attack_maps[side];
+
+    if (m_attack_maps_valid[side]) {
+        return map;
+    }
+
+    DREAMCHESS_STATS_SCOPE(BOARD_ATTACK_MAP);
+
+    map = AttackMap{};
+
+    uint64_t occupied = 0;
+    uint64_t pawns = 0;
+
+    for (int16_t square = 0; square < 64; square++) {
+        if (m_squares[square] != Piece::NONE) {
+            occupied |= uint64_t{1} << square;
+        }
+
+        if (m_squares[square] == (Piece::PAWN | color)) {
+            pawns |= uint64_t{1} << square;
+        }
+    }
+
+    // All the pawns at once, a shift per capturing direction
+    if (color == Piece::WHITE) {
+        add_attacks((pawns & ~FILE_A) << 7, map);
+        add_attacks((pawns & ~FILE_H) << 9, map);
+    } else {
+        add_attacks((pawns & ~FILE_A) >> 9, map);
+        add_attacks((pawns & ~FILE_H) >> 7, map);
+    }
+
+    for (int16_t square = 0; square < 64; square++) {
+        const piece_t piece = m_squares[square];
+
+        if (Piece::color(piece) != color) {
+            continue;
+        }
+
+        const Piece::Enum type = Piece::type(piece);
+
+        if (type == Piece::KNIGHT) {
+            add_attacks(KNIGHT_ATTACKS[square], map);
+        } else if (type == Piece::KING) {
+            add_attacks(KING_ATTACKS[square], map);
+        } else {
+            const Piece::Traits &traits = Piece::traits(piece);
+
+            // Odd steps of KING_STEPS are diagonal
+            for (std::size_t line = 0; line < 8; line++) {
+                if (line % 2 == 1 ? traits.m_diagonal_slider
+                                  : traits.m_orthogonal_slider) {
+                    add_attacks(ray(square, KING_STEPS[line], occupied), map);
+                }
             }
         }
     }
 
-    return false;
+    m_attack_maps_valid[side] = true;
+
+    return map;
+}
+
+[[nodiscard]] bool Board::square_attacked(uint64_t index,
+                                          Board::piece_t turn) const {
+    DREAMCHESS_STATS_SCOPE(BOARD_SQUARE_ATTACKED);
+
+    return (attack_map(turn).m_attacked >> index & 1) != 0;
 }
 
 [[nodiscard]] bool Board::move_is_valid(const Move &move) const {
+    DREAMCHESS_STATS_SCOPE(BOARD_MOVE_IS_VALID);
+
     if (!move_is_semi_valid(move)) {
         return false;
     }
 
-    return !is_in_check();
+    // The interactive Game lets a KING be captured, a Move may leave it
+    // attacked but a side without one has lost
+    return is_in_game();
 }
 
 [[nodiscard]] bool Board::move_is_semi_valid(const Move &move) const {
-    if (move.source() > 63 || move.destination() > 63 ||
-        move.source() == move.destination() ||
-        m_squares[move.source()] == Piece::NONE ||
-        Piece::color(m_squares[move.source()]) != m_turn ||
-        Piece::color(m_squares[move.source()]) ==
-            Piece::color(m_squares[move.destination()])) {
+    // Dispatched once, the specialized code never tests the color again
+    return m_turn == Piece::WHITE ? move_is_semi_valid_for<Piece::WHITE>(move)
+                                  : move_is_semi_valid_for<Piece::BLACK>(move);
+}
+
+template <Board::piece_t US>
+[[nodiscard]] bool Board::move_is_semi_valid_for(const Move &move) const {
+    constexpr piece_t THEM = US == Piece::WHITE ? Piece::BLACK : Piece::WHITE;
+    constexpr int16_t KING_SQUARE = US == Piece::WHITE ? 4 : 60;
+
+    // First square of the pawns' double step and en-passant ranges
+    constexpr int16_t DOUBLE_STEP_RANK = US == Piece::WHITE ? 8 : 48;
+    constexpr int16_t EN_PASSANT_RANK = US == Piece::WHITE ? 32 : 24;
+
+    const int16_t source = move.source();
+    const int16_t destination = move.destination();
+
+    if (source > 63 || destination > 63 || source == destination ||
+        Piece::color(m_squares[source]) != US ||
+        Piece::color(m_squares[destination]) == US) {
         return false;
     }
 
     int64_t hor = horizontal_check(move);
     int64_t ver = vertical_check(move);
 
-    switch (Piece::type(m_squares[move.source()])) {
+    switch (Piece::type(m_squares[source])) {
         case Piece::KNIGHT: {
             if (((hor != 1) && (hor != 2)) || ((hor == 1) && (ver != 2)) ||
                 ((hor == 2) && (ver != 1))) {
                 return false;
             }
 
-            if (m_squares[move.destination()] == Piece::NONE) {
-                break;
-            }
-
             break;
         }
 
@@ -188,13 +832,8 @@ void Board::make_move(const Move &move) {
         }
 
         case Piece::PAWN: {
-            if ((move.destination() > move.source()) &&
-                (Piece::color(m_squares[move.source()]) == Piece::BLACK)) {
-                return false;
-            }
-
-            if ((move.destination() < move.source()) &&
-                (Piece::color(m_squares[move.source()]) == Piece::WHITE)) {
+            if (US == Piece::WHITE ? destination < source
+                                   : destination > source) {
                 return false;
             }
 
@@ -206,14 +845,13 @@ void Board::make_move(const Move &move) {
                 if (ver > 2) {
                     return false;
                 }
-                if ((ver == 2) && !(static_cast<unsigned>(move.source() - 8) <=
-                                        static_cast<unsigned>(15 - 8) ||
-                                    static_cast<unsigned>(move.source() - 48) <=
-                                        static_cast<unsigned>(55 - 48))) {
+
+                if (ver == 2 &&
+                    static_cast<unsigned>(source - DOUBLE_STEP_RANK) > 7U) {
                     return false;
                 }
 
-                if (m_squares[move.destination()] != Piece::NONE) {
+                if (m_squares[destination] != Piece::NONE) {
                     return false;
                 }
             } else {
@@ -221,29 +859,15 @@ void Board::make_move(const Move &move) {
                     return false;
                 }
 
-                if (m_squares[move.destination()] == Piece::NONE) {
-                    if ((Piece::color(m_squares[move.source()]) ==
-                         Piece::WHITE) &&
-                        static_cast<unsigned>(move.source() - 32) >
-                            static_cast<unsigned>(40 - 32)) {
-                        return false;
-                    }
-
-                    if ((Piece::color(m_squares[move.source()]) ==
-                         Piece::BLACK) &&
-                        static_cast<unsigned>(move.source() - 24) >
-                            static_cast<unsigned>(32 - 24)) {
+                if (m_squares[destination] == Piece::NONE) {
+                    if (static_cast<unsigned>(source - EN_PASSANT_RANK) > 8U) {
                         return false;
                     }
 
-                    const int16_t offset =
-                        Piece::color(m_squares[move.source()]) == Piece::WHITE
-                            ? -8
-                            : 8;
+                    constexpr int16_t BEHIND = US == Piece::WHITE ? -8 : 8;
 
-                    if (m_squares[move.destination() + offset] !=
-                        (Piece::PAWN | Piece::opposite_side_color(
-                                           m_squares[move.source()]))) {
+                    if (m_squares[destination + BEHIND] !=
+                        (Piece::PAWN | THEM)) {
                         return false;
                     }
                 }
@@ -256,47 +880,23 @@ void Board::make_move(const Move &move) {
             if (hor > 2) {
                 return false;
             } else if (hor == 2) {
-                bool white =
-                    Piece::color(m_squares[move.source()]) == Piece::WHITE;
-
-                const int16_t step = move.destination() > move.source() ? 1
-                                                                        : -1;
-
-                uint16_t rook;
-
-                if (step == 1) {
-                    rook = white ? 7 : 63;
-                } else {
-                    rook = white ? 0 : 56;
-                }
-
-                if (ver != 0) {
-                    return false;
-                }
-
-                if (move.source() != (white ? 4 : 60)) {
-                    return false;
-                }
+                const int16_t step = destination > source ? 1 : -1;
+                const int16_t rook =
+                    step == 1 ? KING_SQUARE + 3 : KING_SQUARE - 4;
 
-                if (m_squares[rook] != (Piece::ROOK | m_turn)) {
+                if (ver != 0 || source != KING_SQUARE ||
+                    m_squares[rook] != (Piece::ROOK | US)) {
                     return false;
                 }
 
-                int32_t i = move.source() + step;
-
-                while (i != rook) {
+                for (int16_t i = source + step; i != rook; i += step) {
                     if (m_squares[i] != Piece::NONE) {
                         return false;
                     }
-
-                    i += step;
-                }
-
-                if (square_attacked(move.source(), opponent_turn())) {
-                    return false;
                 }
 
-                if (square_attacked(move.source() + step, opponent_turn())) {
+                if (square_attacked(source, THEM) ||
+                    square_attacked(source + step, THEM)) {
                     return false;
                 }
             } else {
@@ -327,37 +927,31 @@ void Board::make_move(const Move &move) {
     return m_squares.end();
 }
 
-void Board::init_board() {
-    uint16_t file = 0;
-    uint16_t rank = 7;
-
-    std::array<std::string, 6> splitted_fen;
-    std::stringstream stream{
-        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"};
-
-    std::string tmp;
-
-    for (uint64_t i = 0; i < 6; i++) {
-        std::getline(stream, tmp, ' ');
-        splitted_fen[i] = tmp;
-    }
-
-    for (const auto &sym : splitted_fen[0]) {
-        if (sym == '/') {
-            file = 0;
-            rank--;
-        } else {
-            if (isdigit(sym)) {
-                file += sym - '0';
-            } else {
-                m_squares[rank * 8 + file] = Piece::to_enum(sym);
-                file++;
-            }
-        }
+void Board::set_position(const piece_array_t &squares, piece_t turn,
+                         uint8_t castling, int16_t en_passant,
+                         uint16_t halfmove_clock, uint16_t fullmove_number) {
+    m_squares = squares;
+    m_attack_maps_valid.fill(false);
+    m_turn = turn;
+    m_castling = castling;
+    m_en_passant = en_passant;
+    m_halfmove_clock = halfmove_clock;
+    m_fullmove_number = std::max<uint16_t>(1, fullmove_number);
+    m_captured.fill(0);
+    m_material_key = 0;
+
+    for (const auto piece : m_squares) {
+        m_material_key += material_unit(piece);
     }
 }
 
-void Board::clear() { m_squares.fill(Piece::NONE); }
+void Board::init_board() { *this = start_position(); }
+
+void Board::clear() {
+    m_squares.fill(Piece::NONE);
+    m_attack_maps_valid.fill(false);
+    m_material_key = 0;
+}
 
 [[nodiscard]] int64_t Board::horizontal_check(const Move &move) const {
     return std::abs(move.source() % 8 - move.destination() % 8);
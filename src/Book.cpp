@@ -0,0 +1,165 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Book.hpp"
+
+#include <cstdlib>
+
+#include "MoveGenerator.hpp"
+#include "Zobrist.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Reads a big-endian unsigned integer of N bytes
+ */
+template <std::size_t N>
+uint64_t read_big_endian(const uint8_t *bytes) {
+    uint64_t value = 0;
+
+    for (std::size_t i = 0; i < N; i++) {
+        value = (value << 8) | bytes[i];
+    }
+
+    return value;
+}
+
+/**
+ * @brief Polyglot promotion codes: none, knight, bishop, rook, queen
+ */
+uint16_t promotion_code(Board::piece_t piece) {
+    switch (Piece::type(piece)) {
+        case Piece::KNIGHT:
+            return 1;
+        case Piece::BISHOP:
+            return 2;
+        case Piece::ROOK:
+            return 3;
+        case Piece::QUEEN:
+            return 4;
+        default:
+            return 0;
+    }
+}
+}    // namespace
+
+bool Book::open(const std::string &path) {
+    if (!m_file.open(path) || m_file.size() % ENTRY_SIZE != 0) {
+        m_file.close();
+        return false;
+    }
+
+    return true;
+}
+
+void Book::close() { m_file.close(); }
+
+[[nodiscard]] bool Book::is_open() const { return m_file.is_open(); }
+
+[[nodiscard]] std::size_t Book::size() const {
+    return m_file.size() / ENTRY_SIZE;
+}
+
+std::size_t Book::probe(const Board &board, entry_list_t &entries) const {
+    const uint64_t key = Zobrist::key(board);
+
+    // Lower bound of the key
+    std::size_t first = 0;
+    std::size_t last = size();
+
+    while (first < last) {
+        const std::size_t middle = first + (last - first) / 2;
+
+        if (key_at(middle) < key) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    MoveList legal;
+    MoveGenerator::legal(board, legal);
+
+    std::size_t found = 0;
+
+    for (std::size_t i = first;
+         i < size() && found < MAX_ENTRIES && key_at(i) == key; i++) {
+        const uint8_t *entry = m_file.data() + i * ENTRY_SIZE;
+        const auto code = static_cast<uint16_t>(read_big_endian<2>(entry + 8));
+        const auto weight =
+            static_cast<uint16_t>(read_big_endian<2>(entry + 10));
+
+        // Matching against the legal Moves also filters key collisions
+        for (const auto &move : legal) {
+            if (encode(move) == code) {
+                entries[found++] = Entry{move, weight};
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+[[nodiscard]] std::optional<Move> Book::pick(const Board &board,
+                                             uint64_t random) const {
+    entry_list_t entries;
+    const std::size_t found = probe(board, entries);
+
+    uint64_t total = 0;
+
+    for (std::size_t i = 0; i < found; i++) {
+        total += entries[i].m_weight;
+    }
+
+    if (found == 0) {
+        return std::nullopt;
+    }
+
+    if (total == 0) {
+        return entries[random % found].m_move;
+    }
+
+    uint64_t target = random % total;
+
+    for (std::size_t i = 0; i < found; i++) {
+        if (target < entries[i].m_weight) {
+            return entries[i].m_move;
+        }
+
+        target -= entries[i].m_weight;
+    }
+
+    return entries[found - 1].m_move;
+}
+
+[[nodiscard]] uint16_t Book::encode(const Move &move) {
+    int16_t destination = move.destination();
+
+    // Castling: e1g1 is stored as e1h1, e1c1 as e1a1
+    if (Piece::type(move.piece()) == Piece::KING &&
+        std::abs(destination - move.source()) == 2) {
+        destination = destination > move.source() ? destination + 1
+                                                   : destination - 2;
+    }
+
+    return static_cast<uint16_t>(
+        (destination % 8) | ((destination / 8) << 3) |
+        ((move.source() % 8) << 6) | ((move.source() / 8) << 9) |
+        (promotion_code(move.promotion_piece()) << 12));
+}
+
+[[nodiscard]] uint64_t Book::key_at(std::size_t index) const {
+    return read_big_endian<8>(m_file.data() + index * ENTRY_SIZE);
+}
+}    // namespace dreamchess
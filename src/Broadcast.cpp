@@ -0,0 +1,170 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Broadcast.hpp"
+
+#include <cstring>
+#include <thread>
+
+#include "Piece.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Packs a Move in 24 bits: source, destination, promotion type as the
+ * index of its bit, kind, then the moving Piece
+ */
+uint32_t encode(const Move &move) {
+    const auto promotion = Piece::type(move.promotion_piece());
+    const uint32_t index =
+        promotion == Piece::NONE ? 0 : __builtin_ctz(promotion);
+
+    return static_cast<uint32_t>(move.source()) |
+           static_cast<uint32_t>(move.destination()) << 6 | index << 12 |
+           static_cast<uint32_t>(move.piece()) << 16;
+}
+
+Broadcast::Event decode(uint64_t sequence, uint32_t code) {
+    const uint32_t index = code >> 12 & 7;
+    const auto piece = static_cast<Piece::Enum>(code >> 16 & 0xFF);
+    const auto promotion =
+        index == 0 ? Piece::NONE
+                   : static_cast<Piece::Enum>(1 << index) | Piece::color(piece);
+
+    return {sequence, static_cast<Broadcast::Event::Kind>(code >> 15 & 1),
+            Move{code & 63, code >> 6 & 63, piece, promotion}};
+}
+
+std::size_t round_up(std::size_t capacity) {
+    std::size_t result = 1;
+
+    while (result < capacity) {
+        result <<= 1;
+    }
+
+    return result;
+}
+}    // namespace
+
+Broadcast::Broadcast(std::size_t capacity)
+    : m_mask{round_up(capacity) - 1},
+      m_ring{std::make_unique<std::atomic<uint64_t>[]>(m_mask + 1)} {
+    // No slot matches index 0 before it's written
+    m_ring[0].store(uint64_t{1} << 32, std::memory_order_relaxed);
+}
+
+void Broadcast::publish_move(const Move &move, const Board &board) {
+    publish(encode(move), board);
+}
+
+void Broadcast::publish_reset(const Board &board) {
+    publish(uint32_t{Event::RESET} << 15, board);
+}
+
+[[nodiscard]] std::optional<Broadcast::Snapshot> Broadcast::snapshot() const {
+    std::array<uint64_t, SNAPSHOT_WORDS> words{};
+
+    for (;;) {
+        const uint64_t version = m_version.load(std::memory_order_acquire);
+
+        if (version == 0) {
+            return std::nullopt;
+        }
+
+        if (version % 2 == 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (std::size_t i = 0; i < SNAPSHOT_WORDS; i++) {
+            words[i] = m_snapshot[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (m_version.load(std::memory_order_relaxed) == version) {
+            break;
+        }
+    }
+
+    Snapshot result{};
+    std::memcpy(result.m_board.data(), words.data(), result.m_board.size());
+    result.m_sequence = words[SNAPSHOT_WORDS - 1];
+
+    return result;
+}
+
+[[nodiscard]] Broadcast::Cursor Broadcast::subscribe() const {
+    return Cursor{m_head.load(std::memory_order_acquire), 0};
+}
+
+[[nodiscard]] std::optional<Broadcast::Event> Broadcast::poll(
+    Cursor &cursor) const {
+    for (;;) {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+
+        if (cursor.m_next >= head) {
+            return std::nullopt;
+        }
+
+        if (head - cursor.m_next > capacity()) {
+            cursor.m_lost += head - capacity() - cursor.m_next;
+            cursor.m_next = head - capacity();
+        }
+
+        const uint64_t slot =
+            m_ring[cursor.m_next & m_mask].load(std::memory_order_acquire);
+
+        // Overwritten since head was read, the reader has been lapped
+        if (slot >> 32 != (cursor.m_next & 0xFFFFFFFF)) {
+            continue;
+        }
+
+        const uint64_t sequence = cursor.m_next++;
+
+        return decode(sequence, static_cast<uint32_t>(slot));
+    }
+}
+
+[[nodiscard]] std::size_t Broadcast::capacity() const { return m_mask + 1; }
+
+void Broadcast::publish(uint32_t code, const Board &board) {
+    const uint64_t sequence = m_head.load(std::memory_order_relaxed);
+
+    m_ring[sequence & m_mask].store((sequence & 0xFFFFFFFF) << 32 | code,
+                                    std::memory_order_release);
+    m_head.store(sequence + 1, std::memory_order_release);
+
+    const std::optional<Board::packed_t> packed = board.pack();
+
+    // A position which can't be packed keeps the previous one, its sequence
+    // tells the readers it's stale
+    if (!packed) {
+        return;
+    }
+
+    std::array<uint64_t, SNAPSHOT_WORDS> words{};
+    std::memcpy(words.data(), packed->data(), packed->size());
+    words[SNAPSHOT_WORDS - 1] = sequence + 1;
+
+    const uint64_t version = m_version.load(std::memory_order_relaxed);
+    m_version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < SNAPSHOT_WORDS; i++) {
+        m_snapshot[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    m_version.store(version + 2, std::memory_order_release);
+}
+}    // namespace dreamchess
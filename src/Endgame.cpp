@@ -0,0 +1,186 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Endgame.hpp"
+
+#include <array>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief The material of a side, king excluded
+ */
+struct Side final {
+    uint16_t m_pawns;
+    uint16_t m_knights;
+    uint16_t m_bishops;
+    uint16_t m_rooks;
+    uint16_t m_queens;
+};
+
+/**
+ * @brief Decodes a side index of the table
+ */
+constexpr Side side(uint16_t index) {
+    return {static_cast<uint16_t>(index % 2),
+            static_cast<uint16_t>(index / 2 % 3),
+            static_cast<uint16_t>(index / 6 % 3),
+            static_cast<uint16_t>(index / 18 % 2),
+            static_cast<uint16_t>(index / 36)};
+}
+
+/**
+ * @brief Classifies the material of a side against a bare king
+ */
+constexpr Endgame::Class against_bare_king(const Side &strong) {
+    const uint16_t minors = strong.m_knights + strong.m_bishops;
+
+    if (strong.m_pawns == 0 && strong.m_rooks == 0 && strong.m_queens == 0) {
+        if (minors <= 1) {
+            return Endgame::INSUFFICIENT_MATERIAL;
+        }
+
+        if (strong.m_knights == 2 && strong.m_bishops == 0) {
+            return Endgame::KNNK;
+        }
+
+        if (strong.m_knights == 1 && strong.m_bishops == 1) {
+            return Endgame::KBNK;
+        }
+
+        return strong.m_knights == 0 ? Endgame::KXK : Endgame::GENERIC;
+    }
+
+    if (strong.m_pawns == 1 && minors == 0 && strong.m_rooks == 0 &&
+        strong.m_queens == 0) {
+        return Endgame::KPK;
+    }
+
+    return strong.m_pawns == 0 ? Endgame::KXK : Endgame::GENERIC;
+}
+
+/**
+ * @brief Classifies the material of both sides
+ */
+constexpr Endgame::Class classify_sides(const Side &white, const Side &black) {
+    const auto is_bare = [](const Side &material) {
+        return material.m_pawns + material.m_knights + material.m_bishops +
+                   material.m_rooks + material.m_queens ==
+               0;
+    };
+    const auto is_lone_bishop = [](const Side &material) {
+        return material.m_bishops == 1 &&
+               material.m_pawns + material.m_knights + material.m_rooks +
+                       material.m_queens ==
+                   0;
+    };
+
+    if (is_bare(black)) {
+        return against_bare_king(white);
+    }
+
+    if (is_bare(white)) {
+        return against_bare_king(black);
+    }
+
+    return is_lone_bishop(white) && is_lone_bishop(black)
+               ? Endgame::BISHOPS_ONLY
+               : Endgame::GENERIC;
+}
+
+/**
+ * @typedef Defines the class_table_t type, indexed by WHITE's material times
+ * SIDE_MATERIALS plus BLACK's
+ */
+using class_table_t = std::array<Endgame::Class, Endgame::SIDE_MATERIALS *
+                                                     Endgame::SIDE_MATERIALS>;
+
+constexpr class_table_t make_table() {
+    class_table_t table{};
+
+    for (uint16_t white = 0; white < Endgame::SIDE_MATERIALS; white++) {
+        for (uint16_t black = 0; black < Endgame::SIDE_MATERIALS; black++) {
+            table[white * Endgame::SIDE_MATERIALS + black] =
+                classify_sides(side(white), side(black));
+        }
+    }
+
+    return table;
+}
+
+constexpr class_table_t CLASSES = make_table();
+
+static_assert(CLASSES[0] == Endgame::INSUFFICIENT_MATERIAL, "KK");
+static_assert(CLASSES[1 * Endgame::SIDE_MATERIALS] == Endgame::KPK, "KPK");
+static_assert(CLASSES[18] == Endgame::KXK, "KKR");
+
+/**
+ * @brief Encodes the material of a side as a table index
+ * @return The index, or SIDE_MATERIALS if the material is not in the table
+ */
+uint16_t side_index(uint64_t key, Piece::Enum color) {
+    const auto count = [key, color](Piece::Enum type) {
+        return Board::material_count(key, color | type);
+    };
+
+    const uint16_t pawns = count(Piece::PAWN);
+    const uint16_t knights = count(Piece::KNIGHT);
+    const uint16_t bishops = count(Piece::BISHOP);
+    const uint16_t rooks = count(Piece::ROOK);
+    const uint16_t queens = count(Piece::QUEEN);
+
+    if (count(Piece::KING) != 1 || pawns > 1 || knights > 2 || bishops > 2 ||
+        rooks > 1 || queens > 1) {
+        return Endgame::SIDE_MATERIALS;
+    }
+
+    return pawns + 2 * (knights + 3 * (bishops + 3 * (rooks + 2 * queens)));
+}
+}    // namespace
+
+[[nodiscard]] Endgame::Class Endgame::classify(uint64_t key) {
+    const uint16_t white = side_index(key, Piece::WHITE);
+    const uint16_t black = side_index(key, Piece::BLACK);
+
+    if (white == SIDE_MATERIALS || black == SIDE_MATERIALS) {
+        return GENERIC;
+    }
+
+    return CLASSES[white * SIDE_MATERIALS + black];
+}
+
+[[nodiscard]] Endgame::Class Endgame::classify(const Board &board) {
+    return classify(board.material_key());
+}
+
+[[nodiscard]] bool Endgame::is_dead_draw(const Board &board) {
+    switch (classify(board)) {
+        case INSUFFICIENT_MATERIAL:
+            return true;
+        case BISHOPS_ONLY: {
+            // Rare enough to afford a scan, the bishops' square colors
+            uint16_t colors = 0;
+
+            for (uint16_t square = 0; square < 64; square++) {
+                if (Piece::type(board.piece_at(square)) == Piece::BISHOP) {
+                    colors |= 1 << ((square / 8 + square % 8) % 2);
+                }
+            }
+
+            return colors != 3;
+        }
+        default:
+            return false;
+    }
+}
+}    // namespace dreamchess
@@ -0,0 +1,223 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Evaluation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Endgame.hpp"
+#include "Kpk.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @typedef Defines the square_table_t type, bonuses seen from WHITE with a1
+ * at index 0
+ */
+using square_table_t = std::array<int16_t, 64>;
+
+constexpr square_table_t PAWN_TABLE{
+      0,   0,   0,   0,   0,   0,   0,   0,
+      5,  10,  10, -20, -20,  10,  10,   5,
+      5,  -5, -10,   0,   0, -10,  -5,   5,
+      0,   0,   0,  20,  20,   0,   0,   0,
+      5,   5,  10,  25,  25,  10,   5,   5,
+     10,  10,  20,  30,  30,  20,  10,  10,
+     50,  50,  50,  50,  50,  50,  50,  50,
+       0,    0,    0,    0,    0,    0,    0,    0};
+
+constexpr square_table_t KNIGHT_TABLE{
+    -50, -40, -30, -30, -30, -30, -40, -50,
+    -40, -20,   0,   5,   5,   0, -20, -40,
+    -30,   5,  10,  15,  15,  10,   5, -30,
+    -30,   0,  15,  20,  20,  15,   0, -30,
+    -30,   5,  15,  20,  20,  15,   5, -30,
+    -30,   0,  10,  15,  15,  10,   0, -30,
+    -40, -20,   0,   0,   0,   0, -20, -40,
+     -50,  -40,  -30,  -30,  -30,  -30,  -40,  -50};
+
+constexpr square_table_t BISHOP_TABLE{
+    -20, -10, -10, -10, -10, -10, -10, -20,
+    -10,   5,   0,   0,   0,   0,   5, -10,
+    -10,  10,  10,  10,  10,  10,  10, -10,
+    -10,   0,  10,  10,  10,  10,   0, -10,
+    -10,   5,   5,  10,  10,   5,   5, -10,
+    -10,   0,   5,  10,  10,   5,   0, -10,
+    -10,   0,   0,   0,   0,   0,   0, -10,
+     -20,  -10,  -10,  -10,  -10,  -10,  -10,  -20};
+
+constexpr square_table_t ROOK_TABLE{
+      0,   0,   0,   5,   5,   0,   0,   0,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+     -5,   0,   0,   0,   0,   0,   0,  -5,
+      5,  10,  10,  10,  10,  10,  10,   5,
+       0,    0,    0,    0,    0,    0,    0,    0};
+
+constexpr square_table_t KING_TABLE{
+     20,  30,  10,   0,   0,  10,  30,  20,
+     20,  20,   0,   0,   0,   0,  20,  20,
+    -10, -20, -20, -20, -20, -20, -20, -10,
+    -20, -30, -30, -40, -40, -30, -30, -20,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+    -30, -40, -40, -50, -50, -40, -40, -30,
+     -30,  -40,  -40,  -50,  -50,  -40,  -40,  -30};
+
+int32_t square_bonus(Board::piece_t piece, uint16_t square) {
+    // Tables are written for WHITE, BLACK reads them upside down
+    const uint16_t index =
+        Piece::color(piece) == Piece::WHITE ? square : square ^ 56;
+
+    switch (Piece::type(piece)) {
+        case Piece::PAWN:
+            return PAWN_TABLE[index];
+        case Piece::KNIGHT:
+            return KNIGHT_TABLE[index];
+        case Piece::BISHOP:
+            return BISHOP_TABLE[index];
+        case Piece::ROOK:
+            return ROOK_TABLE[index];
+        case Piece::KING:
+            return KING_TABLE[index];
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Distance between two squares in king moves
+ */
+int32_t king_distance(uint16_t lhs, uint16_t rhs) {
+    return std::max(std::abs(lhs % 8 - rhs % 8), std::abs(lhs / 8 - rhs / 8));
+}
+
+/**
+ * @brief Evaluates a won endgame against a bare king
+ * @details The bare king is driven to an edge, or to a corner of the
+ * bishop's color in KBNK, and the winning king comes closer
+ */
+int32_t mop_up(const Board &board, Endgame::Class endgame) {
+    std::array<uint16_t, 2> kings{};
+    Piece::Enum strong = Piece::WHITE;
+    int32_t material = 0;
+    uint16_t bishop_color = 0;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Board::piece_t piece = board.piece_at(square);
+
+        if (Piece::type(piece) == Piece::KING) {
+            kings[Piece::color(piece) == Piece::WHITE ? 0 : 1] = square;
+        } else if (piece != Piece::NONE) {
+            strong = Piece::color(piece);
+            material += Evaluation::piece_value(piece);
+
+            if (Piece::type(piece) == Piece::BISHOP) {
+                bishop_color = (square / 8 + square % 8) % 2;
+            }
+        }
+    }
+
+    const uint16_t strong_king = kings[strong == Piece::WHITE ? 0 : 1];
+    const uint16_t weak_king = kings[strong == Piece::WHITE ? 1 : 0];
+
+    int32_t cornered = 0;
+
+    if (endgame == Endgame::KBNK) {
+        // a1 and h8 are dark, a8 and h1 light
+        const auto corner_distance = [weak_king](uint16_t lhs, uint16_t rhs) {
+            return std::min(king_distance(weak_king, lhs),
+                            king_distance(weak_king, rhs));
+        };
+
+        cornered = 7 - (bishop_color == 0 ? corner_distance(0, 63)
+                                          : corner_distance(7, 56));
+    } else {
+        cornered = std::max(3 - weak_king % 8, weak_king % 8 - 4) +
+                   std::max(3 - weak_king / 8, weak_king / 8 - 4);
+    }
+
+    const int32_t score = Evaluation::KNOWN_WIN + material + 20 * cornered +
+                          10 * (7 - king_distance(strong_king, weak_king));
+
+    return board.turn() == strong ? score : -score;
+}
+
+/**
+ * @brief Evaluates KPK through the bitbase
+ */
+int32_t pawn_ending(const Board &board) {
+    const std::optional<bool> won = Kpk::probe(board);
+
+    if (!won || !*won) {
+        return 0;
+    }
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Board::piece_t piece = board.piece_at(square);
+
+        if (Piece::type(piece) == Piece::PAWN) {
+            const int32_t rank = Piece::color(piece) == Piece::WHITE
+                                     ? square / 8
+                                     : 7 - square / 8;
+            const int32_t score = Evaluation::KNOWN_WIN +
+                                  Evaluation::piece_value(piece) + 10 * rank;
+
+            return board.turn() == Piece::color(piece) ? score : -score;
+        }
+    }
+
+    return 0;
+}
+}    // namespace
+
+[[nodiscard]] int32_t Evaluation::evaluate(const Board &board) {
+    // Known endgames first, found in O(1) through the material key
+    switch (const Endgame::Class endgame = Endgame::classify(board)) {
+        case Endgame::INSUFFICIENT_MATERIAL:
+        case Endgame::BISHOPS_ONLY:
+        case Endgame::KNNK:
+            return 0;
+        case Endgame::KPK:
+            return pawn_ending(board);
+        case Endgame::KBNK:
+        case Endgame::KXK:
+            return mop_up(board, endgame);
+        default:
+            break;
+    }
+
+    int32_t score = 0;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Board::piece_t piece = board.piece_at(square);
+
+        if (piece == Piece::NONE) {
+            continue;
+        }
+
+        const int32_t value = piece_value(piece) + square_bonus(piece, square);
+
+        score += Piece::color(piece) == Piece::WHITE ? value : -value;
+    }
+
+    return board.turn() == Piece::WHITE ? score : -score;
+}
+
+[[nodiscard]] int32_t Evaluation::piece_value(Board::piece_t piece) {
+    return Piece::traits(piece).m_value;
+}
+}    // namespace dreamchess
@@ -11,11 +11,15 @@
 #include <algorithm>
 #include <filesystem>
 #include <iostream>
-#include <regex>
+#include <utility>
+#include <vector>
 
 #include "Board.hpp"
+#include "Endgame.hpp"
 #include "Move.hpp"
+#include "MoveGenerator.hpp"
 #include "Piece.hpp"
+#include "Stats.hpp"
 
 /**
  * @namespace dreamchess
@@ -36,18 +40,109 @@ std::ostream &operator<<(std::ostream &stream, const Game &game) {
     return stream;
 }
 
-Board Game::board() const { return m_board; }
+[[nodiscard]] const Board &Game::board() const { return m_board; }
 
-[[nodiscard]] bool Game::is_in_game() const { return m_board.is_in_game(); }
+[[nodiscard]] const History &Game::history() const { return m_history; }
 
-[[nodiscard]] bool Game::is_move_syntax_correct(const std::string &input_move) {
-    std::smatch string_match;
+[[nodiscard]] const Game::destinations_t &Game::destinations() const {
+    if (m_destinations_valid) {
+        return m_destinations;
+    }
+
+    m_destinations.fill(0);
+
+    for (uint16_t source = 0; source < 64; source++) {
+        const Board::piece_t piece = m_board.piece_at(source);
+
+        if (Piece::color(piece) != m_board.turn()) {
+            continue;
+        }
+
+        for (uint16_t destination = 0; destination < 64; destination++) {
+            // As make_move() does when no promotion Piece is given
+            const bool promotion = Piece::type(piece) == Piece::PAWN &&
+                                   (destination <= 7 || destination >= 56);
+            const Move move{source, destination, piece,
+                            promotion ? m_board.turn() | Piece::QUEEN
+                                      : Piece::NONE};
+
+            if (m_board.move_is_valid(move)) {
+                m_destinations[source] |= 1ULL << destination;
+            }
+        }
+    }
+
+    m_destinations_valid = true;
+
+    return m_destinations;
+}
+
+[[nodiscard]] uint64_t Game::destinations(uint16_t source) const {
+    return source < 64 ? destinations()[source] : 0;
+}
+
+[[nodiscard]] bool Game::is_in_game() const {
+    return m_board.is_in_game() && draw_reason() == NO_DRAW;
+}
+
+[[nodiscard]] Game::DrawReason Game::draw_reason() const {
+    if (Endgame::is_dead_draw(m_board)) {
+        return INSUFFICIENT_MATERIAL;
+    }
+
+    if (m_repetitions.repetitions() >= 3) {
+        return THREEFOLD_REPETITION;
+    }
+
+    if (m_board.halfmove_clock() < 100) {
+        return NO_DRAW;
+    }
+
+    // Only reached once per Game, a mate on the last halfmove wins
+    MoveList moves;
+    MoveGenerator::legal(m_board, moves);
+
+    return moves.size() == 0 && MoveGenerator::in_check(m_board)
+               ? NO_DRAW
+               : FIFTY_MOVES;
+}
+
+[[nodiscard]] std::string_view Game::describe(DrawReason reason) {
+    switch (reason) {
+        case INSUFFICIENT_MATERIAL:
+            return "insufficient material";
+        case THREEFOLD_REPETITION:
+            return "threefold repetition";
+        case FIFTY_MOVES:
+            return "fifty-move rule";
+        default:
+            return "";
+    }
+}
+
+[[nodiscard]] bool Game::is_move_syntax_correct(std::string_view input_move) {
+    const auto square = [input_move](std::size_t at) {
+        return input_move[at] >= 'a' && input_move[at] <= 'h' &&
+               input_move[at + 1] >= '1' && input_move[at + 1] <= '8';
+    };
+
+    if ((input_move.size() != 5 && input_move.size() != 7) || !square(0) ||
+        input_move[2] != '-' || !square(3)) {
+        return false;
+    }
+
+    if (input_move.size() == 5) {
+        return true;
+    }
 
-    return std::regex_match(input_move, string_match, Move::move_regex()) ||
-           std::regex_match(input_move, string_match, Move::promotion_regex());
+    return input_move[5] == '=' &&
+           std::string_view{"rRnNbBqQ"}.find(input_move[6]) !=
+               std::string_view::npos;
 }
 
 bool Game::make_move(std::string_view input) {
+    DREAMCHESS_STATS_SCOPE(GAME_MAKE_MOVE);
+
     const uint16_t s_file = input.at(0) - 'a';
     const uint16_t s_rank = input.at(1) - '1';
 
@@ -76,16 +171,34 @@ bool Game::make_move(std::string_view input) {
         }
     }
 
-    Move new_move{source, destination, piece_at(source), promotion_piece};
+    return play(Move{source, destination, piece_at(source), promotion_piece});
+}
 
-    if (!m_board.move_is_valid(new_move)) {
-        return false;
+[[nodiscard]] std::optional<Move> Game::book_move(const Book &book,
+                                                  uint64_t random) const {
+    return book.pick(m_board, random);
+}
+
+std::optional<Move> Game::engine_move(const Search::Limits &limits) {
+    if (!is_in_game()) {
+        return std::nullopt;
     }
 
-    m_board.make_move(new_move);
-    update_history(new_move);
+    if (!m_engine) {
+        m_engine = std::make_unique<Search>();
+    }
 
-    return true;
+    const std::vector<Move> pv = m_engine->think(m_board, limits);
+
+    if (pv.empty() || !play(pv.front())) {
+        return std::nullopt;
+    }
+
+    return pv.front();
+}
+
+[[nodiscard]] TimeManager::Statistics Game::engine_statistics() const {
+    return m_engine ? m_engine->statistics() : TimeManager::Statistics{};
 }
 
 void Game::export_to_file() const {
@@ -98,14 +211,169 @@ void Game::export_to_file() const {
                                      std::filesystem::perms::others_write,
                                  std::filesystem::perm_options::add);
 
-    history_file << m_history.export_all();
+    m_history.export_all(history_file);
 
     history_file.close();
 }
 
+[[nodiscard]] bool Game::export_pgn(const std::string &path,
+                                   const Pgn::Tags &tags) const {
+    std::ofstream pgn_file{path};
+    Pgn::write(pgn_file, tags, m_board, m_history);
+
+    return static_cast<bool>(pgn_file);
+}
+
+bool Game::load_pgn(std::string_view game) {
+    Board board = m_board;
+    History history;
+    RepetitionTable repetitions;
+
+    const auto add_step = [&history, &repetitions](const Board &position,
+                                                   const Move &move) {
+        history.add_step(position, move);
+        repetitions.push(position);
+    };
+
+    if (!Pgn::replay(game, board, add_step)) {
+        return false;
+    }
+
+    repetitions.push(board);
+
+    m_board = board;
+    m_history = std::move(history);
+    m_repetitions = std::move(repetitions);
+    m_destinations_valid = false;
+
+    if (m_journal) {
+        journal_game();
+    }
+
+    if (m_broadcast) {
+        m_broadcast->publish_reset(m_board);
+    }
+
+    return true;
+}
+
+bool Game::open_journal(const std::string &path) {
+    const std::optional<Journal::Contents> contents = Journal::read(path);
+    const bool recovering = contents && (!contents->m_moves.empty() ||
+                                         !contents->m_snapshots.empty());
+    Game recovered{};
+
+    if (recovering) {
+        // The History and the repetitions need every position of the Game
+        std::optional<Board> board = Journal::seek(*contents, 0);
+
+        if (!board) {
+            return false;
+        }
+
+        History history;
+        RepetitionTable repetitions{*board};
+
+        for (const auto &journaled : contents->m_moves) {
+            const Move move = Journal::resolve(journaled, *board);
+
+            history.add_step(*board, move);
+            board->make_move(move);
+            repetitions.push(*board);
+        }
+
+        std::size_t ply = 0;
+
+        // Only the Moves after the last snapshot are checked and played
+        if (!contents->m_snapshots.empty()) {
+            const Journal::Snapshot &last = contents->m_snapshots.back();
+
+            if (!recovered.m_board.unpack(last.m_board)) {
+                return false;
+            }
+
+            recovered.m_repetitions = RepetitionTable{recovered.m_board};
+            ply = last.m_ply;
+        }
+
+        for (; ply < contents->m_moves.size(); ply++) {
+            if (!recovered.play(Journal::resolve(contents->m_moves[ply],
+                                                 recovered.m_board))) {
+                return false;
+            }
+        }
+
+        if (board->fen() != recovered.m_board.fen()) {
+            return false;
+        }
+
+        recovered.m_history = std::move(history);
+        recovered.m_repetitions = std::move(repetitions);
+    }
+
+    auto journal = std::make_unique<Journal>();
+
+    if (!journal->open(path)) {
+        return false;
+    }
+
+    close_journal();
+
+    if (recovering) {
+        recovered.m_broadcast = std::move(m_broadcast);
+        recovered.m_engine = std::move(m_engine);
+        *this = std::move(recovered);
+
+        if (m_broadcast) {
+            m_broadcast->publish_reset(m_board);
+        }
+    }
+
+    m_journal = std::move(journal);
+
+    if (!recovering) {
+        journal_game();
+    }
+
+    return m_journal != nullptr;
+}
+
+bool Game::close_journal() {
+    if (!m_journal) {
+        return true;
+    }
+
+    const bool closed = m_journal->close();
+    m_journal.reset();
+
+    return closed;
+}
+
+bool Game::sync_journal() { return !m_journal || m_journal->sync(); }
+
+void Game::broadcast_to(std::shared_ptr<Broadcast> broadcast) {
+    m_broadcast = std::move(broadcast);
+
+    if (m_broadcast) {
+        m_broadcast->publish_reset(m_board);
+    }
+}
+
 void Game::reset() {
+    m_destinations_valid = false;
     m_board.clear();
     m_board.init_board();
+    m_history.clear();
+    m_repetitions.clear();
+    m_repetitions.push(m_board);
+
+    if (m_journal) {
+        m_journal->append_reset();
+    }
+
+    if (m_broadcast) {
+        m_broadcast->publish_reset(m_board);
+    }
 }
 
 Board::piece_t Game::piece_at(uint16_t index) const {
@@ -120,5 +388,55 @@ Board::piece_t Game::piece_at(uint16_t index) const {
     return m_board.end();
 }
 
-void Game::update_history(const Move &move) { m_history.add_step(move); }
+void Game::update_history(const Move &move) {
+    m_history.add_step(m_board, move);
+}
+
+bool Game::play(const Move &move) {
+    if (!m_board.move_is_valid(move)) {
+        return false;
+    }
+
+    m_destinations_valid = false;
+
+    update_history(move);
+    m_board.make_move(move);
+    m_repetitions.push(m_board);
+
+    if (m_journal) {
+        m_journal->append(move);
+
+        if (m_history.size() % Journal::SNAPSHOT_INTERVAL == 0) {
+            m_journal->append_snapshot(m_board);
+        }
+    }
+
+    if (m_broadcast) {
+        m_broadcast->publish_move(move, m_board);
+    }
+
+    return true;
+}
+
+void Game::journal_game() {
+    Board board = m_history.position(m_board, 0);
+
+    m_journal->append_reset();
+
+    if (board.fen() != Board::START_FEN &&
+        !m_journal->append_snapshot(board)) {
+        close_journal();
+        return;
+    }
+
+    for (std::size_t ply = 0; ply < m_history.size(); ply++) {
+        const Move move = m_history.move(ply);
+        board.make_move(move);
+        m_journal->append(move);
+
+        if ((ply + 1) % Journal::SNAPSHOT_INTERVAL == 0) {
+            m_journal->append_snapshot(board);
+        }
+    }
+}
 }    // namespace dreamchess
@@ -0,0 +1,469 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "GameServer.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Events handled per epoll_wait() call
+ */
+constexpr int MAX_EVENTS{256};
+
+/**
+ * @brief Splits the first word off a command
+ */
+std::string_view next_word(std::string_view &line) {
+    const std::size_t begin =
+        std::min(line.find_first_not_of(' '), line.size());
+    const std::size_t end = std::min(line.find(' ', begin), line.size());
+    const std::string_view word = line.substr(begin, end - begin);
+    line.remove_prefix(end);
+
+    return word;
+}
+
+/**
+ * @brief Parses a session id
+ */
+SessionTable::session_t parse_session(std::string_view word) {
+    SessionTable::session_t session = 0;
+    const auto [end, error] =
+        std::from_chars(word.data(), word.data() + word.size(), session);
+
+    return error == std::errc{} && end == word.data() + word.size() ? session
+                                                                    : 0;
+}
+
+/**
+ * @brief Adds a file descriptor to an epoll instance
+ */
+bool watch(int epoll, int fd, uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+
+    return epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+}    // namespace
+
+GameServer::GameServer(uint16_t workers)
+    : m_workers{std::max<uint16_t>(1, workers)},
+      m_stop{eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)} {}
+
+GameServer::~GameServer() {
+    if (m_listener != -1) {
+        ::close(m_listener);
+    }
+
+    if (m_stop != -1) {
+        ::close(m_stop);
+    }
+
+    if (!m_path.empty()) {
+        unlink(m_path.c_str());
+    }
+}
+
+bool GameServer::listen_tcp(uint16_t port) {
+    m_listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (m_listener == -1) {
+        return false;
+    }
+
+    const int reuse = 1;
+    setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+
+    if (bind(m_listener, reinterpret_cast<sockaddr *>(&address), length) != 0 ||
+        listen(m_listener, SOMAXCONN) != 0 ||
+        getsockname(m_listener, reinterpret_cast<sockaddr *>(&address),
+                    &length) != 0) {
+        ::close(m_listener);
+        m_listener = -1;
+        return false;
+    }
+
+    m_port = ntohs(address.sin_port);
+
+    return true;
+}
+
+bool GameServer::listen_unix(const std::string &path) {
+    sockaddr_un address{};
+
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+
+    m_listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (m_listener == -1) {
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    unlink(path.c_str());
+
+    if (bind(m_listener, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+        listen(m_listener, SOMAXCONN) != 0) {
+        ::close(m_listener);
+        m_listener = -1;
+        return false;
+    }
+
+    m_path = path;
+
+    return true;
+}
+
+[[nodiscard]] uint16_t GameServer::port() const { return m_port; }
+
+void GameServer::run() {
+    std::vector<int> epolls;
+    std::vector<std::thread> workers;
+
+    // stop() makes the event file readable, waking every loop up
+    for (uint16_t worker = 0; worker < m_workers; worker++) {
+        epolls.push_back(epoll_create1(EPOLL_CLOEXEC));
+        watch(epolls.back(), m_stop, EPOLLIN);
+        workers.emplace_back(&GameServer::serve, this, epolls.back());
+    }
+
+    const int acceptor = epoll_create1(EPOLL_CLOEXEC);
+    watch(acceptor, m_stop, EPOLLIN);
+    watch(acceptor, m_listener, EPOLLIN);
+
+    std::size_t next = 0;
+    bool running = true;
+
+    while (running) {
+        std::array<epoll_event, 2> events{};
+        const int ready = epoll_wait(acceptor, events.data(),
+                                     static_cast<int>(events.size()), -1);
+
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.fd == m_stop) {
+                running = false;
+                continue;
+            }
+
+            for (;;) {
+                const int client =
+                    accept4(m_listener, nullptr, nullptr,
+                            SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+                if (client == -1) {
+                    break;
+                }
+
+                // Replies are small and awaited, don't let Nagle hold them
+                if (m_path.empty()) {
+                    const int no_delay = 1;
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &no_delay,
+                               sizeof(no_delay));
+                }
+
+                m_connections.fetch_add(1, std::memory_order_relaxed);
+
+                if (!watch(epolls[next++ % epolls.size()], client,
+                           EPOLLIN | EPOLLRDHUP)) {
+                    ::close(client);
+                }
+            }
+        }
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    for (const int epoll : epolls) {
+        ::close(epoll);
+    }
+
+    ::close(acceptor);
+
+    // The next run() starts stopped otherwise
+    uint64_t value = 0;
+    [[maybe_unused]] const auto drained = read(m_stop, &value, sizeof(value));
+}
+
+void GameServer::stop() {
+    const uint64_t value = 1;
+    [[maybe_unused]] const auto written = write(m_stop, &value, sizeof(value));
+}
+
+void GameServer::execute(std::string_view line, std::string &reply) {
+    m_commands.fetch_add(1, std::memory_order_relaxed);
+
+    const std::string_view command = next_word(line);
+
+    if (command == "new") {
+        reply.append("ok ").append(std::to_string(m_sessions.open()));
+    } else if (command == "move") {
+        const SessionTable::session_t session = parse_session(next_word(line));
+        const std::string_view move = next_word(line);
+
+        const bool found = m_sessions.with(session, [&](Game &game) {
+            if (!game.is_in_game()) {
+                reply.append("error game over");
+            } else if (!Game::is_move_syntax_correct(move)) {
+                reply.append("error malformed move");
+            } else if (!game.make_move(move)) {
+                m_illegal.fetch_add(1, std::memory_order_relaxed);
+                reply.append("illegal");
+            } else {
+                m_moves.fetch_add(1, std::memory_order_relaxed);
+
+                if (game.is_in_game()) {
+                    reply.append("ok");
+                } else if (game.draw_reason() != Game::NO_DRAW) {
+                    reply.append("end ").append(
+                        Game::describe(game.draw_reason()));
+                } else {
+                    reply.append("end king captured");
+                }
+            }
+        });
+
+        if (!found) {
+            reply.append("error unknown session");
+        }
+    } else if (command == "fen") {
+        const bool found =
+            m_sessions.with(parse_session(next_word(line)), [&](Game &game) {
+                reply.append("ok ").append(game.board().fen());
+            });
+
+        if (!found) {
+            reply.append("error unknown session");
+        }
+    } else if (command == "targets") {
+        const SessionTable::session_t session = parse_session(next_word(line));
+        const std::string_view square = next_word(line);
+
+        if (square.size() != 2 || square[0] < 'a' || square[0] > 'h' ||
+            square[1] < '1' || square[1] > '8') {
+            reply.append("error malformed square");
+        } else {
+            const auto source =
+                static_cast<uint16_t>((square[1] - '1') * 8 + square[0] - 'a');
+
+            const bool found = m_sessions.with(session, [&](Game &game) {
+                reply.append("ok");
+
+                for (uint64_t targets = game.destinations(source); targets;
+                     targets &= targets - 1) {
+                    const int destination = __builtin_ctzll(targets);
+                    reply.push_back(' ');
+                    reply.push_back(static_cast<char>('a' + destination % 8));
+                    reply.push_back(static_cast<char>('1' + destination / 8));
+                }
+            });
+
+            if (!found) {
+                reply.append("error unknown session");
+            }
+        }
+    } else if (command == "close") {
+        reply.append(m_sessions.close(parse_session(next_word(line)))
+                         ? "ok"
+                         : "error unknown session");
+    } else if (command == "stats") {
+        const Statistics counters = statistics();
+
+        reply.append("ok sessions ")
+            .append(std::to_string(m_sessions.size()))
+            .append(" pooled ")
+            .append(std::to_string(m_sessions.pooled()))
+            .append(" moves ")
+            .append(std::to_string(counters.m_moves))
+            .append(" illegal ")
+            .append(std::to_string(counters.m_illegal));
+    } else {
+        reply.append("error unknown command");
+    }
+
+    reply.push_back('\n');
+}
+
+[[nodiscard]] GameServer::Statistics GameServer::statistics() const {
+    return {m_connections.load(std::memory_order_relaxed),
+            m_commands.load(std::memory_order_relaxed),
+            m_moves.load(std::memory_order_relaxed),
+            m_illegal.load(std::memory_order_relaxed)};
+}
+
+[[nodiscard]] const SessionTable &GameServer::sessions() const {
+    return m_sessions;
+}
+
+void GameServer::serve(int epoll) {
+    std::unordered_map<int, Connection> connections;
+    std::array<epoll_event, MAX_EVENTS> events{};
+    bool running = true;
+
+    while (running) {
+        const int ready = epoll_wait(epoll, events.data(), MAX_EVENTS, -1);
+
+        for (int i = 0; i < ready; i++) {
+            const int fd = events[i].data.fd;
+
+            if (fd == m_stop) {
+                running = false;
+                continue;
+            }
+
+            Connection &connection = connections[fd];
+            bool open = true;
+
+            if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP |
+                                     EPOLLERR)) != 0) {
+                open = receive(fd, connection);
+            }
+
+            // Replies are flushed even if the client is leaving
+            if (!connection.m_output.empty() && !send(epoll, fd, connection)) {
+                open = false;
+            }
+
+            if (!open) {
+                ::close(fd);
+                connections.erase(fd);
+            }
+        }
+    }
+
+    for (const auto &[fd, connection] : connections) {
+        ::close(fd);
+    }
+}
+
+bool GameServer::receive(int fd, Connection &connection) {
+    std::array<char, READ_SIZE> buffer{};
+    bool open = true;
+
+    for (;;) {
+        const ssize_t bytes = read(fd, buffer.data(), buffer.size());
+
+        if (bytes > 0) {
+            connection.m_input.append(buffer.data(),
+                                      static_cast<std::size_t>(bytes));
+            continue;
+        }
+
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            open = false;
+        }
+
+        break;
+    }
+
+    std::string_view input{connection.m_input};
+
+    for (std::size_t end = input.find('\n'); end != std::string_view::npos;
+         end = input.find('\n')) {
+        std::string_view line = input.substr(0, end);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        execute(line, connection.m_output);
+        input.remove_prefix(end + 1);
+    }
+
+    if (input.size() > MAX_LINE) {
+        return false;
+    }
+
+    connection.m_input.erase(0, connection.m_input.size() - input.size());
+
+    return open;
+}
+
+bool GameServer::send(int epoll, int fd, Connection &connection) {
+    std::size_t sent = 0;
+
+    while (sent < connection.m_output.size()) {
+        // A client gone away must not raise SIGPIPE
+        const ssize_t bytes =
+            ::send(fd, connection.m_output.data() + sent,
+                   connection.m_output.size() - sent, MSG_NOSIGNAL);
+
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+
+            break;
+        }
+
+        sent += static_cast<std::size_t>(bytes);
+    }
+
+    connection.m_output.erase(0, sent);
+
+    const bool writing = !connection.m_output.empty();
+
+    if (writing != connection.m_writing) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+
+        if (writing) {
+            event.events |= EPOLLOUT;
+        }
+
+        event.data.fd = fd;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event);
+        connection.m_writing = writing;
+    }
+
+    return true;
+}
+}    // namespace dreamchess
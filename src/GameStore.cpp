@@ -0,0 +1,159 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "GameStore.hpp"
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Reads a little-endian unsigned integer of N bytes
+ */
+template <std::size_t N>
+uint64_t read_little_endian(const uint8_t *bytes) {
+    uint64_t value = 0;
+
+    for (std::size_t i = N; i-- > 0;) {
+        value = (value << 8) | bytes[i];
+    }
+
+    return value;
+}
+}    // namespace
+
+bool GameStore::open(const std::string &path) {
+    close();
+
+    if (!m_file.open(path) || m_file.size() < HEADER_SIZE ||
+        std::string_view{reinterpret_cast<const char *>(m_file.data()),
+                         MAGIC.size()} != MAGIC ||
+        read_little_endian<4>(m_file.data() + 4) != VERSION) {
+        close();
+        return false;
+    }
+
+    const uint64_t games = read_little_endian<8>(m_file.data() + 8);
+    const uint64_t index = read_little_endian<8>(m_file.data() + 16);
+
+    // The index must fit and point inside the records
+    if (index < HEADER_SIZE || index > m_file.size() ||
+        (m_file.size() - index) % 8 != 0 ||
+        (m_file.size() - index) / 8 != games + 1 ||
+        read_little_endian<8>(m_file.data() + index + games * 8) > index) {
+        close();
+        return false;
+    }
+
+    m_games = games;
+    m_index = m_file.data() + index;
+
+    return true;
+}
+
+void GameStore::close() {
+    m_file.close();
+    m_games = 0;
+    m_index = nullptr;
+}
+
+[[nodiscard]] std::size_t GameStore::size() const { return m_games; }
+
+[[nodiscard]] std::optional<GameStore::Record> GameStore::record(
+    std::size_t game) const {
+    if (game >= m_games) {
+        return std::nullopt;
+    }
+
+    const uint64_t begin = read_little_endian<8>(m_index + game * 8);
+    const uint64_t end = read_little_endian<8>(m_index + game * 8 + 8);
+
+    if (begin < HEADER_SIZE || end < begin + 2 ||
+        end > static_cast<uint64_t>(m_index - m_file.data())) {
+        return std::nullopt;
+    }
+
+    const uint8_t *bytes = m_file.data() + begin;
+    const uint8_t *const last = m_file.data() + end;
+
+    Record result;
+    const uint8_t flags = *bytes++;
+
+    if (*bytes >= RESULTS.size()) {
+        return std::nullopt;
+    }
+
+    result.m_result = RESULTS[*bytes++];
+
+    const auto read_string = [&bytes, last](std::string_view &value) {
+        if (bytes == last || last - bytes - 1 < *bytes) {
+            return false;
+        }
+
+        value = std::string_view{reinterpret_cast<const char *>(bytes + 1),
+                                 *bytes};
+        bytes += *bytes + 1;
+
+        return true;
+    };
+
+    for (auto &tag : result.m_tags) {
+        if (!read_string(tag)) {
+            return std::nullopt;
+        }
+    }
+
+    if ((flags & FEN_FLAG) != 0 && !read_string(result.m_fen)) {
+        return std::nullopt;
+    }
+
+    result.m_moves = bytes;
+    result.m_plies = static_cast<std::size_t>(last - bytes);
+
+    return result;
+}
+
+[[nodiscard]] std::optional<uint32_t> GameStore::replay(
+    std::size_t game, Board &board, const Pgn::visitor_t &visit) const {
+    const std::optional<Record> stored = record(game);
+
+    if (!stored) {
+        return std::nullopt;
+    }
+
+    if (stored->m_fen.empty()) {
+        board = Board::start_position();
+    } else if (!board.load_fen(stored->m_fen)) {
+        return std::nullopt;
+    }
+
+    for (std::size_t ply = 0; ply < stored->m_plies; ply++) {
+        MoveList moves;
+        MoveGenerator::pseudo_legal(board, moves);
+
+        if (stored->m_moves[ply] >= moves.size()) {
+            return std::nullopt;
+        }
+
+        const Move &move = moves[stored->m_moves[ply]];
+
+        if (visit) {
+            visit(board, move);
+        }
+
+        board.make_move(move);
+    }
+
+    return static_cast<uint32_t>(stored->m_plies);
+}
+}    // namespace dreamchess
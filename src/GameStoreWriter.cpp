@@ -0,0 +1,194 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "GameStoreWriter.hpp"
+
+#include <algorithm>
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Appends a little-endian unsigned integer of N bytes
+ */
+template <std::size_t N>
+void write_little_endian(std::string &bytes, uint64_t value) {
+    for (std::size_t i = 0; i < N; i++) {
+        bytes.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/**
+ * @brief Appends a string prefixed by its length, truncated to 255 bytes
+ */
+void write_string(std::string &bytes, std::string_view value) {
+    value = value.substr(0, 255);
+
+    bytes.push_back(static_cast<char>(value.size()));
+    bytes.append(value);
+}
+}    // namespace
+
+GameStoreWriter::~GameStoreWriter() { close(); }
+
+bool GameStoreWriter::open(const std::string &path) {
+    close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    m_offsets.clear();
+    m_end = GameStore::HEADER_SIZE;
+
+    // The header is written again by close()
+    const std::string header(GameStore::HEADER_SIZE, '\0');
+    m_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    return static_cast<bool>(m_file);
+}
+
+bool GameStoreWriter::add(const Pgn::Tags &tags, const Board &board,
+                          const History &history) {
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    Board position = history.position(board, 0);
+    const std::string start = position.fen();
+
+    begin_record({tags.m_event, tags.m_site, tags.m_date, tags.m_round,
+                  tags.m_white, tags.m_black},
+                 tags.m_result.empty() ? Pgn::result(board) : tags.m_result,
+                 start == Board::START_FEN ? std::string_view{} : start);
+
+    for (std::size_t ply = 0; ply < history.size(); ply++) {
+        const Move move = history.move(ply);
+
+        if (!add_move(position, move)) {
+            return false;
+        }
+
+        position.make_move(move);
+    }
+
+    return end_record();
+}
+
+bool GameStoreWriter::add_pgn(std::string_view game) {
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    GameStore::tags_t tags{};
+
+    for (std::size_t i = 0; i < tags.size(); i++) {
+        tags[i] = Pgn::tag(game, GameStore::TAGS[i]);
+    }
+
+    begin_record(tags, Pgn::tag(game, "Result"), Pgn::tag(game, "FEN"));
+
+    Board board{};
+    bool legal = true;
+
+    const auto encode = [this, &legal](const Board &position,
+                                       const Move &move) {
+        legal = legal && add_move(position, move);
+    };
+
+    if (!Pgn::replay(game, board, encode) || !legal) {
+        return false;
+    }
+
+    return end_record();
+}
+
+bool GameStoreWriter::close() {
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    std::string index;
+    index.reserve((m_offsets.size() + 1) * 8);
+
+    for (const uint64_t offset : m_offsets) {
+        write_little_endian<8>(index, offset);
+    }
+
+    write_little_endian<8>(index, m_end);
+    m_file.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+    std::string header{GameStore::MAGIC};
+    write_little_endian<4>(header, GameStore::VERSION);
+    write_little_endian<8>(header, m_offsets.size());
+    write_little_endian<8>(header, m_end);
+
+    m_file.seekp(0);
+    m_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    const bool written = static_cast<bool>(m_file);
+    m_file.close();
+
+    return written;
+}
+
+[[nodiscard]] std::size_t GameStoreWriter::size() const {
+    return m_offsets.size();
+}
+
+void GameStoreWriter::begin_record(const GameStore::tags_t &tags,
+                                   std::string_view result,
+                                   std::string_view fen) {
+    const auto &results = GameStore::RESULTS;
+    const auto found = std::find(results.begin(), results.end(), result);
+
+    m_record.clear();
+    m_record.push_back(
+        static_cast<char>(fen.empty() ? 0 : GameStore::FEN_FLAG));
+    m_record.push_back(static_cast<char>(
+        found == results.end() ? 0 : found - results.begin()));
+
+    for (const auto &tag : tags) {
+        write_string(m_record, tag);
+    }
+
+    if (!fen.empty()) {
+        write_string(m_record, fen);
+    }
+}
+
+bool GameStoreWriter::add_move(const Board &board, const Move &move) {
+    MoveList moves;
+    MoveGenerator::pseudo_legal(board, moves);
+
+    for (std::size_t i = 0; i < moves.size(); i++) {
+        if (moves[i] == move) {
+            if (!MoveGenerator::leaves_king_safe(board, move)) {
+                return false;
+            }
+
+            m_record.push_back(static_cast<char>(i));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool GameStoreWriter::end_record() {
+    m_file.write(m_record.data(),
+                 static_cast<std::streamsize>(m_record.size()));
+    m_offsets.push_back(m_end);
+    m_end += m_record.size();
+
+    return static_cast<bool>(m_file);
+}
+}    // namespace dreamchess
@@ -8,7 +8,10 @@
 
 #include "History.hpp"
 
-#include <utility>
+#include <array>
+#include <charconv>
+
+#include "Stats.hpp"
 
 /**
  * @namespace dreamchess
@@ -16,25 +19,116 @@
  * @details Used to avoid the std namespace pollution
  */
 namespace dreamchess {
+namespace {
+/**
+ * @brief Size of the buffer export_all() writes to the stream at once
+ */
+constexpr std::size_t EXPORT_BUFFER_SIZE{4096};
+
+/**
+ * @brief Upper bound of the length of an exported Step
+ */
+constexpr std::size_t MAX_STEP_LENGTH{32};
+}    // namespace
+
+History::History() { m_game_history.reserve(RESERVED_STEPS); }
+
+void History::add_step(const Board &board, const Move &move) {
+    DREAMCHESS_STATS_SCOPE(HISTORY_ADD_STEP);
+
+    m_game_history.emplace_back(move, board.undo(move));
+}
 
-History::~History() { m_game_history.clear(); }
+void History::clear() { m_game_history.clear(); }
+
+[[nodiscard]] std::size_t History::size() const {
+    return m_game_history.size();
+}
+
+[[nodiscard]] Move History::move(std::size_t ply) const {
+    return m_game_history[ply].move();
+}
+
+[[nodiscard]] Board History::position(const Board &board,
+                                      std::size_t ply) const {
+    Board result = board;
+
+    for (std::size_t step = m_game_history.size(); step > ply; step--) {
+        const Step &taken_back = m_game_history[step - 1];
+        result.unmake_move(taken_back.move(), taken_back.undo());
+    }
+
+    return result;
+}
 
-void History::add_step(const Move &move) { m_game_history.emplace_back(move); }
+void History::export_all(std::ostream &stream) const {
+    std::string buffer;
+    buffer.reserve(EXPORT_BUFFER_SIZE);
+
+    for (std::size_t ply = 0; ply < m_game_history.size(); ply++) {
+        if (buffer.size() + MAX_STEP_LENGTH > EXPORT_BUFFER_SIZE) {
+            stream.write(buffer.data(),
+                         static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+
+        append_step(buffer, ply);
+    }
+
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
 
 [[nodiscard]] std::string History::export_all() const {
-    step_list_t output_history = m_game_history;
     std::string move_list;
+    move_list.reserve(m_game_history.size() * MAX_STEP_LENGTH / 2);
 
-    for (const auto &step : m_game_history) {
-        move_list += std::to_string((&step - &m_game_history.front()) + 1) +
-                     ". " + std::string{output_history.front().m_move};
-        move_list.push_back('\n');
-
-        output_history.pop_front();
+    for (std::size_t ply = 0; ply < m_game_history.size(); ply++) {
+        append_step(move_list, ply);
     }
 
     return move_list;
 }
 
-History::Step::Step(const Move &move) : m_move{move.to_alg()} {}
+void History::append_step(std::string &buffer, std::size_t ply) const {
+    const Step &step = m_game_history[ply];
+
+    std::array<char, 20> number{};
+    const auto end =
+        std::to_chars(number.data(), number.data() + number.size(), ply + 1)
+            .ptr;
+
+    buffer.append(number.data(), end);
+    buffer.append(". ");
+
+    const auto piece = static_cast<Piece::Enum>(step.m_piece);
+
+    if (Piece::type(piece) != Piece::PAWN) {
+        buffer.append(Piece::unicode_representation(piece));
+    }
+
+    buffer.push_back(static_cast<char>('a' + step.m_destination % 8));
+    buffer.push_back(static_cast<char>('1' + step.m_destination / 8));
+    buffer.push_back('\n');
+}
+
+History::Step::Step(const Move &move, const Board::Undo &undo)
+    : m_source{static_cast<uint8_t>(move.source())},
+      m_destination{static_cast<uint8_t>(move.destination())},
+      m_piece{static_cast<uint8_t>(move.piece())},
+      m_promotion{static_cast<uint8_t>(move.promotion_piece())},
+      m_captured{static_cast<uint8_t>(undo.m_captured)},
+      m_captured_square{static_cast<int8_t>(undo.m_captured_square)},
+      m_castling{undo.m_castling},
+      m_en_passant{static_cast<int8_t>(undo.m_en_passant)},
+      m_halfmove_clock{undo.m_halfmove_clock} {}
+
+[[nodiscard]] Move History::Step::move() const {
+    return Move{m_source, m_destination, static_cast<Piece::Enum>(m_piece),
+                static_cast<Piece::Enum>(m_promotion)};
+}
+
+[[nodiscard]] Board::Undo History::Step::undo() const {
+    return Board::Undo{static_cast<Piece::Enum>(m_captured), m_captured_square,
+                       m_castling, m_en_passant, m_halfmove_clock};
+}
 }    // namespace dreamchess
@@ -0,0 +1,387 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Journal.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+
+#include "Piece.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Code of the record starting a new Game, no Move has it
+ */
+constexpr uint16_t RESET_CODE{0xFFFF};
+
+/**
+ * @brief Code of the record opening a snapshot, no Move has it
+ */
+constexpr uint16_t SNAPSHOT_CODE{0xFFFE};
+
+/**
+ * @brief Packs a Move in 15 bits: source, destination and promotion type
+ * @details The promotion type is stored as the index of its bit, from 1 for
+ * a Knight to 4 for a Queen
+ */
+uint16_t encode(const Move &move) {
+    const auto promotion = Piece::type(move.promotion_piece());
+    const uint16_t index =
+        promotion == Piece::NONE ? 0 : __builtin_ctz(promotion);
+
+    return static_cast<uint16_t>(move.source() | move.destination() << 6 |
+                                 index << 12);
+}
+
+/**
+ * @brief Unpacks a Move, with no Piece and a colorless promotion type
+ */
+Move decode(uint16_t code) {
+    const uint16_t index = code >> 12;
+    const auto promotion =
+        index == 0 ? Piece::NONE : static_cast<Piece::Enum>(1 << index);
+
+    return Move{code & 63, code >> 6 & 63, Piece::NONE, promotion};
+}
+
+/**
+ * @brief Check word of a record, never 0 so zeroed blocks are rejected
+ */
+uint16_t check(uint16_t code) {
+    return static_cast<uint16_t>(~(code * 0x9E37U));
+}
+
+/**
+ * @brief FNV-1a checksum of a packed Board
+ */
+uint32_t checksum(const Board::packed_t &packed) {
+    uint32_t hash = 2166136261U;
+
+    for (const auto byte : packed) {
+        hash = (hash ^ byte) * 16777619U;
+    }
+
+    return hash;
+}
+
+void put_word(std::string &bytes, uint16_t word) {
+    bytes.push_back(static_cast<char>(word & 0xFF));
+    bytes.push_back(static_cast<char>(word >> 8));
+}
+
+/**
+ * @brief Parses a journal
+ * @param bytes The whole file
+ * @param contents Filled with the Game since the last reset
+ * @return The length of the valid prefix, 0 if the file is not a journal
+ */
+std::size_t parse(std::string_view bytes, Journal::Contents &contents) {
+    if (bytes.substr(0, Journal::MAGIC.size()) != Journal::MAGIC) {
+        return 0;
+    }
+
+    std::size_t at = Journal::MAGIC.size();
+
+    const auto byte = [bytes](std::size_t offset) {
+        return static_cast<uint8_t>(bytes[offset]);
+    };
+    const auto word = [byte](std::size_t offset) {
+        return static_cast<uint16_t>(byte(offset) | byte(offset + 1) << 8);
+    };
+
+    while (at + Journal::RECORD_SIZE <= bytes.size()) {
+        const uint16_t code = word(at);
+
+        if (word(at + 2) != check(code)) {
+            break;
+        }
+
+        if (code == SNAPSHOT_CODE) {
+            if (at + Journal::SNAPSHOT_SIZE > bytes.size()) {
+                break;
+            }
+
+            Journal::Snapshot snapshot{contents.m_moves.size(), {}};
+            const std::size_t board = at + Journal::RECORD_SIZE;
+            const std::size_t sum = board + snapshot.m_board.size();
+
+            for (std::size_t i = 0; i < snapshot.m_board.size(); i++) {
+                snapshot.m_board[i] = byte(board + i);
+            }
+
+            if ((word(sum) | static_cast<uint32_t>(word(sum + 2)) << 16) !=
+                checksum(snapshot.m_board)) {
+                break;
+            }
+
+            contents.m_snapshots.push_back(snapshot);
+            at += Journal::SNAPSHOT_SIZE;
+            continue;
+        }
+
+        if (code == RESET_CODE) {
+            contents = Journal::Contents{};
+        } else if (code >> 12 <= 4) {
+            contents.m_moves.push_back(decode(code));
+        } else {
+            break;
+        }
+
+        at += Journal::RECORD_SIZE;
+    }
+
+    return at;
+}
+
+bool read_file(const std::string &path, std::string &bytes) {
+    std::ifstream file{path, std::ios::binary};
+    bytes.assign(std::istreambuf_iterator<char>{file},
+                 std::istreambuf_iterator<char>{});
+
+    return !file.bad() && file.is_open();
+}
+
+bool write_all(int fd, const char *data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return false;
+        }
+
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+}    // namespace
+
+Journal::~Journal() { close(); }
+
+bool Journal::open(const std::string &path) {
+    close();
+
+    std::string bytes;
+    Contents contents;
+    std::size_t valid = 0;
+
+    if (read_file(path, bytes)) {
+        valid = parse(bytes, contents);
+
+        if (valid == 0 && !bytes.empty()) {
+            // Not a journal, better not to overwrite it
+            return false;
+        }
+    }
+
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool ready =
+        valid == 0 ? ::ftruncate(fd, 0) == 0 &&
+                         write_all(fd, MAGIC.data(), MAGIC.size())
+                   : ::ftruncate(fd, static_cast<off_t>(valid)) == 0 &&
+                         ::lseek(fd, 0, SEEK_END) >= 0;
+
+    if (!ready || ::fdatasync(fd) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_pending.clear();
+    m_appended = 0;
+    m_synced = 0;
+    m_syncs = 0;
+    m_failed = false;
+    m_closing = false;
+    m_writer = std::thread{&Journal::write_loop, this};
+
+    return true;
+}
+
+void Journal::append(const Move &move) { push(encode(move)); }
+
+void Journal::append_reset() { push(RESET_CODE); }
+
+bool Journal::append_snapshot(const Board &board) {
+    const std::optional<Board::packed_t> packed = board.pack();
+
+    if (!packed) {
+        return false;
+    }
+
+    const uint32_t sum = checksum(*packed);
+
+    {
+        const std::lock_guard lock{m_mutex};
+        put_word(m_pending, SNAPSHOT_CODE);
+        put_word(m_pending, check(SNAPSHOT_CODE));
+        m_pending.append(packed->begin(), packed->end());
+        put_word(m_pending, static_cast<uint16_t>(sum));
+        put_word(m_pending, static_cast<uint16_t>(sum >> 16));
+        m_appended++;
+    }
+
+    m_changed.notify_all();
+
+    return true;
+}
+
+bool Journal::sync() {
+    std::unique_lock lock{m_mutex};
+    const uint64_t target = m_appended;
+
+    m_changed.wait(lock,
+                   [this, target] { return m_synced >= target || m_failed; });
+
+    return !m_failed;
+}
+
+bool Journal::close() {
+    if (!m_writer.joinable()) {
+        return !m_failed;
+    }
+
+    {
+        const std::lock_guard lock{m_mutex};
+        m_closing = true;
+    }
+
+    m_changed.notify_all();
+    m_writer.join();
+
+    ::close(m_fd);
+    m_fd = -1;
+
+    return !m_failed;
+}
+
+[[nodiscard]] bool Journal::is_open() const { return m_fd >= 0; }
+
+[[nodiscard]] uint64_t Journal::syncs() const {
+    const std::lock_guard lock{m_mutex};
+
+    return m_syncs;
+}
+
+[[nodiscard]] std::optional<Journal::Contents> Journal::read(
+    const std::string &path) {
+    std::string bytes;
+    Contents contents;
+
+    if (!read_file(path, bytes) || parse(bytes, contents) == 0) {
+        return std::nullopt;
+    }
+
+    return contents;
+}
+
+[[nodiscard]] std::optional<Board> Journal::seek(const Contents &contents,
+                                                 std::size_t ply) {
+    if (ply > contents.m_moves.size()) {
+        return std::nullopt;
+    }
+
+    Board board{};
+    std::size_t played = 0;
+
+    const auto after = std::upper_bound(
+        contents.m_snapshots.begin(), contents.m_snapshots.end(), ply,
+        [](std::size_t target, const Snapshot &snapshot) {
+            return target < snapshot.m_ply;
+        });
+
+    if (after != contents.m_snapshots.begin()) {
+        const Snapshot &nearest = *(after - 1);
+
+        if (!board.unpack(nearest.m_board)) {
+            return std::nullopt;
+        }
+
+        played = nearest.m_ply;
+    }
+
+    for (; played < ply; played++) {
+        board.make_move(resolve(contents.m_moves[played], board));
+    }
+
+    return board;
+}
+
+[[nodiscard]] Move Journal::resolve(const Move &move, const Board &board) {
+    const Board::piece_t promotion =
+        move.promotion_piece() == Piece::NONE
+            ? Piece::NONE
+            : move.promotion_piece() | board.turn();
+
+    return Move{move.source(), move.destination(),
+                board.piece_at(static_cast<uint16_t>(move.source())),
+                promotion};
+}
+
+void Journal::push(uint16_t code) {
+    {
+        const std::lock_guard lock{m_mutex};
+        put_word(m_pending, code);
+        put_word(m_pending, check(code));
+        m_appended++;
+    }
+
+    m_changed.notify_all();
+}
+
+void Journal::write_loop() {
+    std::string batch;
+    std::unique_lock lock{m_mutex};
+
+    for (;;) {
+        m_changed.wait(lock,
+                       [this] { return !m_pending.empty() || m_closing; });
+
+        if (m_pending.empty()) {
+            return;
+        }
+
+        // Records appended while the batch is written make the next batch
+        batch.swap(m_pending);
+        const uint64_t appended = m_appended;
+        lock.unlock();
+
+        const bool written = write_all(m_fd, batch.data(), batch.size()) &&
+                             ::fdatasync(m_fd) == 0;
+        batch.clear();
+
+        lock.lock();
+        m_syncs++;
+        m_failed = m_failed || !written;
+        m_synced = appended;
+        m_changed.notify_all();
+    }
+}
+}    // namespace dreamchess
@@ -0,0 +1,264 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Kpk.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @enum Result
+ * @brief Retrograde analysis states, as flags so that children ORed together
+ * tell which outcomes are reachable
+ */
+enum Result : uint8_t { INVALID = 0, UNKNOWN = 1, DRAW = 2, WIN = 4 };
+
+uint16_t file_of(uint16_t square) { return square % 8; }
+
+uint16_t rank_of(uint16_t square) { return square / 8; }
+
+uint16_t distance(uint16_t lhs, uint16_t rhs) {
+    return static_cast<uint16_t>(
+        std::max(std::abs(file_of(lhs) - file_of(rhs)),
+                 std::abs(rank_of(lhs) - rank_of(rhs))));
+}
+
+/**
+ * @brief Packs a normalized position, the strong side is always WHITE
+ */
+uint32_t index(bool white_to_move, uint16_t black_king, uint16_t white_king,
+               uint16_t pawn) {
+    return static_cast<uint32_t>(white_to_move ? 0 : 1) |
+           (static_cast<uint32_t>(black_king) << 1) |
+           (static_cast<uint32_t>(white_king) << 7) |
+           (static_cast<uint32_t>(file_of(pawn)) << 13) |
+           (static_cast<uint32_t>(6 - rank_of(pawn)) << 15);
+}
+
+bool pawn_attacks(uint16_t pawn, uint16_t square) {
+    return rank_of(square) == rank_of(pawn) + 1 &&
+           std::abs(file_of(square) - file_of(pawn)) == 1;
+}
+
+/**
+ * @struct Position
+ * @brief A normalized KPK position, decoded from its index
+ */
+struct Position final {
+    bool m_white_to_move;
+    uint16_t m_black_king;
+    uint16_t m_white_king;
+    uint16_t m_pawn;
+
+    explicit Position(uint32_t idx)
+        : m_white_to_move{(idx & 1) == 0},
+          m_black_king{static_cast<uint16_t>((idx >> 1) & 63)},
+          m_white_king{static_cast<uint16_t>((idx >> 7) & 63)},
+          m_pawn{static_cast<uint16_t>((6 - ((idx >> 15) & 7)) * 8 +
+                                       ((idx >> 13) & 3))} {}
+
+    /**
+     * @brief Classifies the position without looking at its children
+     */
+    [[nodiscard]] Result initial() const {
+        const uint16_t promotion = m_pawn + 8;
+
+        if (distance(m_white_king, m_black_king) <= 1 ||
+            m_white_king == m_pawn || m_black_king == m_pawn ||
+            (m_white_to_move && pawn_attacks(m_pawn, m_black_king))) {
+            return INVALID;
+        }
+
+        if (m_white_to_move) {
+            // The pawn promotes and the queen can't be taken
+            if (rank_of(m_pawn) == 6 && m_white_king != promotion &&
+                m_black_king != promotion &&
+                (distance(m_black_king, promotion) > 1 ||
+                 distance(m_white_king, promotion) == 1)) {
+                return WIN;
+            }
+
+            return UNKNOWN;
+        }
+
+        bool can_move = false;
+
+        for_each_king_step(m_black_king, [&](uint16_t to) {
+            if (distance(to, m_white_king) > 1 && !pawn_attacks(m_pawn, to)) {
+                can_move = true;
+            }
+        });
+
+        // Stalemate, or the pawn falls
+        if (!can_move || (distance(m_black_king, m_pawn) == 1 &&
+                          distance(m_white_king, m_pawn) > 1)) {
+            return DRAW;
+        }
+
+        return UNKNOWN;
+    }
+
+    /**
+     * @brief Classifies the position from the results of its children
+     */
+    [[nodiscard]] Result classify(const std::vector<uint8_t> &results) const {
+        const Result good = m_white_to_move ? WIN : DRAW;
+        const Result bad = m_white_to_move ? DRAW : WIN;
+
+        uint8_t reachable = INVALID;
+
+        if (m_white_to_move) {
+            for_each_king_step(m_white_king, [&](uint16_t to) {
+                reachable |= results[index(false, m_black_king, to, m_pawn)];
+            });
+
+            if (rank_of(m_pawn) < 6) {
+                reachable |= results[index(false, m_black_king, m_white_king,
+                                           m_pawn + 8)];
+            }
+
+            if (rank_of(m_pawn) == 1 && m_pawn + 8 != m_white_king &&
+                m_pawn + 8 != m_black_king) {
+                reachable |= results[index(false, m_black_king, m_white_king,
+                                           m_pawn + 16)];
+            }
+        } else {
+            for_each_king_step(m_black_king, [&](uint16_t to) {
+                reachable |= results[index(true, to, m_white_king, m_pawn)];
+            });
+        }
+
+        if (reachable & good) {
+            return good;
+        }
+
+        return reachable & UNKNOWN ? UNKNOWN : bad;
+    }
+
+    template <typename Function>
+    static void for_each_king_step(uint16_t square, Function function) {
+        for (int16_t file_step = -1; file_step <= 1; file_step++) {
+            for (int16_t rank_step = -1; rank_step <= 1; rank_step++) {
+                const int16_t file = file_of(square) + file_step;
+                const int16_t rank = rank_of(square) + rank_step;
+
+                if ((file_step != 0 || rank_step != 0) && file >= 0 &&
+                    file < 8 && rank >= 0 && rank < 8) {
+                    function(static_cast<uint16_t>(rank * 8 + file));
+                }
+            }
+        }
+    }
+};
+}    // namespace
+
+[[nodiscard]] Kpk::table_t Kpk::generate() {
+    std::vector<uint8_t> results(MAX_INDEX);
+
+    for (uint32_t idx = 0; idx < MAX_INDEX; idx++) {
+        results[idx] = Position{idx}.initial();
+    }
+
+    // Iterate until no UNKNOWN position changes; what's left is a draw
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (uint32_t idx = 0; idx < MAX_INDEX; idx++) {
+            if (results[idx] == UNKNOWN) {
+                results[idx] = Position{idx}.classify(results);
+                changed |= results[idx] != UNKNOWN;
+            }
+        }
+    }
+
+    table_t table{};
+
+    for (uint32_t idx = 0; idx < MAX_INDEX; idx++) {
+        if (results[idx] == WIN) {
+            table[idx / 64] |= uint64_t{1} << (idx % 64);
+        }
+    }
+
+    return table;
+}
+
+[[nodiscard]] const Kpk::table_t &Kpk::table() {
+    static const table_t instance = generate();
+    return instance;
+}
+
+[[nodiscard]] bool Kpk::probe(uint16_t strong_king, uint16_t pawn,
+                              uint16_t weak_king, bool strong_to_move) {
+    const uint32_t idx = index(strong_to_move, weak_king, strong_king, pawn);
+
+    return (table()[idx / 64] >> (idx % 64)) & 1;
+}
+
+[[nodiscard]] std::optional<bool> Kpk::probe(const Board &board) {
+    int16_t pawn = Board::NO_SQUARE;
+    int16_t white_king = Board::NO_SQUARE;
+    int16_t black_king = Board::NO_SQUARE;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Board::piece_t piece = board.piece_at(square);
+
+        if (piece == Piece::NONE) {
+            continue;
+        }
+
+        if (piece == Piece::WHITE_KING) {
+            white_king = static_cast<int16_t>(square);
+        } else if (piece == Piece::BLACK_KING) {
+            black_king = static_cast<int16_t>(square);
+        } else if (Piece::type(piece) == Piece::PAWN &&
+                   pawn == Board::NO_SQUARE) {
+            pawn = static_cast<int16_t>(square);
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    if (pawn == Board::NO_SQUARE || white_king == Board::NO_SQUARE ||
+        black_king == Board::NO_SQUARE) {
+        return std::nullopt;
+    }
+
+    // Not a position the table covers, and outside its index range
+    if (rank_of(pawn) == 0 || rank_of(pawn) == 7) {
+        return std::nullopt;
+    }
+
+    const Board::piece_t strong = Piece::color(board.piece_at(pawn));
+    uint16_t strong_king = strong == Piece::WHITE ? white_king : black_king;
+    uint16_t weak_king = strong == Piece::WHITE ? black_king : white_king;
+    uint16_t pawn_square = pawn;
+
+    // Seen from the pawn side, with the pawn on the queenside
+    if (strong == Piece::BLACK) {
+        strong_king ^= 56;
+        weak_king ^= 56;
+        pawn_square ^= 56;
+    }
+
+    if (file_of(pawn_square) > 3) {
+        strong_king ^= 7;
+        weak_king ^= 7;
+        pawn_square ^= 7;
+    }
+
+    return probe(strong_king, pawn_square, weak_king, board.turn() == strong);
+}
+}    // namespace dreamchess
@@ -0,0 +1,96 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)},
+      m_open{std::exchange(other.m_open, false)} {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        close();
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+    }
+
+    return *this;
+}
+
+bool MappedFile::open(const std::string &path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_size = static_cast<std::size_t>(info.st_size);
+
+    if (m_size > 0) {
+        void *address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            m_size = 0;
+            return false;
+        }
+
+        m_data = static_cast<const uint8_t *>(address);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    m_open = true;
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data != nullptr) {
+        ::munmap(const_cast<uint8_t *>(m_data), m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+[[nodiscard]] bool MappedFile::is_open() const { return m_open; }
+
+[[nodiscard]] const uint8_t *MappedFile::data() const { return m_data; }
+
+[[nodiscard]] std::size_t MappedFile::size() const { return m_size; }
+}    // namespace dreamchess
@@ -16,13 +16,6 @@
  * @details Used to avoid the std namespace pollution
  */
 namespace dreamchess {
-
-const std::shared_ptr<std::regex> Move::m_move_regex{
-    std::make_shared<std::regex>("[a-h][1-8]-[a-h][1-8]")};
-
-const std::shared_ptr<std::regex> Move::m_promotion_regex{
-    std::make_shared<std::regex>("[a-h][1-8]-[a-h][1-8]=[r|R|n|N|b|B|q|Q]")};
-
 Move::Move(int64_t source, int64_t destination, Board::piece_t piece,
            Board::piece_t promotion_piece)
     : m_source{static_cast<int16_t>(source)},
@@ -40,10 +33,6 @@ Move::Move(int64_t source, int64_t destination, Board::piece_t piece,
     return m_promotion_piece;
 }
 
-[[nodiscard]] std::regex Move::move_regex() { return *m_move_regex; }
-
-[[nodiscard]] std::regex Move::promotion_regex() { return *m_promotion_regex; }
-
 [[nodiscard]] std::string Move::to_alg() const {
     uint16_t rem = m_destination % 8;
     uint16_t quot = m_destination / 8;
@@ -59,4 +48,26 @@ Move::Move(int64_t source, int64_t destination, Board::piece_t piece,
 
     return res;
 }
+
+[[nodiscard]] std::string Move::to_uci() const {
+    std::string res{static_cast<char>('a' + m_source % 8),
+                    static_cast<char>('1' + m_source / 8),
+                    static_cast<char>('a' + m_destination % 8),
+                    static_cast<char>('1' + m_destination / 8)};
+
+    if (m_promotion_piece != Piece::NONE) {
+        res.push_back(
+            Piece::to_fen(Piece::type(m_promotion_piece) | Piece::BLACK));
+    }
+
+    return res;
+}
+
+bool Move::operator==(const Move &other) const {
+    return m_source == other.m_source &&
+           m_destination == other.m_destination && m_piece == other.m_piece &&
+           m_promotion_piece == other.m_promotion_piece;
+}
+
+bool Move::operator!=(const Move &other) const { return !(*this == other); }
 }    // namespace dreamchess
\ No newline at end of file
@@ -0,0 +1,368 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "MoveGenerator.hpp"
+
+#include <utility>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @typedef Defines the step_t type, a (file, rank) offset
+ */
+using step_t = std::pair<int16_t, int16_t>;
+
+constexpr std::array<step_t, 8> KNIGHT_STEPS{
+    {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}}};
+
+constexpr std::array<step_t, 8> KING_STEPS{
+    {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}}};
+
+constexpr std::array<step_t, 4> BISHOP_STEPS{
+    {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+constexpr std::array<step_t, 4> ROOK_STEPS{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+
+constexpr std::array<Piece::Enum, 4> PROMOTIONS{Piece::QUEEN, Piece::ROOK,
+                                                Piece::BISHOP, Piece::KNIGHT};
+
+bool on_board(int16_t file, int16_t rank) {
+    return file >= 0 && file < 8 && rank >= 0 && rank < 8;
+}
+
+/**
+ * @brief Appends a pawn Move, expanding it into the four promotions when it
+ * reaches the last rank
+ */
+template <Piece::Enum US>
+void add_pawn_move(MoveList &moves, int16_t source, int16_t destination) {
+    constexpr Piece::Enum PAWN = Piece::PAWN | US;
+    constexpr int16_t LAST_RANK = US == Piece::WHITE ? 7 : 0;
+
+    if (destination / 8 == LAST_RANK) {
+        for (const auto &type : PROMOTIONS) {
+            moves.push_back(Move{source, destination, PAWN, type | US});
+        }
+    } else {
+        moves.push_back(Move{source, destination, PAWN, Piece::NONE});
+    }
+}
+}    // namespace
+
+void MoveGenerator::pseudo_legal(const Board &board, MoveList &moves) {
+    // Dispatched once, the specialized code never tests the color again
+    if (board.m_turn == Piece::WHITE) {
+        pseudo_legal_for<Piece::WHITE>(board, moves);
+    } else {
+        pseudo_legal_for<Piece::BLACK>(board, moves);
+    }
+}
+
+template <Piece::Enum US>
+void MoveGenerator::pseudo_legal_for(const Board &board, MoveList &moves) {
+    for (int16_t source = 0; source < 64; source++) {
+        const Board::piece_t piece = board.m_squares[source];
+
+        if (Piece::color(piece) != US) {
+            continue;
+        }
+
+        switch (Piece::type(piece)) {
+            case Piece::PAWN:
+                piece_moves<US, Piece::PAWN>(board, source, moves);
+                break;
+
+            case Piece::KNIGHT:
+                piece_moves<US, Piece::KNIGHT>(board, source, moves);
+                break;
+
+            case Piece::BISHOP:
+                piece_moves<US, Piece::BISHOP>(board, source, moves);
+                break;
+
+            case Piece::ROOK:
+                piece_moves<US, Piece::ROOK>(board, source, moves);
+                break;
+
+            case Piece::QUEEN:
+                piece_moves<US, Piece::QUEEN>(board, source, moves);
+                break;
+
+            case Piece::KING:
+                piece_moves<US, Piece::KING>(board, source, moves);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+template <Piece::Enum US, Piece::Enum TYPE>
+void MoveGenerator::piece_moves(const Board &board, int16_t source,
+                                MoveList &moves) {
+    constexpr Piece::Enum THEM =
+        US == Piece::WHITE ? Piece::BLACK : Piece::WHITE;
+    constexpr Board::piece_t PIECE = TYPE | US;
+
+    const Board::piece_array_t &squares = board.m_squares;
+
+    const auto add_steps = [&](const auto &steps) {
+        for (const auto &[file_step, rank_step] : steps) {
+            const int16_t file = source % 8 + file_step;
+            const int16_t rank = source / 8 + rank_step;
+
+            if (!on_board(file, rank)) {
+                continue;
+            }
+
+            const int16_t destination = rank * 8 + file;
+
+            if (Piece::color(squares[destination]) != US) {
+                moves.push_back(
+                    Move{source, destination, PIECE, Piece::NONE});
+            }
+        }
+    };
+
+    const auto add_rays = [&](const auto &steps) {
+        for (const auto &[file_step, rank_step] : steps) {
+            int16_t file = source % 8 + file_step;
+            int16_t rank = source / 8 + rank_step;
+
+            for (; on_board(file, rank); file += file_step, rank += rank_step) {
+                const int16_t destination = rank * 8 + file;
+                const Piece::Enum color = Piece::color(squares[destination]);
+
+                if (color == US) {
+                    break;
+                }
+
+                moves.push_back(Move{source, destination, PIECE, Piece::NONE});
+
+                if (color == THEM) {
+                    break;
+                }
+            }
+        }
+    };
+
+    if constexpr (TYPE == Piece::PAWN) {
+        constexpr int16_t FORWARD = US == Piece::WHITE ? 8 : -8;
+        constexpr int16_t START_RANK = US == Piece::WHITE ? 1 : 6;
+        const int16_t single = source + FORWARD;
+
+        if (squares[single] == Piece::NONE) {
+            add_pawn_move<US>(moves, source, single);
+
+            if (source / 8 == START_RANK &&
+                squares[single + FORWARD] == Piece::NONE) {
+                moves.push_back(
+                    Move{source, single + FORWARD, PIECE, Piece::NONE});
+            }
+        }
+
+        for (const int16_t file_step : {-1, 1}) {
+            if (!on_board(source % 8 + file_step, single / 8)) {
+                continue;
+            }
+
+            const int16_t destination = single + file_step;
+
+            if (Piece::color(squares[destination]) == THEM ||
+                destination == board.m_en_passant) {
+                add_pawn_move<US>(moves, source, destination);
+            }
+        }
+    } else if constexpr (TYPE == Piece::KNIGHT) {
+        add_steps(KNIGHT_STEPS);
+    } else if constexpr (TYPE == Piece::BISHOP) {
+        add_rays(BISHOP_STEPS);
+    } else if constexpr (TYPE == Piece::ROOK) {
+        add_rays(ROOK_STEPS);
+    } else if constexpr (TYPE == Piece::QUEEN) {
+        add_rays(BISHOP_STEPS);
+        add_rays(ROOK_STEPS);
+    } else {
+        constexpr bool WHITE = US == Piece::WHITE;
+        constexpr uint8_t KINGSIDE =
+            WHITE ? Board::WHITE_KINGSIDE : Board::BLACK_KINGSIDE;
+        constexpr uint8_t QUEENSIDE =
+            WHITE ? Board::WHITE_QUEENSIDE : Board::BLACK_QUEENSIDE;
+        constexpr Board::piece_t ROOK = Piece::ROOK | US;
+
+        add_steps(KING_STEPS);
+
+        if (source != (WHITE ? 4 : 60)) {
+            return;
+        }
+
+        if ((board.m_castling & KINGSIDE) &&
+            squares[source + 1] == Piece::NONE &&
+            squares[source + 2] == Piece::NONE &&
+            squares[source + 3] == ROOK && !attacked_by<THEM>(board, source) &&
+            !attacked_by<THEM>(board, source + 1)) {
+            moves.push_back(Move{source, source + 2, PIECE, Piece::NONE});
+        }
+
+        if ((board.m_castling & QUEENSIDE) &&
+            squares[source - 1] == Piece::NONE &&
+            squares[source - 2] == Piece::NONE &&
+            squares[source - 3] == Piece::NONE &&
+            squares[source - 4] == ROOK && !attacked_by<THEM>(board, source) &&
+            !attacked_by<THEM>(board, source - 1)) {
+            moves.push_back(Move{source, source - 2, PIECE, Piece::NONE});
+        }
+    }
+}
+
+void MoveGenerator::legal(const Board &board, MoveList &moves) {
+    MoveList candidates;
+    pseudo_legal(board, candidates);
+
+    for (const auto &move : candidates) {
+        if (leaves_king_safe(board, move)) {
+            moves.push_back(move);
+        }
+    }
+}
+
+[[nodiscard]] bool MoveGenerator::leaves_king_safe(const Board &board,
+                                                   const Move &move) {
+    Board next = board;
+    next.make_move(move);
+
+    const int16_t king = king_square(next, board.m_turn);
+
+    return king == Board::NO_SQUARE || !attacked(next, king, next.m_turn);
+}
+
+[[nodiscard]] bool MoveGenerator::is_legal(const Board &board,
+                                           const Move &move) {
+    MoveList moves;
+    legal(board, moves);
+
+    for (const auto &candidate : moves) {
+        if (candidate == move) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+[[nodiscard]] bool MoveGenerator::attacked(const Board &board, int16_t square,
+                                           Board::piece_t by) {
+    return by == Piece::WHITE ? attacked_by<Piece::WHITE>(board, square)
+                              : attacked_by<Piece::BLACK>(board, square);
+}
+
+template <Piece::Enum BY>
+[[nodiscard]] bool MoveGenerator::attacked_by(const Board &board,
+                                              int16_t square) {
+    const Board::piece_array_t &squares = board.m_squares;
+    const int16_t file = square % 8;
+    const int16_t rank = square / 8;
+
+    // Pawns attack from one rank behind, from their point of view
+    const int16_t pawn_rank = rank + (BY == Piece::WHITE ? -1 : 1);
+    constexpr Board::piece_t PAWN = Piece::PAWN | BY;
+
+    for (const int16_t file_step : {-1, 1}) {
+        if (on_board(file + file_step, pawn_rank) &&
+            squares[pawn_rank * 8 + file + file_step] == PAWN) {
+            return true;
+        }
+    }
+
+    const auto hit_by_step = [&](const auto &steps, Board::piece_t attacker) {
+        for (const auto &[file_step, rank_step] : steps) {
+            if (on_board(file + file_step, rank + rank_step) &&
+                squares[(rank + rank_step) * 8 + file + file_step] ==
+                    attacker) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    const auto hit_by_ray = [&](const auto &steps, Board::piece_t slider) {
+        constexpr Board::piece_t QUEEN = Piece::QUEEN | BY;
+
+        for (const auto &[file_step, rank_step] : steps) {
+            int16_t f = file + file_step;
+            int16_t r = rank + rank_step;
+
+            for (; on_board(f, r); f += file_step, r += rank_step) {
+                const Board::piece_t piece = squares[r * 8 + f];
+
+                if (piece == Piece::NONE) {
+                    continue;
+                }
+
+                if (piece == slider || piece == QUEEN) {
+                    return true;
+                }
+
+                break;
+            }
+        }
+
+        return false;
+    };
+
+    return hit_by_step(KNIGHT_STEPS, Piece::KNIGHT | BY) ||
+           hit_by_step(KING_STEPS, Piece::KING | BY) ||
+           hit_by_ray(BISHOP_STEPS, Piece::BISHOP | BY) ||
+           hit_by_ray(ROOK_STEPS, Piece::ROOK | BY);
+}
+
+[[nodiscard]] bool MoveGenerator::in_check(const Board &board) {
+    const int16_t king = king_square(board, board.m_turn);
+
+    return king != Board::NO_SQUARE &&
+           attacked(board, king, board.opponent_turn());
+}
+
+[[nodiscard]] int16_t MoveGenerator::king_square(const Board &board,
+                                                 Board::piece_t color) {
+    const Board::piece_t king = Piece::KING | color;
+
+    for (int16_t square = 0; square < 64; square++) {
+        if (board.m_squares[square] == king) {
+            return square;
+        }
+    }
+
+    return Board::NO_SQUARE;
+}
+
+[[nodiscard]] std::optional<Move> MoveGenerator::from_uci(
+    const Board &board, std::string_view uci) {
+    if (uci.size() < 4 || uci.size() > 5) {
+        return std::nullopt;
+    }
+
+    MoveList moves;
+    legal(board, moves);
+
+    for (const auto &move : moves) {
+        if (move.to_uci() == uci) {
+            return move;
+        }
+    }
+
+    return std::nullopt;
+}
+}    // namespace dreamchess
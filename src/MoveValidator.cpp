@@ -0,0 +1,498 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "MoveValidator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @typedef Defines the squares_t type, one bit per square with a1 as bit 0
+ */
+using squares_t = uint64_t;
+
+/**
+ * @typedef Defines the step_t type, a (file, rank) offset
+ */
+using step_t = std::pair<int16_t, int16_t>;
+
+constexpr std::array<step_t, 8> KNIGHT_STEPS{
+    {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}}};
+
+// The first four are diagonal, the others orthogonal
+constexpr std::array<step_t, 8> KING_STEPS{
+    {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+
+constexpr squares_t ALL_SQUARES{std::numeric_limits<squares_t>::max()};
+
+constexpr squares_t bit(int16_t square) { return squares_t{1} << square; }
+
+bool on_board(int16_t file, int16_t rank) {
+    return file >= 0 && file < 8 && rank >= 0 && rank < 8;
+}
+
+/**
+ * @brief Checks if a Piece slides along a direction of KING_STEPS
+ */
+bool slides(Board::piece_t piece, bool diagonal) {
+    const Piece::Traits &traits = Piece::traits(piece);
+
+    return diagonal ? traits.m_diagonal_slider : traits.m_orthogonal_slider;
+}
+
+/**
+ * @class Analysis
+ * @brief What a position tells about the legality of any Move in it
+ */
+class Analysis final {
+public:
+    /**
+     * @brief Analyses a position
+     * @param board The position
+     */
+    void analyse(const Board &board) {
+        m_us = board.turn();
+        m_them = board.opponent_turn();
+        m_king = Board::NO_SQUARE;
+        m_danger = 0;
+        m_evasions = ALL_SQUARES;
+        m_checkers = 0;
+        m_pinned = 0;
+
+        for (int16_t square = 0; square < 64; square++) {
+            if (board.piece_at(square) == (Piece::KING | m_us)) {
+                m_king = square;
+            }
+        }
+
+        for (int16_t square = 0; square < 64; square++) {
+            if (Piece::color(board.piece_at(square)) == m_them) {
+                add_attacks(board, square);
+            }
+        }
+
+        if (m_king != Board::NO_SQUARE) {
+            find_checks_and_pins(board);
+        }
+    }
+
+    /**
+     * @brief Checks a Move in the analysed position
+     * @param board The position
+     * @param move The Move
+     * @return true if the Move is legal, false otherwise
+     */
+    [[nodiscard]] bool is_legal(const Board &board, const Move &move) const {
+        if (!is_pseudo_legal(board, move)) {
+            return false;
+        }
+
+        const int16_t source = move.source();
+        const int16_t destination = move.destination();
+
+        if (source == m_king) {
+            return (m_danger & bit(destination)) == 0;
+        }
+
+        if (m_checkers > 1) {
+            return false;
+        }
+
+        // The captured pawn leaves the rank too, rare enough to play it
+        if (Piece::type(move.piece()) == Piece::PAWN &&
+            destination == board.en_passant()) {
+            return MoveGenerator::leaves_king_safe(board, move);
+        }
+
+        return (m_evasions & bit(destination)) != 0 &&
+               ((m_pinned & bit(source)) == 0 ||
+                (m_pin_rays[source] & bit(destination)) != 0);
+    }
+
+private:
+    Board::piece_t m_us{Piece::WHITE};
+    Board::piece_t m_them{Piece::BLACK};
+
+    /**
+     * @brief The own KING square, Board::NO_SQUARE if there is none
+     */
+    int16_t m_king{Board::NO_SQUARE};
+
+    /**
+     * @brief Squares the opponent attacks, seen through the own KING
+     */
+    squares_t m_danger{0};
+
+    /**
+     * @brief Destinations answering a single check, all squares otherwise
+     */
+    squares_t m_evasions{ALL_SQUARES};
+
+    /**
+     * @brief Number of Pieces giving check
+     */
+    uint16_t m_checkers{0};
+
+    /**
+     * @brief Own Pieces pinned to the KING
+     */
+    squares_t m_pinned{0};
+
+    /**
+     * @brief For a pinned Piece, the squares it can still move to
+     */
+    std::array<squares_t, 64> m_pin_rays{};
+
+    /**
+     * @brief Adds the squares attacked by an opponent Piece to m_danger
+     * @details The own KING doesn't block sliders, it can't step back along
+     * the line it is checked on
+     */
+    void add_attacks(const Board &board, int16_t square) {
+        const Board::piece_t piece = board.piece_at(square);
+        const int16_t file = square % 8;
+        const int16_t rank = square / 8;
+
+        const auto add_step = [&](int16_t file_step, int16_t rank_step) {
+            if (on_board(file + file_step, rank + rank_step)) {
+                m_danger |= bit((rank + rank_step) * 8 + file + file_step);
+            }
+        };
+
+        switch (Piece::type(piece)) {
+            case Piece::PAWN: {
+                const int16_t forward = m_them == Piece::WHITE ? 1 : -1;
+                add_step(-1, forward);
+                add_step(1, forward);
+                return;
+            }
+
+            case Piece::KNIGHT:
+                for (const auto &[file_step, rank_step] : KNIGHT_STEPS) {
+                    add_step(file_step, rank_step);
+                }
+
+                return;
+
+            case Piece::KING:
+                for (const auto &[file_step, rank_step] : KING_STEPS) {
+                    add_step(file_step, rank_step);
+                }
+
+                return;
+
+            default:
+                break;
+        }
+
+        for (std::size_t direction = 0; direction < KING_STEPS.size();
+             direction++) {
+            if (!slides(piece, direction < 4)) {
+                continue;
+            }
+
+            const auto [file_step, rank_step] = KING_STEPS[direction];
+            int16_t f = file + file_step;
+            int16_t r = rank + rank_step;
+
+            for (; on_board(f, r); f += file_step, r += rank_step) {
+                const int16_t target = r * 8 + f;
+                m_danger |= bit(target);
+
+                if (board.piece_at(target) != Piece::NONE &&
+                    target != m_king) {
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Looks for checking Pieces and pinned ones around the own KING
+     */
+    void find_checks_and_pins(const Board &board) {
+        const int16_t file = m_king % 8;
+        const int16_t rank = m_king / 8;
+        squares_t checks = 0;
+
+        const auto check = [&](squares_t squares) {
+            m_checkers++;
+            checks |= squares;
+        };
+
+        for (const auto &[file_step, rank_step] : KNIGHT_STEPS) {
+            const int16_t f = file + file_step;
+            const int16_t r = rank + rank_step;
+
+            if (on_board(f, r) &&
+                board.piece_at(r * 8 + f) == (Piece::KNIGHT | m_them)) {
+                check(bit(r * 8 + f));
+            }
+        }
+
+        // Pawns attack from one rank ahead, from our point of view
+        const int16_t pawn_rank = rank + (m_us == Piece::WHITE ? 1 : -1);
+
+        for (const int16_t file_step : {-1, 1}) {
+            if (on_board(file + file_step, pawn_rank) &&
+                board.piece_at(pawn_rank * 8 + file + file_step) ==
+                    (Piece::PAWN | m_them)) {
+                check(bit(pawn_rank * 8 + file + file_step));
+            }
+        }
+
+        for (std::size_t direction = 0; direction < KING_STEPS.size();
+             direction++) {
+            const auto [file_step, rank_step] = KING_STEPS[direction];
+            int16_t f = file + file_step;
+            int16_t r = rank + rank_step;
+            int16_t blocker = Board::NO_SQUARE;
+            squares_t ray = 0;
+
+            for (; on_board(f, r); f += file_step, r += rank_step) {
+                const Board::piece_t piece = board.piece_at(r * 8 + f);
+                ray |= bit(r * 8 + f);
+
+                if (piece == Piece::NONE) {
+                    continue;
+                }
+
+                if (Piece::color(piece) == m_us) {
+                    if (blocker != Board::NO_SQUARE) {
+                        break;
+                    }
+
+                    blocker = r * 8 + f;
+                    continue;
+                }
+
+                if (slides(piece, direction < 4)) {
+                    if (blocker == Board::NO_SQUARE) {
+                        check(ray);
+                    } else {
+                        m_pinned |= bit(blocker);
+                        m_pin_rays[blocker] = ray;
+                    }
+                }
+
+                break;
+            }
+        }
+
+        if (m_checkers > 0) {
+            m_evasions = m_checkers == 1 ? checks : 0;
+        }
+    }
+
+    /**
+     * @brief Checks that a Move follows the way its Piece moves, ignoring
+     * the KING safety as MoveGenerator::pseudo_legal() does
+     */
+    [[nodiscard]] bool is_pseudo_legal(const Board &board,
+                                       const Move &move) const {
+        const int16_t source = move.source();
+        const int16_t destination = move.destination();
+
+        if (source < 0 || source >= 64 || destination < 0 ||
+            destination >= 64) {
+            return false;
+        }
+
+        const Board::piece_t piece = board.piece_at(source);
+
+        if (piece != move.piece() || Piece::color(piece) != m_us ||
+            Piece::color(board.piece_at(destination)) == m_us) {
+            return false;
+        }
+
+        const int16_t file_step = destination % 8 - source % 8;
+        const int16_t rank_step = destination / 8 - source / 8;
+        const int16_t files = std::abs(file_step);
+        const int16_t ranks = std::abs(rank_step);
+        const Piece::Enum type = Piece::type(piece);
+
+        const bool promotes = type == Piece::PAWN &&
+                              (destination / 8 == 0 || destination / 8 == 7);
+        const Piece::Enum promotion = Piece::type(move.promotion_piece());
+
+        if (promotes
+                ? Piece::color(move.promotion_piece()) != m_us ||
+                      promotion == Piece::PAWN || promotion == Piece::KING
+                : move.promotion_piece() != Piece::NONE) {
+            return false;
+        }
+
+        // No Piece may stand between the source and the destination
+        const auto path_is_clear = [&]() {
+            const int16_t step = (rank_step > 0) - (rank_step < 0);
+            const int16_t offset = step * 8 + (file_step > 0) - (file_step < 0);
+
+            for (int16_t square = source + offset; square != destination;
+                 square += offset) {
+                if (board.piece_at(square) != Piece::NONE) {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        switch (type) {
+            case Piece::PAWN: {
+                const int16_t forward = m_us == Piece::WHITE ? 1 : -1;
+                const int16_t start_rank = m_us == Piece::WHITE ? 1 : 6;
+
+                if (files == 1) {
+                    return rank_step == forward &&
+                           (Piece::color(board.piece_at(destination)) ==
+                                m_them ||
+                            destination == board.en_passant());
+                }
+
+                return files == 0 &&
+                       board.piece_at(destination) == Piece::NONE &&
+                       (rank_step == forward ||
+                        (rank_step == 2 * forward &&
+                         source / 8 == start_rank && path_is_clear()));
+            }
+
+            case Piece::KNIGHT:
+                return files * ranks == 2;
+
+            case Piece::BISHOP:
+                return files == ranks && files != 0 && path_is_clear();
+
+            case Piece::ROOK:
+                return (files == 0) != (ranks == 0) && path_is_clear();
+
+            case Piece::QUEEN:
+                return (files == ranks || files == 0 || ranks == 0) &&
+                       path_is_clear();
+
+            case Piece::KING:
+                if (files <= 1 && ranks <= 1) {
+                    return true;
+                }
+
+                return ranks == 0 && files == 2 && can_castle(board, move);
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Checks the castling rights and the squares between the KING and
+     * the ROOK
+     */
+    [[nodiscard]] bool can_castle(const Board &board, const Move &move) const {
+        const bool white = m_us == Piece::WHITE;
+        const int16_t source = move.source();
+        const bool kingside = move.destination() > source;
+
+        if (source != (white ? 4 : 60)) {
+            return false;
+        }
+
+        const uint8_t right =
+            kingside ? (white ? Board::WHITE_KINGSIDE : Board::BLACK_KINGSIDE)
+                     : (white ? Board::WHITE_QUEENSIDE
+                              : Board::BLACK_QUEENSIDE);
+        const int16_t step = kingside ? 1 : -1;
+        const int16_t rook = kingside ? source + 3 : source - 4;
+
+        if ((board.castling_rights() & right) == 0 ||
+            board.piece_at(rook) != (Piece::ROOK | m_us)) {
+            return false;
+        }
+
+        for (int16_t square = source + step; square != rook; square += step) {
+            if (board.piece_at(square) != Piece::NONE) {
+                return false;
+            }
+        }
+
+        return (m_danger & (bit(source) | bit(source + step))) == 0;
+    }
+};
+}    // namespace
+
+MoveValidator::MoveValidator(uint16_t threads)
+    : m_threads{std::max<uint16_t>(threads, 1)} {}
+
+[[nodiscard]] MoveValidator::bitmap_t MoveValidator::validate(
+    const std::vector<Board> &positions,
+    const std::vector<Query> &queries) const {
+    bitmap_t bitmap((queries.size() + 63) / 64, 0);
+
+    // Every thread writes whole words of the bitmap
+    const auto work = [&](std::size_t first, std::size_t last) {
+        Analysis analysis;
+        std::size_t analysed = positions.size();
+
+        for (std::size_t i = first; i < last; i++) {
+            const Query &query = queries[i];
+
+            if (query.m_position >= positions.size()) {
+                continue;
+            }
+
+            const Board &board = positions[query.m_position];
+
+            if (query.m_position != analysed) {
+                analysis.analyse(board);
+                analysed = query.m_position;
+            }
+
+            if (analysis.is_legal(board, query.m_move)) {
+                bitmap[i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+    };
+
+    const std::size_t words = bitmap.size();
+
+    if (m_threads == 1 || words < 2) {
+        work(0, queries.size());
+        return bitmap;
+    }
+
+    const std::size_t chunk = (words + m_threads - 1) / m_threads * 64;
+    std::vector<std::thread> workers;
+
+    for (std::size_t first = 0; first < queries.size(); first += chunk) {
+        workers.emplace_back(work, first,
+                             std::min(queries.size(), first + chunk));
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    return bitmap;
+}
+
+[[nodiscard]] bool MoveValidator::is_set(const bitmap_t &bitmap,
+                                         std::size_t index) {
+    return index / 64 < bitmap.size() &&
+           (bitmap[index / 64] >> (index % 64) & 1) != 0;
+}
+}    // namespace dreamchess
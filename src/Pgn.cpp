@@ -0,0 +1,491 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Pgn.hpp"
+
+#include <array>
+#include <cctype>
+#include <cstdlib>
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief SAN letters of the pieces, pawns have none
+ */
+constexpr std::string_view LETTERS{"NBRQK"};
+
+/**
+ * @brief Piece types of the LETTERS
+ */
+constexpr std::array<Piece::Enum, 5> LETTER_TYPES{
+    Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN, Piece::KING};
+
+char letter(Piece::Enum type) {
+    for (std::size_t i = 0; i < LETTER_TYPES.size(); i++) {
+        if (LETTER_TYPES[i] == type) {
+            return LETTERS[i];
+        }
+    }
+
+    return ' ';
+}
+
+Piece::Enum letter_type(char symbol) {
+    const std::size_t found = LETTERS.find(symbol);
+
+    return found == std::string_view::npos ? Piece::NONE : LETTER_TYPES[found];
+}
+
+bool is_result(std::string_view token) {
+    return token == "*" || token == "1-0" || token == "0-1" ||
+           token == "1/2-1/2";
+}
+
+bool is_space(char symbol) {
+    return std::isspace(static_cast<unsigned char>(symbol)) != 0;
+}
+
+/**
+ * @brief Characters ending a movetext token
+ */
+bool is_delimiter(char symbol) {
+    return is_space(symbol) ||
+           std::string_view{"{}();[]"}.find(symbol) != std::string_view::npos;
+}
+
+/**
+ * @brief Returns the position after the character closing a comment, a tag
+ * or a rest of line
+ */
+std::size_t skip_to(std::string_view text, std::size_t position, char end) {
+    const std::size_t found = text.find(end, position);
+
+    return found == std::string_view::npos ? text.size() : found + 1;
+}
+
+/**
+ * @brief Returns the position after a variation, nested ones included
+ */
+std::size_t skip_variation(std::string_view text, std::size_t position) {
+    uint32_t depth = 0;
+
+    while (position < text.size()) {
+        switch (text[position]) {
+            case '(':
+                depth++;
+                break;
+            case ')':
+                if (--depth == 0) {
+                    return position + 1;
+                }
+                break;
+            case '{':
+                position = skip_to(text, position, '}') - 1;
+                break;
+            case ';':
+                position = skip_to(text, position, '\n') - 1;
+                break;
+            default:
+                break;
+        }
+
+        position++;
+    }
+
+    return text.size();
+}
+
+void write_tag(std::ostream &stream, std::string_view name,
+               std::string_view value) {
+    stream << '[' << name << " \"";
+
+    for (const char symbol : value) {
+        if (symbol == '\\' || symbol == '"') {
+            stream << '\\';
+        }
+
+        stream << symbol;
+    }
+
+    stream << "\"]\n";
+}
+}    // namespace
+
+[[nodiscard]] std::string Pgn::san(const Board &board, const Move &move) {
+    const Piece::Enum type = Piece::type(move.piece());
+    const int16_t source = move.source();
+    const int16_t destination = move.destination();
+
+    std::string result;
+
+    if (type == Piece::KING && std::abs(destination - source) == 2) {
+        result = destination > source ? "O-O" : "O-O-O";
+    } else {
+        const bool capture = board.piece_at(destination) != Piece::NONE ||
+                             (type == Piece::PAWN &&
+                              source % 8 != destination % 8);
+
+        if (type == Piece::PAWN) {
+            if (capture) {
+                result.push_back(static_cast<char>('a' + source % 8));
+            }
+        } else {
+            result.push_back(letter(type));
+
+            MoveList moves;
+            MoveGenerator::legal(board, moves);
+
+            bool ambiguous = false;
+            bool same_file = false;
+            bool same_rank = false;
+
+            for (const auto &other : moves) {
+                if (other.piece() == move.piece() &&
+                    other.destination() == destination &&
+                    other.source() != source) {
+                    ambiguous = true;
+                    same_file |= other.source() % 8 == source % 8;
+                    same_rank |= other.source() / 8 == source / 8;
+                }
+            }
+
+            if (ambiguous && (!same_file || same_rank)) {
+                result.push_back(static_cast<char>('a' + source % 8));
+            }
+
+            if (ambiguous && same_file) {
+                result.push_back(static_cast<char>('1' + source / 8));
+            }
+        }
+
+        if (capture) {
+            result.push_back('x');
+        }
+
+        result.push_back(static_cast<char>('a' + destination % 8));
+        result.push_back(static_cast<char>('1' + destination / 8));
+
+        if (move.promotion_piece() != Piece::NONE) {
+            result.push_back('=');
+            result.push_back(letter(Piece::type(move.promotion_piece())));
+        }
+    }
+
+    Board next = board;
+    next.make_move(move);
+
+    if (MoveGenerator::in_check(next)) {
+        MoveList replies;
+        MoveGenerator::legal(next, replies);
+        result.push_back(replies.size() == 0 ? '#' : '+');
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::optional<Move> Pgn::parse_san(const Board &board,
+                                                 std::string_view text) {
+    while (!text.empty() && std::string_view{"+#!?"}.find(text.back()) !=
+                                std::string_view::npos) {
+        text.remove_suffix(1);
+    }
+
+    Piece::Enum type = Piece::PAWN;
+    Piece::Enum promotion = Piece::NONE;
+    int16_t destination = Board::NO_SQUARE;
+    int16_t from_file = -1;
+    int16_t from_rank = -1;
+    int16_t castling = 0;
+
+    if (text == "O-O" || text == "0-0") {
+        castling = 2;
+    } else if (text == "O-O-O" || text == "0-0-0") {
+        castling = -2;
+    } else {
+        std::size_t first = 0;
+
+        if (!text.empty() && letter_type(text[0]) != Piece::NONE) {
+            type = letter_type(text[0]);
+            first = 1;
+        }
+
+        if (type == Piece::PAWN && text.size() > 2 &&
+            letter_type(text.back()) != Piece::NONE) {
+            promotion = letter_type(text.back());
+            text.remove_suffix(1);
+
+            if (text.back() == '=') {
+                text.remove_suffix(1);
+            }
+        }
+
+        if (text.size() < first + 2) {
+            return std::nullopt;
+        }
+
+        const char file = text[text.size() - 2];
+        const char rank = text[text.size() - 1];
+
+        if (file < 'a' || file > 'h' || rank < '1' || rank > '8') {
+            return std::nullopt;
+        }
+
+        destination = static_cast<int16_t>((rank - '1') * 8 + (file - 'a'));
+
+        for (std::size_t i = first; i < text.size() - 2; i++) {
+            if (text[i] >= 'a' && text[i] <= 'h') {
+                from_file = static_cast<int16_t>(text[i] - 'a');
+            } else if (text[i] >= '1' && text[i] <= '8') {
+                from_rank = static_cast<int16_t>(text[i] - '1');
+            } else if (text[i] != 'x' && text[i] != '-' && text[i] != ':') {
+                return std::nullopt;
+            }
+        }
+    }
+
+    MoveList moves;
+    MoveGenerator::pseudo_legal(board, moves);
+
+    std::optional<Move> found;
+
+    for (const auto &move : moves) {
+        if (castling != 0) {
+            if (Piece::type(move.piece()) != Piece::KING ||
+                move.destination() - move.source() != castling) {
+                continue;
+            }
+        } else if (Piece::type(move.piece()) != type ||
+                   move.destination() != destination ||
+                   (from_file >= 0 && move.source() % 8 != from_file) ||
+                   (from_rank >= 0 && move.source() / 8 != from_rank) ||
+                   Piece::type(move.promotion_piece()) != promotion) {
+            continue;
+        }
+
+        if (!MoveGenerator::leaves_king_safe(board, move)) {
+            continue;
+        }
+
+        // Ambiguous
+        if (found) {
+            return std::nullopt;
+        }
+
+        found = move;
+    }
+
+    return found;
+}
+
+[[nodiscard]] std::string_view Pgn::result(const Board &board) {
+    MoveList moves;
+    MoveGenerator::legal(board, moves);
+
+    if (moves.size() != 0) {
+        return "*";
+    }
+
+    if (!MoveGenerator::in_check(board)) {
+        return "1/2-1/2";
+    }
+
+    return board.turn() == Piece::WHITE ? "0-1" : "1-0";
+}
+
+void Pgn::write(std::ostream &stream, const Tags &tags, const Board &board,
+                const History &history) {
+    const std::string_view game_result =
+        tags.m_result.empty() ? result(board) : tags.m_result;
+
+    write_tag(stream, "Event", tags.m_event);
+    write_tag(stream, "Site", tags.m_site);
+    write_tag(stream, "Date", tags.m_date);
+    write_tag(stream, "Round", tags.m_round);
+    write_tag(stream, "White", tags.m_white);
+    write_tag(stream, "Black", tags.m_black);
+    write_tag(stream, "Result", game_result);
+
+    Board position = history.position(board, 0);
+    const std::string start = position.fen();
+
+    if (start != Board::START_FEN) {
+        write_tag(stream, "SetUp", "1");
+        write_tag(stream, "FEN", start);
+    }
+
+    stream << '\n';
+
+    std::string line;
+    line.reserve(LINE_LENGTH + 1);
+
+    const auto add = [&stream, &line](std::string_view token) {
+        if (!line.empty() && line.size() + 1 + token.size() > LINE_LENGTH) {
+            line.push_back('\n');
+            stream << line;
+            line.clear();
+        }
+
+        if (!line.empty()) {
+            line.push_back(' ');
+        }
+
+        line.append(token);
+    };
+
+    for (std::size_t ply = 0; ply < history.size(); ply++) {
+        const Move move = history.move(ply);
+
+        if (position.turn() == Piece::WHITE) {
+            add(std::to_string(position.fullmove_number()) + ".");
+        } else if (ply == 0) {
+            add(std::to_string(position.fullmove_number()) + "...");
+        }
+
+        add(san(position, move));
+        position.make_move(move);
+    }
+
+    add(game_result);
+    line.append("\n\n");
+    stream << line;
+}
+
+[[nodiscard]] std::string_view Pgn::tag(std::string_view game,
+                                        std::string_view name) {
+    std::size_t position = 0;
+
+    while (position < game.size()) {
+        while (position < game.size() && is_space(game[position])) {
+            position++;
+        }
+
+        if (position == game.size() || game[position] != '[') {
+            break;
+        }
+
+        const std::size_t end = skip_to(game, position, ']');
+        const std::string_view line = game.substr(position + 1,
+                                                  end - position - 2);
+        position = end;
+
+        if (line.substr(0, name.size()) != name ||
+            line.size() == name.size() || !is_space(line[name.size()])) {
+            continue;
+        }
+
+        const std::size_t open = line.find('"');
+        const std::size_t close = line.rfind('"');
+
+        if (open != std::string_view::npos && close > open) {
+            return line.substr(open + 1, close - open - 1);
+        }
+    }
+
+    return {};
+}
+
+[[nodiscard]] std::optional<uint32_t> Pgn::replay(std::string_view game,
+                                                  Board &board,
+                                                  const visitor_t &visit) {
+    const std::string_view fen = tag(game, "FEN");
+
+    if (fen.empty()) {
+        board = Board::start_position();
+    } else if (!board.load_fen(fen)) {
+        return std::nullopt;
+    }
+
+    uint32_t plies = 0;
+    std::size_t position = 0;
+
+    while (position < game.size()) {
+        switch (game[position]) {
+            case '[':
+                position = skip_to(game, position, ']');
+                continue;
+            case '{':
+                position = skip_to(game, position, '}');
+                continue;
+            case ';':
+            case '%':
+                position = skip_to(game, position, '\n');
+                continue;
+            case '(':
+                position = skip_variation(game, position);
+                continue;
+            default:
+                break;
+        }
+
+        if (is_delimiter(game[position])) {
+            position++;
+            continue;
+        }
+
+        const std::size_t start = position;
+
+        while (position < game.size() && !is_delimiter(game[position])) {
+            position++;
+        }
+
+        std::string_view token = game.substr(start, position - start);
+
+        if (is_result(token)) {
+            break;
+        }
+
+        if (token[0] == '$') {
+            continue;
+        }
+
+        // Move numbers, possibly glued to the move
+        std::size_t digits = 0;
+
+        while (digits < token.size() &&
+               std::isdigit(static_cast<unsigned char>(token[digits]))) {
+            digits++;
+        }
+
+        if (digits == token.size()) {
+            continue;
+        }
+
+        if (digits > 0 && token[digits] == '.') {
+            const std::size_t first = token.find_first_not_of('.', digits);
+            token.remove_prefix(first == std::string_view::npos ? token.size()
+                                                                : first);
+
+            if (token.empty()) {
+                continue;
+            }
+        }
+
+        const std::optional<Move> move = parse_san(board, token);
+
+        if (!move) {
+            return std::nullopt;
+        }
+
+        if (visit) {
+            visit(board, *move);
+        }
+
+        board.make_move(*move);
+        plies++;
+    }
+
+    return plies;
+}
+}    // namespace dreamchess
@@ -0,0 +1,178 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "PgnPipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "BoundedQueue.hpp"
+#include "Pgn.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+PgnPipeline::PgnPipeline(uint16_t workers, std::size_t queue_capacity,
+                         std::size_t chunk_bytes)
+    : m_workers{std::max<uint16_t>(1, workers)},
+      m_queue_capacity{queue_capacity == 0 ? 2 * m_workers : queue_capacity},
+      m_chunk_bytes{chunk_bytes} {}
+
+PgnReader::Statistics PgnPipeline::run(std::string_view text,
+                                       const sink_t &sink) const {
+    using clock = std::chrono::steady_clock;
+
+    const auto start = clock::now();
+
+    BoundedQueue<Chunk> chunks{m_queue_capacity};
+    BoundedQueue<Replayed> replayed{m_queue_capacity};
+
+    // Chunks split but not handed to the sink yet: both queues and one in
+    // the hands of each worker. The splitter waits for the sink beyond that
+    const uint64_t window = 2 * m_queue_capacity + m_workers;
+    std::mutex delivered_mutex;
+    std::condition_variable delivered_changed;
+    uint64_t delivered = 0;
+
+    std::thread splitter{[this, text, window, &chunks, &delivered_mutex,
+                          &delivered_changed, &delivered] {
+        Chunk chunk;
+        uint64_t games = 0;
+        std::size_t bytes = 0;
+        std::size_t offset = 0;
+
+        const auto flush = [&] {
+            {
+                std::unique_lock<std::mutex> lock{delivered_mutex};
+                delivered_changed.wait(lock, [&] {
+                    return chunk.m_sequence < delivered + window;
+                });
+            }
+
+            games += chunk.m_games.size();
+            chunks.push(std::move(chunk));
+
+            chunk = Chunk{};
+            bytes = 0;
+        };
+
+        uint64_t sequence = 0;
+
+        while (true) {
+            while (offset < text.size() &&
+                   (text[offset] == ' ' || text[offset] == '\n' ||
+                    text[offset] == '\r' || text[offset] == '\t')) {
+                offset++;
+            }
+
+            if (offset == text.size()) {
+                break;
+            }
+
+            if (chunk.m_games.empty()) {
+                chunk.m_sequence = sequence++;
+                chunk.m_first_game = games;
+            }
+
+            const std::size_t length =
+                PgnReader::game_length(text.substr(offset));
+            chunk.m_games.push_back(text.substr(offset, length));
+            offset += length;
+            bytes += length;
+
+            if (bytes >= m_chunk_bytes) {
+                flush();
+            }
+        }
+
+        if (!chunk.m_games.empty()) {
+            flush();
+        }
+
+        chunks.close();
+    }};
+
+    std::atomic<uint16_t> running{m_workers};
+    std::vector<std::thread> workers;
+
+    for (uint16_t worker = 0; worker < m_workers; worker++) {
+        workers.emplace_back([&chunks, &replayed, &running] {
+            for (auto chunk = chunks.pop(); chunk; chunk = chunks.pop()) {
+                Replayed output{chunk->m_sequence, {}};
+                output.m_results.resize(chunk->m_games.size());
+
+                for (std::size_t i = 0; i < chunk->m_games.size(); i++) {
+                    Result &result = output.m_results[i];
+
+                    result.m_index = chunk->m_first_game + i;
+                    result.m_game = chunk->m_games[i];
+                    result.m_plies = Pgn::replay(result.m_game, result.m_board);
+                }
+
+                replayed.push(std::move(output));
+            }
+
+            if (--running == 0) {
+                replayed.close();
+            }
+        });
+    }
+
+    // Chunks finished out of order wait in pending, at most window of them
+    PgnReader::Statistics statistics;
+    std::map<uint64_t, std::vector<Result>> pending;
+    uint64_t next = 0;
+
+    for (auto output = replayed.pop(); output; output = replayed.pop()) {
+        pending.emplace(output->m_sequence, std::move(output->m_results));
+
+        while (!pending.empty() && pending.begin()->first == next) {
+            for (const auto &result : pending.begin()->second) {
+                statistics.m_games++;
+                statistics.m_plies += result.m_plies.value_or(0);
+                statistics.m_errors += !result.m_plies;
+
+                if (sink) {
+                    sink(result);
+                }
+            }
+
+            pending.erase(pending.begin());
+            next++;
+
+            {
+                const std::lock_guard<std::mutex> lock{delivered_mutex};
+                delivered = next;
+            }
+
+            delivered_changed.notify_one();
+        }
+    }
+
+    splitter.join();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    statistics.m_bytes = text.size();
+    statistics.m_seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+
+    return statistics;
+}
+}    // namespace dreamchess
@@ -0,0 +1,122 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "PgnReader.hpp"
+
+#include <chrono>
+#include <cstring>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+bool PgnReader::open(const std::string &path) {
+    m_offset = 0;
+
+    return m_file.open(path);
+}
+
+void PgnReader::rewind() { m_offset = 0; }
+
+[[nodiscard]] std::optional<std::string_view> PgnReader::next() {
+    const std::string_view all = text();
+
+    while (m_offset < all.size() &&
+           (all[m_offset] == ' ' || all[m_offset] == '\n' ||
+            all[m_offset] == '\r' || all[m_offset] == '\t')) {
+        m_offset++;
+    }
+
+    if (m_offset == all.size()) {
+        return std::nullopt;
+    }
+
+    const std::string_view game =
+        all.substr(m_offset, game_length(all.substr(m_offset)));
+    m_offset += game.size();
+
+    return game;
+}
+
+[[nodiscard]] std::string_view PgnReader::text() const {
+    return std::string_view{reinterpret_cast<const char *>(m_file.data()),
+                            m_file.size()};
+}
+
+PgnReader::Statistics PgnReader::replay_all(const Pgn::visitor_t &visit) {
+    using clock = std::chrono::steady_clock;
+
+    Statistics statistics;
+    Board board{};
+    const std::size_t first = m_offset;
+    const auto start = clock::now();
+
+    for (auto game = next(); game; game = next()) {
+        const std::optional<uint32_t> plies = Pgn::replay(*game, board, visit);
+
+        statistics.m_games++;
+        statistics.m_plies += plies.value_or(0);
+        statistics.m_errors += !plies;
+    }
+
+    statistics.m_bytes = m_offset - first;
+    statistics.m_seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+
+    return statistics;
+}
+
+[[nodiscard]] std::size_t PgnReader::game_length(std::string_view text) {
+    bool movetext = false;
+    bool comment = false;
+    std::size_t position = 0;
+
+    while (position < text.size()) {
+        const char *line = text.data() + position;
+        const auto *newline = static_cast<const char *>(
+            std::memchr(line, '\n', text.size() - position));
+        const std::size_t length =
+            newline == nullptr ? text.size() - position
+                               : static_cast<std::size_t>(newline - line);
+
+        if (!comment && line[0] == '[') {
+            if (movetext) {
+                return position;
+            }
+        } else {
+            for (std::size_t i = 0; i < length; i++) {
+                if (comment) {
+                    comment = line[i] != '}';
+                } else if (line[i] == '{') {
+                    comment = true;
+                } else if (line[i] == ';') {
+                    break;
+                } else if (line[i] != ' ' && line[i] != '\r' &&
+                           line[i] != '\t') {
+                    movetext = true;
+                }
+            }
+        }
+
+        position += length + 1;
+    }
+
+    return text.size();
+}
+
+[[nodiscard]] double PgnReader::Statistics::games_per_second() const {
+    return m_seconds > 0 ? static_cast<double>(m_games) / m_seconds : 0;
+}
+
+[[nodiscard]] double PgnReader::Statistics::megabytes_per_second() const {
+    return m_seconds > 0 ? static_cast<double>(m_bytes) / 1e6 / m_seconds
+                         : 0;
+}
+}    // namespace dreamchess
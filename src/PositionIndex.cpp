@@ -0,0 +1,128 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "PositionIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#include "Zobrist.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+static_assert(sizeof(PositionIndex::Entry) == 16,
+              "Entries are mapped in place");
+
+bool PositionIndex::Entry::operator<(const Entry &other) const {
+    return std::tie(m_key, m_game, m_ply) <
+           std::tie(other.m_key, other.m_game, other.m_ply);
+}
+
+bool PositionIndex::open(const std::string &path) {
+    close();
+
+    if (!m_file.open(path) || m_file.size() < HEADER_SIZE ||
+        std::string_view{reinterpret_cast<const char *>(m_file.data()),
+                         MAGIC.size()} != MAGIC) {
+        close();
+        return false;
+    }
+
+    uint16_t version = 0;
+    uint16_t bits = 0;
+    uint64_t size = 0;
+    std::memcpy(&version, m_file.data() + 4, sizeof(version));
+    std::memcpy(&bits, m_file.data() + 6, sizeof(bits));
+    std::memcpy(&size, m_file.data() + 8, sizeof(size));
+
+    const uint64_t buckets = (uint64_t{1} << std::min<uint16_t>(bits, 24)) + 1;
+
+    // The entries must fill the rest of the file
+    if (version != VERSION || bits > 24 ||
+        (m_file.size() - HEADER_SIZE) / sizeof(Entry) < size ||
+        m_file.size() !=
+            HEADER_SIZE + buckets * sizeof(uint64_t) + size * sizeof(Entry)) {
+        close();
+        return false;
+    }
+
+    m_bits = bits;
+    m_buckets = reinterpret_cast<const uint64_t *>(m_file.data() + HEADER_SIZE);
+    m_entries = reinterpret_cast<const Entry *>(m_buckets + buckets);
+    m_size = size;
+
+    if (m_buckets[buckets - 1] != m_size) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void PositionIndex::close() {
+    m_file.close();
+    m_bits = 0;
+    m_buckets = nullptr;
+    m_entries = nullptr;
+    m_size = 0;
+}
+
+[[nodiscard]] std::size_t PositionIndex::size() const { return m_size; }
+
+[[nodiscard]] const PositionIndex::Entry *PositionIndex::entries() const {
+    return m_entries;
+}
+
+[[nodiscard]] std::pair<const PositionIndex::Entry *,
+                        const PositionIndex::Entry *>
+PositionIndex::find(uint64_t key) const {
+    if (m_size == 0) {
+        return {m_entries, m_entries};
+    }
+
+    const uint64_t bucket = m_bits == 0 ? 0 : key >> (64 - m_bits);
+
+    // Clamped, a corrupted bucket can't lead outside the mapping
+    const uint64_t first = std::min<uint64_t>(m_buckets[bucket], m_size);
+    const uint64_t last =
+        std::clamp<uint64_t>(m_buckets[bucket + 1], first, m_size);
+
+    const auto by_key = [](const Entry &entry, uint64_t value) {
+        return entry.m_key < value;
+    };
+    const auto key_below = [](uint64_t value, const Entry &entry) {
+        return value < entry.m_key;
+    };
+
+    const Entry *begin =
+        std::lower_bound(m_entries + first, m_entries + last, key, by_key);
+
+    return {begin, std::upper_bound(begin, m_entries + last, key, key_below)};
+}
+
+[[nodiscard]] std::pair<const PositionIndex::Entry *,
+                        const PositionIndex::Entry *>
+PositionIndex::find(const Board &board) const {
+    return find(Zobrist::key(board));
+}
+
+[[nodiscard]] uint16_t PositionIndex::bucket_bits(std::size_t entries) {
+    uint16_t bits = 0;
+
+    while (bits < 24 && (entries >> (bits + 6)) != 0) {
+        bits++;
+    }
+
+    return bits;
+}
+}    // namespace dreamchess
@@ -0,0 +1,219 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "PositionIndexBuilder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "Zobrist.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Entries written at once
+ */
+constexpr std::size_t WRITE_BATCH{4096};
+
+/**
+ * @brief Returns true if two entries are the same
+ */
+bool same(const PositionIndex::Entry &lhs, const PositionIndex::Entry &rhs) {
+    return lhs.m_key == rhs.m_key && lhs.m_game == rhs.m_game &&
+           lhs.m_ply == rhs.m_ply;
+}
+}    // namespace
+
+PositionIndexBuilder::PositionIndexBuilder(uint16_t threads)
+    : m_threads{std::max<uint16_t>(1, threads)} {}
+
+bool PositionIndexBuilder::build(const GameStore &store,
+                                 const std::string &path,
+                                 std::size_t first) const {
+    using Entry = PositionIndex::Entry;
+
+    const std::size_t games = store.size() > first ? store.size() - first : 0;
+    const std::size_t chunk = (games + m_threads - 1) / m_threads;
+    std::vector<std::vector<Entry>> found(m_threads);
+
+    const auto work = [&store, &found](uint16_t thread, std::size_t begin,
+                                       std::size_t end) {
+        std::vector<Entry> &entries = found[thread];
+        Board board{};
+
+        for (std::size_t game = begin; game < end; game++) {
+            const std::size_t mark = entries.size();
+            const auto number = static_cast<uint32_t>(game);
+            uint32_t ply = 0;
+
+            const auto plies = store.replay(
+                game, board,
+                [&entries, number, &ply](const Board &position, const Move &) {
+                    entries.push_back({Zobrist::key(position), number, ply++});
+                });
+
+            // A malformed game leaves nothing behind
+            if (plies) {
+                entries.push_back({Zobrist::key(board), number, *plies});
+            } else {
+                entries.resize(mark);
+            }
+        }
+
+        std::sort(entries.begin(), entries.end());
+    };
+
+    if (m_threads == 1) {
+        work(0, first, first + games);
+    } else {
+        std::vector<std::thread> workers;
+
+        for (uint16_t thread = 0; thread < m_threads; thread++) {
+            const std::size_t begin = first + thread * chunk;
+
+            if (begin >= first + games) {
+                break;
+            }
+
+            workers.emplace_back(work, thread, begin,
+                                 std::min(first + games, begin + chunk));
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::vector<run_t> runs;
+
+    for (const auto &entries : found) {
+        runs.emplace_back(entries.data(), entries.data() + entries.size());
+    }
+
+    return write(std::move(runs), path);
+}
+
+bool PositionIndexBuilder::merge(const std::vector<std::string> &inputs,
+                                 const std::string &path) {
+    std::vector<PositionIndex> indices(inputs.size());
+    std::vector<run_t> runs;
+
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        if (!indices[i].open(inputs[i])) {
+            return false;
+        }
+
+        runs.emplace_back(indices[i].entries(),
+                          indices[i].entries() + indices[i].size());
+    }
+
+    return write(std::move(runs), path);
+}
+
+bool PositionIndexBuilder::write(std::vector<run_t> runs,
+                                 const std::string &path) {
+    using Entry = PositionIndex::Entry;
+
+    // Few runs, one per thread or per input: a linear scan beats a heap
+    const auto for_each_entry = [](std::vector<run_t> sources,
+                                   const auto &visit) {
+        const Entry *previous = nullptr;
+
+        for (;;) {
+            run_t *smallest = nullptr;
+
+            for (auto &run : sources) {
+                if (run.first != run.second &&
+                    (smallest == nullptr || *run.first < *smallest->first)) {
+                    smallest = &run;
+                }
+            }
+
+            if (smallest == nullptr) {
+                break;
+            }
+
+            const Entry *entry = smallest->first++;
+
+            if (previous == nullptr || !same(*previous, *entry)) {
+                visit(*entry);
+            }
+
+            previous = entry;
+        }
+    };
+
+    // Counted first, the size of the buckets depends on the unique entries
+    uint64_t total = 0;
+    for_each_entry(runs, [&total](const Entry &) { total++; });
+
+    const uint16_t bits = PositionIndex::bucket_bits(total);
+    std::vector<uint64_t> buckets((std::size_t{1} << bits) + 1, total);
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+
+    if (!file) {
+        return false;
+    }
+
+    file.seekp(static_cast<std::streamoff>(PositionIndex::HEADER_SIZE +
+                                           buckets.size() * sizeof(uint64_t)));
+
+    std::vector<Entry> batch;
+    batch.reserve(WRITE_BATCH);
+
+    uint64_t written = 0;
+    uint64_t next_bucket = 0;
+
+    for_each_entry(std::move(runs), [&](const Entry &entry) {
+        const uint64_t bucket = bits == 0 ? 0 : entry.m_key >> (64 - bits);
+
+        while (next_bucket <= bucket) {
+            buckets[next_bucket++] = written;
+        }
+
+        batch.push_back(entry);
+        written++;
+
+        if (batch.size() == WRITE_BATCH) {
+            file.write(reinterpret_cast<const char *>(batch.data()),
+                       static_cast<std::streamsize>(batch.size() *
+                                                    sizeof(Entry)));
+            batch.clear();
+        }
+    });
+
+    file.write(reinterpret_cast<const char *>(batch.data()),
+               static_cast<std::streamsize>(batch.size() * sizeof(Entry)));
+
+    std::array<char, PositionIndex::HEADER_SIZE> header{};
+    std::memcpy(header.data(), PositionIndex::MAGIC.data(),
+                PositionIndex::MAGIC.size());
+    std::memcpy(header.data() + 4, &PositionIndex::VERSION,
+                sizeof(PositionIndex::VERSION));
+    std::memcpy(header.data() + 6, &bits, sizeof(bits));
+    std::memcpy(header.data() + 8, &total, sizeof(total));
+
+    file.seekp(0);
+    file.write(header.data(), header.size());
+    file.write(reinterpret_cast<const char *>(buckets.data()),
+               static_cast<std::streamsize>(buckets.size() *
+                                            sizeof(uint64_t)));
+    file.close();
+
+    return static_cast<bool>(file);
+}
+}    // namespace dreamchess
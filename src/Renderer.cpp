@@ -0,0 +1,119 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Renderer.hpp"
+
+#include <array>
+#include <charconv>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Moves the cursor home and clears the screen
+ */
+constexpr std::string_view CLEAR_SCREEN{"\x1b[H\x1b[2J"};
+
+/**
+ * @brief Clears from the cursor to the end of the screen
+ */
+constexpr std::string_view CLEAR_BELOW{"\x1b[J"};
+
+/**
+ * @brief Every square takes a glyph and a space
+ */
+constexpr uint16_t SQUARE_WIDTH{2};
+
+void append_square(std::string &frame, Board::piece_t piece) {
+    frame.append(Piece::unicode_representation(piece));
+    frame.push_back(' ');
+}
+}    // namespace
+
+Renderer::Renderer(std::ostream &stream, bool ansi)
+    : m_stream{stream}, m_ansi{ansi} {}
+
+void Renderer::draw(const Board &board) {
+    m_frame.clear();
+
+    if (m_ansi && m_drawn) {
+        changes_frame(board);
+    } else {
+        full_frame(board);
+    }
+
+    m_stream.write(m_frame.data(),
+                   static_cast<std::streamsize>(m_frame.size()));
+    m_stream.flush();
+}
+
+void Renderer::invalidate() { m_drawn = false; }
+
+[[nodiscard]] const std::string &Renderer::frame() const { return m_frame; }
+
+void Renderer::full_frame(const Board &board) {
+    if (m_ansi) {
+        m_frame.append(CLEAR_SCREEN);
+    }
+
+    m_frame.append(SEPARATOR).push_back('\n');
+
+    for (uint16_t square = 0; square < 64; square++) {
+        append_square(m_frame, board.piece_at(square));
+
+        if ((square + 1) % 8 == 0) {
+            m_frame.push_back('\n');
+        }
+
+        m_last[square] = board.piece_at(square);
+    }
+
+    m_frame.append(SEPARATOR).push_back('\n');
+    m_drawn = true;
+}
+
+void Renderer::changes_frame(const Board &board) {
+    // Where the cursor is after the last written square, if on the Board
+    int32_t cursor = -1;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Board::piece_t piece = board.piece_at(square);
+
+        if (piece == m_last[square]) {
+            continue;
+        }
+
+        if (cursor != square || square % 8 == 0) {
+            move_to(BOARD_ROW + square / 8, 1 + square % 8 * SQUARE_WIDTH);
+        }
+
+        append_square(m_frame, piece);
+        m_last[square] = piece;
+        cursor = square + 1;
+    }
+
+    move_to(PROMPT_ROW, 1);
+    m_frame.append(CLEAR_BELOW);
+}
+
+void Renderer::move_to(uint16_t row, uint16_t column) {
+    std::array<char, 16> buffer{'\x1b', '['};
+    char *end = std::to_chars(buffer.data() + 2,
+                              buffer.data() + buffer.size(), row)
+                    .ptr;
+    *end++ = ';';
+    end = std::to_chars(end, buffer.data() + buffer.size(), column).ptr;
+    *end++ = 'H';
+
+    m_frame.append(buffer.data(), end);
+}
+}    // namespace dreamchess
@@ -0,0 +1,68 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "RepetitionTable.hpp"
+
+#include "Zobrist.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Returns the filter slot of a key
+ */
+std::size_t slot(uint64_t key) {
+    return static_cast<std::size_t>(key) & (RepetitionTable::FILTER_SIZE - 1);
+}
+}    // namespace
+
+RepetitionTable::RepetitionTable(const Board &board) { push(board); }
+
+void RepetitionTable::clear() {
+    // The window is short, cheaper than wiping the whole filter
+    for (const auto &entry : m_window) {
+        m_filter[slot(entry.m_key)]--;
+    }
+
+    m_window.clear();
+}
+
+void RepetitionTable::push(const Board &board) {
+    if (board.halfmove_clock() == 0) {
+        clear();
+    }
+
+    const uint64_t key = Zobrist::key(board);
+    uint16_t count = 1;
+
+    // The same side moves every two plies, the other positions can't match
+    if (m_filter[slot(key)] != 0) {
+        for (std::size_t i = m_window.size(); i >= 2; i -= 2) {
+            if (m_window[i - 2].m_key == key) {
+                count = m_window[i - 2].m_count + 1;
+                break;
+            }
+        }
+    }
+
+    m_filter[slot(key)]++;
+    m_window.push_back({key, count});
+}
+
+[[nodiscard]] uint16_t RepetitionTable::repetitions() const {
+    return m_window.empty() ? 0 : m_window.back().m_count;
+}
+
+[[nodiscard]] std::size_t RepetitionTable::size() const {
+    return m_window.size();
+}
+}    // namespace dreamchess
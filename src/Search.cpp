@@ -0,0 +1,518 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Search.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Endgame.hpp"
+#include "Evaluation.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Half width of the first aspiration window, in centipawns
+ */
+constexpr int32_t ASPIRATION_WINDOW{50};
+
+/**
+ * @brief First iteration searched with an aspiration window, the scores of
+ * shallower ones are too unstable
+ */
+constexpr int16_t ASPIRATION_DEPTH{4};
+
+/**
+ * @brief Legal Moves searched at full depth before the reductions start
+ */
+constexpr uint16_t LATE_MOVES{3};
+
+/**
+ * @brief Futility margins by remaining depth, in centipawns
+ */
+constexpr std::array<int32_t, 4> FUTILITY_MARGINS{0, 200, 300, 500};
+
+/**
+ * @brief Razoring margins by remaining depth, in centipawns
+ */
+constexpr std::array<int32_t, 3> RAZOR_MARGINS{0, 300, 550};
+
+bool is_capture(const Board &board, const Move &move) {
+    return board.piece_at(move.destination()) != Piece::NONE ||
+           (Piece::type(move.piece()) == Piece::PAWN &&
+            move.destination() == board.en_passant());
+}
+
+/**
+ * @brief Checks whether a score, or a bound, is a mate or beyond
+ */
+bool is_mate(int32_t score) {
+    return std::abs(score) >= Search::MATE_SCORE - Search::MAX_PLY;
+}
+
+/**
+ * @brief Checks whether the side to move has a Piece other than PAWNs and
+ * the KING, without which passing the turn is often the best option
+ * (zugzwang) and null Move pruning is unsound
+ */
+bool has_pieces(const Board &board) {
+    const uint64_t key = board.material_key();
+
+    for (const auto type :
+         {Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN}) {
+        if (Board::material_count(key, type | board.turn()) > 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Checks whether the side which just moved left its KING attacked
+ */
+bool exposes_king(const Board &next) {
+    const int16_t king =
+        MoveGenerator::king_square(next, next.opponent_turn());
+
+    return king != Board::NO_SQUARE &&
+           MoveGenerator::attacked(next, king, next.turn());
+}
+}    // namespace
+
+Search::~Search() {
+    stop();
+    wait();
+}
+
+std::vector<Move> Search::think(const Board &board, const Limits &limits,
+                                const report_callback_t &report) {
+    wait();
+    prepare(board, limits);
+
+    return iterate(board, report);
+}
+
+void Search::start(const Board &board, const Limits &limits,
+                   report_callback_t report, done_callback_t done) {
+    wait();
+    prepare(board, limits);
+
+    m_worker = std::thread{[this, board, report = std::move(report),
+                            done = std::move(done)] {
+        const std::vector<Move> pv = iterate(board, report);
+
+        if (done) {
+            done(pv);
+        }
+    }};
+}
+
+void Search::stop() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stop.store(true, std::memory_order_relaxed);
+    }
+
+    m_wakeup.notify_all();
+}
+
+void Search::ponderhit() {
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_time.restart();
+        m_pondering.store(false);
+    }
+
+    m_wakeup.notify_all();
+}
+
+void Search::wait() {
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+[[nodiscard]] uint64_t Search::nodes() const {
+    return m_nodes.load(std::memory_order_relaxed);
+}
+
+void Search::set_options(const Options &options) { m_options = options; }
+
+[[nodiscard]] Search::Options Search::options() const { return m_options; }
+
+[[nodiscard]] TimeManager::Statistics Search::statistics() const {
+    return m_time.statistics();
+}
+
+void Search::reset_statistics() { m_time.reset_statistics(); }
+
+void Search::prepare(const Board &board, const Limits &limits) {
+    m_stop.store(false);
+    m_pondering.store(limits.m_ponder);
+    m_limits = limits;
+    m_enabled = m_options;
+    m_nodes.store(0, std::memory_order_relaxed);
+    m_previous_pv_length = 0;
+
+    const size_t side = board.turn() == Piece::WHITE ? 0 : 1;
+
+    m_time.start(limits.m_time[side], limits.m_increment[side],
+                 limits.m_moves_to_go, limits.m_movetime);
+}
+
+std::vector<Move> Search::iterate(const Board &board,
+                                  const report_callback_t &report) {
+    MoveList root;
+    MoveGenerator::legal(board, root);
+
+    std::vector<Move> best_pv;
+    int32_t score = 0;
+
+    if (!root.empty()) {
+        best_pv.push_back(root[0]);
+
+        for (int16_t depth = 1; depth <= m_limits.m_depth; depth++) {
+            score = m_enabled.m_aspiration && depth >= ASPIRATION_DEPTH
+                        ? aspiration(board, depth, score)
+                        : negamax(board, depth, -INFINITE_SCORE,
+                                  INFINITE_SCORE, 0, true);
+
+            // An interrupted iteration is only trusted when nothing better
+            // is available
+            if (m_stop.load(std::memory_order_relaxed) &&
+                (depth > 1 || m_pv_length[0] == 0)) {
+                break;
+            }
+
+            const bool changed = depth > 1 && !(best_pv.front() == m_pv[0][0]);
+
+            best_pv.assign(m_pv[0].begin(), m_pv[0].begin() + m_pv_length[0]);
+            std::copy(best_pv.begin(), best_pv.end(), m_previous_pv.begin());
+            m_previous_pv_length = m_pv_length[0];
+
+            if (report) {
+                report(
+                    Report{depth, score, nodes(), m_time.elapsed(), best_pv});
+            }
+
+            if (m_stop.load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            // A pondering search ignores the deadlines until ponderhit
+            if (!m_time.completed(changed) && !m_pondering.load()) {
+                break;
+            }
+        }
+    }
+
+    if (!m_pondering.load()) {
+        m_time.finish();
+    }
+
+    // UCI forbids answering an infinite or pondering search before stop
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_wakeup.wait(lock, [this] {
+        return m_stop.load(std::memory_order_relaxed) ||
+               (!m_limits.m_infinite && !m_pondering.load());
+    });
+
+    return best_pv;
+}
+
+int32_t Search::aspiration(const Board &board, int16_t depth,
+                           int32_t previous) {
+    int32_t delta = ASPIRATION_WINDOW;
+    int32_t alpha = std::max(previous - delta, -INFINITE_SCORE);
+    int32_t beta = std::min(previous + delta, INFINITE_SCORE);
+
+    for (;;) {
+        const int32_t score = negamax(board, depth, alpha, beta, 0, true);
+
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return score;
+        }
+
+        delta *= 2;
+
+        // Out of the window the score is only a bound, widen the failing side
+        if (score <= alpha) {
+            alpha = std::max(score - delta, -INFINITE_SCORE);
+        } else if (score >= beta) {
+            beta = std::min(score + delta, INFINITE_SCORE);
+        } else {
+            return score;
+        }
+    }
+}
+
+int32_t Search::negamax(const Board &board, int16_t depth, int32_t alpha,
+                        int32_t beta, int16_t ply, bool null_move) {
+    m_pv_length[ply] = ply;
+
+    if (should_stop()) {
+        return 0;
+    }
+
+    if (ply > 0 &&
+        (board.halfmove_clock() >= 100 || Endgame::is_dead_draw(board))) {
+        return 0;
+    }
+
+    if (ply >= MAX_PLY) {
+        return Evaluation::evaluate(board);
+    }
+
+    const bool in_check = MoveGenerator::in_check(board);
+
+    if (in_check) {
+        depth++;
+    }
+
+    if (depth <= 0) {
+        return quiescence(board, alpha, beta, ply);
+    }
+
+    // Forward pruning is kept away from the root, checks and mate scores
+    const bool prunable =
+        ply > 0 && !in_check && !is_mate(alpha) && !is_mate(beta);
+    const int32_t static_eval = prunable ? Evaluation::evaluate(board) : 0;
+
+    if (m_enabled.m_futility && prunable &&
+        static_cast<size_t>(depth) < RAZOR_MARGINS.size() &&
+        static_eval + RAZOR_MARGINS[depth] <= alpha) {
+        const int32_t score = quiescence(board, alpha, alpha + 1, ply);
+
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        if (score <= alpha) {
+            return score;
+        }
+    }
+
+    // If passing the turn still fails high, any real Move would as well
+    if (m_enabled.m_null_move && null_move && prunable && depth >= 3 &&
+        static_eval >= beta && has_pieces(board)) {
+        const int16_t reduction = depth >= 7 ? 3 : 2;
+
+        Board next = board;
+        next.make_null_move();
+
+        const int32_t score = -negamax(next, depth - 1 - reduction, -beta,
+                                       -beta + 1, ply + 1, false);
+
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        if (score >= beta) {
+            return beta;
+        }
+    }
+
+    const bool futile = m_enabled.m_futility && prunable &&
+                        static_cast<size_t>(depth) < FUTILITY_MARGINS.size() &&
+                        static_eval + FUTILITY_MARGINS[depth] <= alpha;
+
+    MoveList moves;
+    MoveGenerator::pseudo_legal(board, moves);
+    order(board, moves, ply);
+
+    int32_t best = -INFINITE_SCORE;
+    uint16_t legal = 0;
+
+    for (const auto &move : moves) {
+        Board next = board;
+        next.make_move(move);
+
+        if (exposes_king(next)) {
+            continue;
+        }
+
+        legal++;
+
+        const bool late = m_enabled.m_late_move_reductions && depth >= 3 &&
+                          legal > LATE_MOVES;
+
+        // Quiet Moves not giving check are the ones pruned or reduced
+        const bool quiet = legal > 1 && !in_check && (futile || late) &&
+                           !is_capture(board, move) &&
+                           move.promotion_piece() == Piece::NONE &&
+                           !MoveGenerator::in_check(next);
+
+        if (quiet && futile) {
+            continue;
+        }
+
+        int32_t score = 0;
+
+        if (legal == 1) {
+            score = -negamax(next, depth - 1, -beta, -alpha, ply + 1, true);
+        } else {
+            const int16_t reduction =
+                quiet && late ? (depth >= 6 && legal > 3 * LATE_MOVES ? 2 : 1)
+                              : 0;
+            // A null window only tells whether the Move beats alpha
+            const int32_t bound = m_enabled.m_pvs ? alpha + 1 : beta;
+
+            score = -negamax(next, depth - 1 - reduction, -bound, -alpha,
+                             ply + 1, true);
+
+            if (reduction > 0 && score > alpha) {
+                score = -negamax(next, depth - 1, -bound, -alpha, ply + 1,
+                                 true);
+            }
+
+            if (bound < beta && score > alpha && score < beta) {
+                score =
+                    -negamax(next, depth - 1, -beta, -alpha, ply + 1, true);
+            }
+        }
+
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        if (score > best) {
+            best = score;
+
+            if (score > alpha) {
+                alpha = score;
+
+                m_pv[ply][ply] = move;
+                std::copy(m_pv[ply + 1].begin() + ply + 1,
+                          m_pv[ply + 1].begin() + m_pv_length[ply + 1],
+                          m_pv[ply].begin() + ply + 1);
+                m_pv_length[ply] = m_pv_length[ply + 1];
+
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (legal == 0) {
+        return in_check ? -MATE_SCORE + ply : 0;
+    }
+
+    return best;
+}
+
+int32_t Search::quiescence(const Board &board, int32_t alpha, int32_t beta,
+                           int16_t ply) {
+    m_pv_length[ply] = ply;
+
+    if (should_stop()) {
+        return 0;
+    }
+
+    const int32_t stand_pat = Evaluation::evaluate(board);
+
+    if (ply >= MAX_PLY || stand_pat >= beta) {
+        return stand_pat;
+    }
+
+    alpha = std::max(alpha, stand_pat);
+
+    MoveList moves;
+    MoveGenerator::pseudo_legal(board, moves);
+    order(board, moves, ply);
+
+    for (const auto &move : moves) {
+        if (!is_capture(board, move) && move.promotion_piece() == Piece::NONE) {
+            continue;
+        }
+
+        Board next = board;
+        next.make_move(move);
+
+        if (exposes_king(next)) {
+            continue;
+        }
+
+        const int32_t score = -quiescence(next, -beta, -alpha, ply + 1);
+
+        if (m_stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        if (score > alpha) {
+            alpha = score;
+
+            if (alpha >= beta) {
+                break;
+            }
+        }
+    }
+
+    return alpha;
+}
+
+void Search::order(const Board &board, MoveList &moves, int16_t ply) const {
+    std::array<int32_t, std::tuple_size<MoveList::move_array_t>::value>
+        scores{};
+
+    for (size_t i = 0; i < moves.size(); i++) {
+        const Move &move = moves[i];
+
+        if (ply < m_previous_pv_length && m_previous_pv[ply] == move) {
+            scores[i] = 1'000'000;
+        } else if (is_capture(board, move)) {
+            scores[i] = 100'000 +
+                        10 * Evaluation::piece_value(
+                                 board.piece_at(move.destination())) -
+                        Evaluation::piece_value(move.piece()) / 10;
+        } else if (move.promotion_piece() != Piece::NONE) {
+            scores[i] =
+                90'000 + Evaluation::piece_value(move.promotion_piece());
+        }
+    }
+
+    // Selection sort, lists are short and mostly cut off early
+    for (size_t i = 0; i < moves.size(); i++) {
+        size_t best = i;
+
+        for (size_t j = i + 1; j < moves.size(); j++) {
+            if (scores[j] > scores[best]) {
+                best = j;
+            }
+        }
+
+        std::swap(moves[i], moves[best]);
+        std::swap(scores[i], scores[best]);
+    }
+}
+
+bool Search::should_stop() {
+    // A single writer, no need for an atomic increment
+    const uint64_t nodes = m_nodes.load(std::memory_order_relaxed) + 1;
+    m_nodes.store(nodes, std::memory_order_relaxed);
+
+    if (m_stop.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    if ((m_limits.m_nodes > 0 && nodes >= m_limits.m_nodes) ||
+        (!m_pondering.load(std::memory_order_relaxed) &&
+         m_time.out_of_time(nodes))) {
+        m_stop.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+}    // namespace dreamchess
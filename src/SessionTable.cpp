@@ -0,0 +1,103 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "SessionTable.hpp"
+
+#include <utility>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+SessionTable::session_t SessionTable::open() {
+    std::unique_ptr<Game> game;
+
+    {
+        std::lock_guard<std::mutex> lock{m_pool_mutex};
+
+        if (!m_pool.empty()) {
+            game = std::move(m_pool.back());
+            m_pool.pop_back();
+        }
+    }
+
+    if (!game) {
+        game = std::make_unique<Game>();
+    }
+
+    const session_t session = m_next.fetch_add(1, std::memory_order_relaxed);
+    Shard &owner = shard(session);
+
+    {
+        std::lock_guard<std::mutex> lock{owner.m_mutex};
+        owner.m_games.emplace(session, std::move(game));
+    }
+
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    return session;
+}
+
+bool SessionTable::close(session_t session) {
+    std::unique_ptr<Game> game;
+    Shard &owner = shard(session);
+
+    {
+        std::lock_guard<std::mutex> lock{owner.m_mutex};
+        const auto found = owner.m_games.find(session);
+
+        if (found == owner.m_games.end()) {
+            return false;
+        }
+
+        game = std::move(found->second);
+        owner.m_games.erase(found);
+    }
+
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+
+    // Reset out of the locks, the next session finds it ready
+    game->reset();
+
+    std::lock_guard<std::mutex> lock{m_pool_mutex};
+    m_pool.push_back(std::move(game));
+
+    return true;
+}
+
+bool SessionTable::with(session_t session,
+                        const std::function<void(Game &)> &work) {
+    Shard &owner = shard(session);
+    std::lock_guard<std::mutex> lock{owner.m_mutex};
+    const auto found = owner.m_games.find(session);
+
+    if (found == owner.m_games.end()) {
+        return false;
+    }
+
+    work(*found->second);
+
+    return true;
+}
+
+[[nodiscard]] std::size_t SessionTable::size() const {
+    return m_size.load(std::memory_order_relaxed);
+}
+
+[[nodiscard]] std::size_t SessionTable::pooled() const {
+    std::lock_guard<std::mutex> lock{m_pool_mutex};
+
+    return m_pool.size();
+}
+
+SessionTable::Shard &SessionTable::shard(session_t session) {
+    return m_shards[session & (SHARDS - 1)];
+}
+}    // namespace dreamchess
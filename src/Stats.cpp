@@ -0,0 +1,173 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+#ifdef DREAMCHESS_STATS
+namespace {
+/**
+ * @struct ThreadBlock
+ * @brief The counters owned by a single thread
+ * @details Only the owning thread writes, so the hot path is a relaxed load
+ * and store instead of a locked read-modify-write
+ */
+struct ThreadBlock final {
+    std::array<std::atomic<uint64_t>, Stats::PROBE_COUNT> m_calls{};
+    std::array<std::atomic<uint64_t>, Stats::PROBE_COUNT> m_ticks{};
+
+    ThreadBlock();
+    ~ThreadBlock();
+};
+
+/**
+ * @struct Registry
+ * @brief Every live ThreadBlock plus the totals of the exited threads
+ */
+struct Registry final {
+    std::mutex m_mutex;
+    std::vector<ThreadBlock *> m_blocks;
+    Stats::snapshot_t m_retired{};
+};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadBlock::ThreadBlock() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock{reg.m_mutex};
+    reg.m_blocks.push_back(this);
+}
+
+ThreadBlock::~ThreadBlock() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock{reg.m_mutex};
+
+    for (uint16_t i = 0; i < Stats::PROBE_COUNT; i++) {
+        reg.m_retired[i].m_calls += m_calls[i].load(std::memory_order_relaxed);
+        reg.m_retired[i].m_ticks += m_ticks[i].load(std::memory_order_relaxed);
+    }
+
+    reg.m_blocks.erase(
+        std::find(reg.m_blocks.begin(), reg.m_blocks.end(), this));
+}
+
+ThreadBlock &local_block() {
+    thread_local ThreadBlock block;
+    return block;
+}
+
+void bump(std::atomic<uint64_t> &value, uint64_t amount) {
+    value.store(value.load(std::memory_order_relaxed) + amount,
+                std::memory_order_relaxed);
+}
+}    // namespace
+
+void Stats::record(Probe probe, uint64_t elapsed) {
+    ThreadBlock &block = local_block();
+
+    bump(block.m_calls[probe], 1);
+    bump(block.m_ticks[probe], elapsed);
+}
+
+[[nodiscard]] Stats::snapshot_t Stats::collect() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock{reg.m_mutex};
+
+    snapshot_t total = reg.m_retired;
+
+    for (const ThreadBlock *block : reg.m_blocks) {
+        for (uint16_t i = 0; i < PROBE_COUNT; i++) {
+            total[i].m_calls +=
+                block->m_calls[i].load(std::memory_order_relaxed);
+            total[i].m_ticks +=
+                block->m_ticks[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    return total;
+}
+
+void Stats::reset() {
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock{reg.m_mutex};
+
+    reg.m_retired.fill(Counter{});
+
+    for (ThreadBlock *block : reg.m_blocks) {
+        for (uint16_t i = 0; i < PROBE_COUNT; i++) {
+            block->m_calls[i].store(0, std::memory_order_relaxed);
+            block->m_ticks[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+#else
+void Stats::record(Probe, uint64_t) {}
+
+[[nodiscard]] Stats::snapshot_t Stats::collect() { return snapshot_t{}; }
+
+void Stats::reset() {}
+#endif
+
+void Stats::dump(std::ostream &stream) {
+    if (!enabled()) {
+        stream << "Stats disabled (build with DREAMCHESS_STATS=ON)" << '\n';
+        return;
+    }
+
+    const snapshot_t total = collect();
+
+    stream << std::left << std::setw(24) << "probe" << std::right
+           << std::setw(14) << "calls" << std::setw(18) << "ticks"
+           << std::setw(12) << "ticks/call" << '\n';
+
+    for (uint16_t i = 0; i < PROBE_COUNT; i++) {
+        const Counter &counter = total[i];
+
+        stream << std::left << std::setw(24) << name(static_cast<Probe>(i))
+               << std::right << std::setw(14) << counter.m_calls
+               << std::setw(18) << counter.m_ticks << std::setw(12)
+               << (counter.m_calls == 0 ? 0
+                                        : counter.m_ticks / counter.m_calls)
+               << '\n';
+    }
+}
+
+[[nodiscard]] std::string_view Stats::name(Probe probe) {
+    switch (probe) {
+        case BOARD_MOVE_IS_VALID:
+            return "Board::move_is_valid";
+        case BOARD_SQUARE_ATTACKED:
+            return "Board::square_attacked";
+        case BOARD_ATTACK_MAP:
+            return "Board::attack_map";
+        case BOARD_MAKE_MOVE:
+            return "Board::make_move";
+        case GAME_MAKE_MOVE:
+            return "Game::make_move";
+        case HISTORY_ADD_STEP:
+            return "History::add_step";
+        default:
+            return "unknown";
+    }
+}
+}    // namespace dreamchess
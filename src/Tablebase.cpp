@@ -0,0 +1,320 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Tablebase.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <utility>
+
+#include "Evaluation.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Piece letters in signature order
+ */
+constexpr std::string_view ORDER{"KQRBNP"};
+
+/**
+ * @brief Piece types of the ORDER letters
+ */
+constexpr std::array<Piece::Enum, 6> ORDER_TYPES{
+    Piece::KING,   Piece::QUEEN,  Piece::ROOK,
+    Piece::BISHOP, Piece::KNIGHT, Piece::PAWN};
+
+Piece::Enum type_of(char letter) { return ORDER_TYPES[ORDER.find(letter)]; }
+
+int32_t strength(std::string_view side) {
+    int32_t value = 0;
+
+    for (const char letter : side) {
+        value += Evaluation::piece_value(type_of(letter));
+    }
+
+    return value;
+}
+
+/**
+ * @brief Checks whether a side, as signature letters, is stored before the
+ * other one
+ */
+bool stronger(std::string_view lhs, std::string_view rhs) {
+    const int32_t lhs_strength = strength(lhs);
+    const int32_t rhs_strength = strength(rhs);
+
+    return lhs_strength > rhs_strength ||
+           (lhs_strength == rhs_strength && lhs < rhs);
+}
+
+/**
+ * @brief Number of squares the i-th piece of a signature can stand on: the
+ * stronger KING is mirrored, pawns never stand on the first and last ranks
+ */
+uint16_t square_range(std::string_view signature, std::size_t piece) {
+    if (piece == 0) {
+        return signature.find('P') == std::string_view::npos ? 16 : 32;
+    }
+
+    return signature[piece] == 'P' ? 48 : 64;
+}
+
+uint16_t square_code(std::string_view signature, std::size_t piece,
+                     uint16_t square) {
+    if (piece == 0) {
+        return (square / 8) * 4 + square % 8;
+    }
+
+    return signature[piece] == 'P' ? square - 8 : square;
+}
+
+uint16_t code_square(std::string_view signature, std::size_t piece,
+                     uint16_t code) {
+    if (piece == 0) {
+        return (code / 4) * 8 + code % 4;
+    }
+
+    return signature[piece] == 'P' ? code + 8 : code;
+}
+}    // namespace
+
+bool Tablebase::open(const std::string &path) {
+    MappedFile file;
+
+    if (!file.open(path) || file.size() < HEADER_SIZE ||
+        std::string_view{reinterpret_cast<const char *>(file.data()),
+                         MAGIC.size()} != MAGIC) {
+        return false;
+    }
+
+    const char *name = reinterpret_cast<const char *>(file.data()) +
+                       MAGIC.size();
+    const std::string stored{
+        name, static_cast<std::size_t>(
+                  std::find(name, name + HEADER_SIZE - MAGIC.size(), '\0') -
+                  name)};
+
+    if (signature(stored) != stored ||
+        file.size() != HEADER_SIZE + entries(stored)) {
+        return false;
+    }
+
+    m_tables.insert_or_assign(stored, std::move(file));
+
+    return true;
+}
+
+void Tablebase::close() { m_tables.clear(); }
+
+[[nodiscard]] std::size_t Tablebase::size() const { return m_tables.size(); }
+
+[[nodiscard]] std::optional<Tablebase::Result> Tablebase::probe(
+    const Board &board) const {
+    const std::optional<Key> position_key = key(board);
+
+    if (!position_key) {
+        return std::nullopt;
+    }
+
+    const auto table = m_tables.find(position_key->m_signature);
+
+    if (table == m_tables.end()) {
+        return std::nullopt;
+    }
+
+    return decode(
+        table->second.data()[HEADER_SIZE + position_key->m_index]);
+}
+
+[[nodiscard]] std::optional<std::string> Tablebase::signature(
+    std::string_view text) {
+    std::string letters;
+
+    for (const char letter : text) {
+        const char upper =
+            static_cast<char>(std::toupper(static_cast<unsigned char>(letter)));
+
+        if (ORDER.find(upper) == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        letters += upper;
+    }
+
+    const std::size_t second_king = letters.find('K', 1);
+
+    if (letters.size() > MAX_PIECES || letters.empty() || letters[0] != 'K' ||
+        second_king == std::string::npos ||
+        letters.find('K', second_king + 1) != std::string::npos) {
+        return std::nullopt;
+    }
+
+    std::array<std::string, 2> sides{letters.substr(0, second_king),
+                                     letters.substr(second_king)};
+
+    for (auto &side : sides) {
+        std::sort(side.begin(), side.end(), [](char lhs, char rhs) {
+            return ORDER.find(lhs) < ORDER.find(rhs);
+        });
+    }
+
+    if (stronger(sides[1], sides[0])) {
+        std::swap(sides[0], sides[1]);
+    }
+
+    return sides[0] + sides[1];
+}
+
+[[nodiscard]] uint64_t Tablebase::entries(std::string_view signature) {
+    uint64_t size = 2;
+
+    for (std::size_t piece = 0; piece < signature.size(); piece++) {
+        size *= square_range(signature, piece);
+    }
+
+    return size;
+}
+
+[[nodiscard]] std::optional<Tablebase::Key> Tablebase::key(
+    const Board &board) {
+    if (board.castling_rights() != Board::NO_CASTLING) {
+        return std::nullopt;
+    }
+
+    std::array<std::pair<Board::piece_t, uint16_t>, MAX_PIECES> pieces{};
+    std::size_t count = 0;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        const Board::piece_t piece = board.piece_at(square);
+
+        if (piece == Piece::NONE) {
+            continue;
+        }
+
+        if (count == MAX_PIECES ||
+            (Piece::type(piece) == Piece::PAWN &&
+             (square / 8 == 0 || square / 8 == 7))) {
+            return std::nullopt;
+        }
+
+        pieces[count++] = {piece, square};
+    }
+
+    // Letters and squares of each side, in signature order
+    std::array<std::array<char, MAX_PIECES>, 2> letters{};
+    std::array<std::array<uint16_t, MAX_PIECES>, 2> squares{};
+    std::array<std::string_view, 2> sides{};
+
+    for (std::size_t side = 0; side < 2; side++) {
+        const Piece::Enum color = side == 0 ? Piece::WHITE : Piece::BLACK;
+        std::size_t length = 0;
+
+        for (std::size_t order = 0; order < ORDER.size(); order++) {
+            for (std::size_t i = 0; i < count; i++) {
+                if (pieces[i].first == (ORDER_TYPES[order] | color)) {
+                    letters[side][length] = ORDER[order];
+                    squares[side][length++] = pieces[i].second;
+                }
+            }
+        }
+
+        sides[side] = std::string_view{letters[side].data(), length};
+
+        if (sides[side].empty() || sides[side][0] != 'K' ||
+            sides[side].find('K', 1) != std::string_view::npos) {
+            return std::nullopt;
+        }
+    }
+
+    const std::size_t strong = stronger(sides[1], sides[0]) ? 1 : 0;
+    const std::size_t weak = 1 - strong;
+
+    Key result{};
+    result.m_signature.append(sides[strong]).append(sides[weak]);
+
+    // The stronger side plays WHITE, its KING on the mirrored squares
+    uint16_t mask = strong == 1 ? 56 : 0;
+    const uint16_t strong_king = squares[strong][0] ^ mask;
+
+    if (strong_king % 8 > 3) {
+        mask ^= 7;
+    }
+
+    if (result.m_signature.find('P') == std::string::npos &&
+        strong_king / 8 > 3) {
+        mask ^= 56;
+    }
+
+    const Piece::Enum strong_color = strong == 0 ? Piece::WHITE : Piece::BLACK;
+    result.m_index = board.turn() == strong_color ? 0 : 1;
+
+    std::size_t piece = 0;
+
+    for (const std::size_t side : {strong, weak}) {
+        for (std::size_t i = 0; i < sides[side].size(); i++, piece++) {
+            result.m_index =
+                result.m_index * square_range(result.m_signature, piece) +
+                square_code(result.m_signature, piece, squares[side][i] ^ mask);
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::optional<Board> Tablebase::position(
+    std::string_view signature, uint64_t index) {
+    std::array<uint16_t, MAX_PIECES> squares{};
+
+    for (std::size_t piece = signature.size(); piece-- > 0;) {
+        const uint16_t range = square_range(signature, piece);
+
+        squares[piece] = code_square(signature, piece,
+                                     static_cast<uint16_t>(index % range));
+        index /= range;
+    }
+
+    Board::piece_array_t pieces{};
+    pieces.fill(Piece::NONE);
+
+    const std::size_t second_king = signature.find('K', 1);
+
+    for (std::size_t piece = 0; piece < signature.size(); piece++) {
+        if (pieces[squares[piece]] != Piece::NONE) {
+            return std::nullopt;
+        }
+
+        pieces[squares[piece]] =
+            type_of(signature[piece]) |
+            (piece < second_king ? Piece::WHITE : Piece::BLACK);
+    }
+
+    Board board = Board::start_position();
+    board.set_position(pieces, index == 0 ? Piece::WHITE : Piece::BLACK,
+                       Board::NO_CASTLING, Board::NO_SQUARE, 0, 1);
+
+    return board;
+}
+
+[[nodiscard]] Tablebase::Result Tablebase::decode(uint8_t value) {
+    if (value == 0) {
+        return Result{DRAW, 0};
+    }
+
+    if (value < 128) {
+        return Result{WIN, value};
+    }
+
+    return Result{LOSS, static_cast<uint16_t>(value - 128)};
+}
+}    // namespace dreamchess
@@ -0,0 +1,447 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "TablebaseGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <thread>
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief Value of the positions not resolved yet, never written to a file
+ */
+constexpr uint8_t UNKNOWN{255};
+
+/**
+ * @brief Value of a checkmated side to move, a loss in 0 moves
+ */
+constexpr uint8_t MATED{128};
+
+/**
+ * @brief Checks whether the side which just moved left its KING attacked
+ */
+bool exposes_king(const Board &next) {
+    const int16_t king =
+        MoveGenerator::king_square(next, next.opponent_turn());
+
+    return king != Board::NO_SQUARE &&
+           MoveGenerator::attacked(next, king, next.turn());
+}
+}    // namespace
+
+TablebaseGenerator::TablebaseGenerator(uint16_t threads)
+    : m_threads{std::max<uint16_t>(1, threads)} {}
+
+const TablebaseGenerator::table_t &TablebaseGenerator::generate(
+    std::string_view signature, const progress_callback_t &progress) {
+    const auto found = m_tables.find(signature);
+
+    if (found != m_tables.end()) {
+        return found->second;
+    }
+
+    for (const auto &dependency : dependencies(signature)) {
+        generate(dependency, progress);
+    }
+
+    const uint64_t size = Tablebase::entries(signature);
+
+    table_t values(size, UNKNOWN);
+    std::vector<uint8_t> waiting(size, 0);
+    std::vector<std::vector<uint64_t>> pending;
+    std::vector<uint64_t> resolved;
+
+    const auto schedule = [&pending](uint16_t ply, uint64_t index) {
+        if (pending.size() <= ply) {
+            pending.resize(ply + 1);
+        }
+
+        pending[ply].push_back(index);
+    };
+
+    // Ply 0: mates, stalemates and values due to smaller tables
+    {
+        table_t initial(size, UNKNOWN);
+        std::vector<std::vector<std::pair<uint16_t, uint64_t>>> scheduled(
+            m_threads);
+        std::vector<std::vector<uint64_t>> mated(m_threads);
+
+        parallel_for(size, [&](uint16_t thread, std::size_t first,
+                               std::size_t last) {
+            for (std::size_t index = first; index < last; index++) {
+                const Verdict verdict = evaluate(signature, values, index, 0);
+
+                initial[index] = verdict.m_value;
+                waiting[index] = verdict.m_unknown;
+
+                if (verdict.m_ply > 0) {
+                    scheduled[thread].emplace_back(verdict.m_ply, index);
+                } else if (verdict.m_value == MATED) {
+                    mated[thread].push_back(index);
+                }
+            }
+        });
+
+        values = std::move(initial);
+
+        for (uint16_t thread = 0; thread < m_threads; thread++) {
+            for (const auto &[ply, index] : scheduled[thread]) {
+                schedule(ply, index);
+            }
+
+            resolved.insert(resolved.end(), mated[thread].begin(),
+                            mated[thread].end());
+        }
+    }
+
+    if (progress) {
+        progress(signature, 0, resolved.size());
+    }
+
+    for (uint16_t ply = 1; !resolved.empty() || ply < pending.size(); ply++) {
+        std::vector<uint64_t> candidates;
+
+        if (ply < pending.size()) {
+            candidates = std::move(pending[ply]);
+        }
+
+        // Predecessors of lost and won positions, by thread
+        std::vector<std::array<std::vector<uint64_t>, 2>> found(m_threads);
+
+        parallel_for(resolved.size(), [&](uint16_t thread, std::size_t first,
+                                          std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                predecessors(signature, resolved[i],
+                             found[thread][values[resolved[i]] < MATED]);
+            }
+        });
+
+        std::vector<uint64_t> next;
+        const auto win = static_cast<uint8_t>((ply + 1) / 2);
+
+        for (const auto &lists : found) {
+            for (const uint64_t index : lists[0]) {
+                if (values[index] == UNKNOWN) {
+                    values[index] = win;
+                    next.push_back(index);
+                }
+            }
+
+            for (const uint64_t index : lists[1]) {
+                if (values[index] == UNKNOWN && waiting[index] > 0 &&
+                    --waiting[index] == 0) {
+                    candidates.push_back(index);
+                }
+            }
+        }
+
+        // The tables are only read while the candidates are evaluated
+        std::vector<std::vector<std::pair<uint64_t, Verdict>>> verdicts(
+            m_threads);
+
+        parallel_for(candidates.size(), [&](uint16_t thread,
+                                            std::size_t first,
+                                            std::size_t last) {
+            for (std::size_t i = first; i < last; i++) {
+                if (values[candidates[i]] != UNKNOWN) {
+                    continue;
+                }
+
+                const Verdict verdict =
+                    evaluate(signature, values, candidates[i], ply);
+
+                if (verdict.m_value != UNKNOWN || verdict.m_ply > 0) {
+                    verdicts[thread].emplace_back(candidates[i], verdict);
+                }
+            }
+        });
+
+        for (const auto &list : verdicts) {
+            for (const auto &[index, verdict] : list) {
+                if (values[index] != UNKNOWN) {
+                    continue;
+                }
+
+                if (verdict.m_value == UNKNOWN) {
+                    schedule(verdict.m_ply, index);
+                    continue;
+                }
+
+                values[index] = verdict.m_value;
+
+                if (verdict.m_value != 0) {
+                    next.push_back(index);
+                }
+            }
+        }
+
+        resolved = std::move(next);
+
+        if (progress) {
+            progress(signature, ply, resolved.size());
+        }
+    }
+
+    // Neither side can force a mate
+    std::replace(values.begin(), values.end(), UNKNOWN, uint8_t{0});
+
+    return m_tables.emplace(std::string{signature}, std::move(values))
+        .first->second;
+}
+
+[[nodiscard]] const std::map<std::string, TablebaseGenerator::table_t,
+                             std::less<>> &
+TablebaseGenerator::tables() const {
+    return m_tables;
+}
+
+[[nodiscard]] bool TablebaseGenerator::write(std::string_view signature,
+                                             const std::string &path) const {
+    const auto table = m_tables.find(signature);
+
+    if (table == m_tables.end()) {
+        return false;
+    }
+
+    std::array<char, Tablebase::HEADER_SIZE> header{};
+    std::copy(Tablebase::MAGIC.begin(), Tablebase::MAGIC.end(),
+              header.begin());
+    std::copy(signature.begin(), signature.end(),
+              header.begin() + Tablebase::MAGIC.size());
+
+    std::ofstream file{path, std::ios::binary};
+    file.write(header.data(), header.size());
+    file.write(reinterpret_cast<const char *>(table->second.data()),
+               static_cast<std::streamsize>(table->second.size()));
+
+    return static_cast<bool>(file);
+}
+
+[[nodiscard]] std::vector<std::string> TablebaseGenerator::dependencies(
+    std::string_view signature) {
+    std::vector<std::string> result;
+
+    const auto add = [&result](const std::string &pieces) {
+        const std::optional<std::string> normalized =
+            Tablebase::signature(pieces);
+
+        if (normalized && std::find(result.begin(), result.end(),
+                                    *normalized) == result.end()) {
+            result.push_back(*normalized);
+        }
+    };
+
+    for (std::size_t piece = 0; piece < signature.size(); piece++) {
+        if (signature[piece] == 'K') {
+            continue;
+        }
+
+        // Captured
+        std::string pieces{signature};
+        pieces.erase(piece, 1);
+        add(pieces);
+
+        if (signature[piece] == 'P') {
+            for (const char promotion : {'Q', 'R', 'B', 'N'}) {
+                pieces = signature;
+                pieces[piece] = promotion;
+                add(pieces);
+            }
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] TablebaseGenerator::Verdict TablebaseGenerator::evaluate(
+    std::string_view signature, const table_t &values, uint64_t index,
+    uint16_t ply) const {
+    const std::optional<Board> board = Tablebase::position(signature, index);
+
+    if (!board || exposes_king(*board)) {
+        return Verdict{0, 0, 0};
+    }
+
+    MoveList moves;
+    MoveGenerator::pseudo_legal(*board, moves);
+
+    bool legal = false;
+    uint8_t unknown = 0;
+    bool draw = false;
+    uint16_t win = 0;
+    uint16_t loss = 0;
+
+    for (const auto &move : moves) {
+        Board next = *board;
+        next.make_move(move);
+
+        if (exposes_king(next)) {
+            continue;
+        }
+
+        legal = true;
+
+        const uint8_t value = lookup(signature, values, next);
+
+        if (value == UNKNOWN) {
+            unknown++;
+        } else if (value == 0) {
+            draw = true;
+        } else if (value < MATED) {
+            loss = std::max<uint16_t>(loss, value);
+        } else {
+            const uint16_t moves_to_mate = value - MATED + 1;
+            win = win == 0 ? moves_to_mate : std::min(win, moves_to_mate);
+        }
+    }
+
+    if (!legal) {
+        return Verdict{MoveGenerator::in_check(*board) ? MATED : uint8_t{0}, 0,
+                       0};
+    }
+
+    // A known value is only written at its own ply, so that the shortest
+    // mates are found first
+    if (win > 0) {
+        const uint16_t due = 2 * win - 1;
+        return due <= ply ? Verdict{static_cast<uint8_t>(win), 0, 0}
+                          : Verdict{UNKNOWN, due, unknown};
+    }
+
+    if (unknown > 0) {
+        return Verdict{UNKNOWN, 0, unknown};
+    }
+
+    if (draw) {
+        return Verdict{0, 0, 0};
+    }
+
+    const uint16_t due = 2 * loss;
+    return due <= ply ? Verdict{static_cast<uint8_t>(MATED + loss), 0, 0}
+                      : Verdict{UNKNOWN, due, 0};
+}
+
+[[nodiscard]] uint8_t TablebaseGenerator::lookup(std::string_view signature,
+                                                 const table_t &values,
+                                                 const Board &board) const {
+    const std::optional<Tablebase::Key> key = Tablebase::key(board);
+
+    if (!key) {
+        return 0;
+    }
+
+    if (key->m_signature == signature) {
+        return values[key->m_index];
+    }
+
+    const auto table = m_tables.find(key->m_signature);
+
+    return table == m_tables.end() ? 0 : table->second[key->m_index];
+}
+
+void TablebaseGenerator::predecessors(std::string_view signature,
+                                      uint64_t index,
+                                      std::vector<uint64_t> &found) {
+    const uint64_t half = Tablebase::entries(signature) / 2;
+    const std::optional<Board> board = Tablebase::position(signature, index);
+
+    if (!board) {
+        return;
+    }
+
+    const auto add = [&](const Move &retraction) {
+        Board previous = *board;
+        previous.make_move(retraction);
+
+        const std::optional<Tablebase::Key> key = Tablebase::key(previous);
+
+        if (key) {
+            found.push_back(key->m_index);
+        }
+    };
+
+    // Pieces move backwards like they move forwards, the same position with
+    // the other side to move gives them
+    const std::optional<Board> mover =
+        Tablebase::position(signature, index < half ? index + half
+                                                    : index - half);
+    MoveList moves;
+    MoveGenerator::pseudo_legal(*mover, moves);
+
+    for (const auto &move : moves) {
+        if (Piece::type(move.piece()) != Piece::PAWN &&
+            board->piece_at(move.destination()) == Piece::NONE) {
+            add(move);
+        }
+    }
+
+    const Board::piece_t color = board->opponent_turn();
+    const Board::piece_t pawn = Piece::PAWN | color;
+    const int16_t backward = color == Piece::WHITE ? -8 : 8;
+    const int16_t double_rank = color == Piece::WHITE ? 3 : 4;
+
+    for (int16_t square = 8; square < 56; square++) {
+        if (board->piece_at(square) != pawn) {
+            continue;
+        }
+
+        const int16_t single = square + backward;
+
+        if (single / 8 == 0 || single / 8 == 7 ||
+            board->piece_at(single) != Piece::NONE) {
+            continue;
+        }
+
+        add(Move{square, single, pawn, Piece::NONE});
+
+        if (square / 8 == double_rank &&
+            board->piece_at(single + backward) == Piece::NONE) {
+            add(Move{square, static_cast<int16_t>(single + backward), pawn,
+                     Piece::NONE});
+        }
+    }
+}
+
+void TablebaseGenerator::parallel_for(
+    std::size_t size,
+    const std::function<void(uint16_t, std::size_t, std::size_t)> &work)
+    const {
+    if (m_threads == 1) {
+        work(0, 0, size);
+        return;
+    }
+
+    const std::size_t chunk = (size + m_threads - 1) / m_threads;
+    std::vector<std::thread> workers;
+
+    for (uint16_t thread = 0; thread < m_threads; thread++) {
+        const std::size_t first = thread * chunk;
+
+        if (first >= size) {
+            break;
+        }
+
+        workers.emplace_back(work, thread, first,
+                             std::min(size, first + chunk));
+    }
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+}    // namespace dreamchess
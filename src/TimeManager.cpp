@@ -0,0 +1,139 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "TimeManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+[[nodiscard]] int64_t TimeManager::Statistics::overrun_percentile(
+    double fraction) const {
+    if (m_moves == 0) {
+        return 0;
+    }
+
+    const uint64_t target = std::max<uint64_t>(
+        1, static_cast<uint64_t>(
+               std::ceil(fraction * static_cast<double>(m_moves))));
+    uint64_t seen = 0;
+
+    for (std::size_t bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += m_overruns[bucket];
+
+        if (seen >= target) {
+            return static_cast<int64_t>(bucket);
+        }
+    }
+
+    return BUCKETS - 1;
+}
+
+void TimeManager::start(int64_t time, int64_t increment,
+                        uint16_t moves_to_go, int64_t movetime) {
+    m_start.store(clock_t::now().time_since_epoch().count());
+
+    m_soft = 0;
+    m_hard = 0;
+    m_stretch = 0;
+    m_extended = false;
+
+    if (movetime > 0) {
+        m_soft = movetime;
+        m_hard = movetime;
+    } else if (time > 0) {
+        const int64_t available = std::max<int64_t>(1, time - MOVE_OVERHEAD);
+        const int64_t moves =
+            moves_to_go > 0 ? moves_to_go : DEFAULT_MOVES_TO_GO;
+
+        m_soft = std::clamp<int64_t>(time / moves + increment * 3 / 4, 1,
+                                     available);
+        m_hard = std::min(available,
+                          std::max(m_soft, std::min(m_soft * HARD_RATIO,
+                                                    available / 4)));
+    }
+}
+
+void TimeManager::restart() {
+    m_start.store(clock_t::now().time_since_epoch().count());
+}
+
+[[nodiscard]] bool TimeManager::out_of_time(uint64_t nodes) const {
+    return m_hard > 0 && nodes % CHECK_INTERVAL == 0 && elapsed() >= m_hard;
+}
+
+bool TimeManager::completed(bool changed) {
+    m_stretch = m_stretch / 2 + (changed ? 100 : 0);
+
+    if (m_soft == 0) {
+        return true;
+    }
+
+    const int64_t soft =
+        std::min(m_hard, m_soft + m_soft * m_stretch / 100);
+    const int64_t spent = elapsed();
+
+    // The next iteration takes longer than all the previous ones together
+    if (spent * 2 > soft) {
+        return false;
+    }
+
+    m_extended = m_extended || spent * 2 > m_soft;
+
+    return true;
+}
+
+void TimeManager::finish() {
+    if (m_hard == 0) {
+        return;
+    }
+
+    const int64_t latency = elapsed();
+    const int64_t overrun = std::max<int64_t>(0, latency - m_hard);
+
+    const std::lock_guard lock{m_mutex};
+
+    m_statistics.m_moves++;
+    m_statistics.m_extended += m_extended;
+    m_statistics.m_soft_overruns += latency > m_soft;
+    m_statistics.m_hard_overruns += latency > m_hard;
+    m_statistics.m_max_latency = std::max(m_statistics.m_max_latency, latency);
+    m_statistics.m_max_overrun = std::max(m_statistics.m_max_overrun, overrun);
+    m_statistics.m_overruns[std::min<std::size_t>(
+        static_cast<std::size_t>(overrun), Statistics::BUCKETS - 1)]++;
+}
+
+[[nodiscard]] int64_t TimeManager::elapsed() const {
+    const clock_t::duration since_start =
+        clock_t::now().time_since_epoch() - clock_t::duration{m_start.load()};
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(since_start)
+        .count();
+}
+
+[[nodiscard]] int64_t TimeManager::soft_deadline() const { return m_soft; }
+
+[[nodiscard]] int64_t TimeManager::hard_deadline() const { return m_hard; }
+
+[[nodiscard]] TimeManager::Statistics TimeManager::statistics() const {
+    const std::lock_guard lock{m_mutex};
+
+    return m_statistics;
+}
+
+void TimeManager::reset_statistics() {
+    const std::lock_guard lock{m_mutex};
+
+    m_statistics = Statistics{};
+}
+}    // namespace dreamchess
@@ -0,0 +1,294 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Uci.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+/**
+ * @brief The check options switching the search techniques
+ * @see Search::Options
+ */
+constexpr std::array<std::pair<std::string_view, bool Search::Options::*>, 5>
+    TECHNIQUES{{{"PVS", &Search::Options::m_pvs},
+                {"AspirationWindows", &Search::Options::m_aspiration},
+                {"NullMove", &Search::Options::m_null_move},
+                {"LateMoveReductions",
+                 &Search::Options::m_late_move_reductions},
+                {"Futility", &Search::Options::m_futility}}};
+}    // namespace
+
+Uci::Uci(std::istream &input, std::ostream &output)
+    : m_input{input}, m_output{output} {}
+
+Uci::~Uci() {
+    m_search.stop();
+    m_search.wait();
+}
+
+void Uci::loop() {
+    std::string line;
+
+    while (std::getline(m_input, line) && execute(line)) {
+    }
+
+    m_search.stop();
+    m_search.wait();
+}
+
+bool Uci::execute(std::string_view line) {
+    std::istringstream args{std::string{line}};
+    std::string command;
+
+    if (!(args >> command)) {
+        return true;
+    }
+
+    if (command == "uci") {
+        identify();
+    } else if (command == "isready") {
+        send("readyok");
+    } else if (command == "ucinewgame") {
+        m_search.stop();
+        m_search.wait();
+        m_board.load_fen(Board::START_FEN);
+    } else if (command == "position") {
+        m_search.stop();
+        m_search.wait();
+        position(args);
+    } else if (command == "go") {
+        go(args);
+    } else if (command == "stop") {
+        m_search.stop();
+    } else if (command == "ponderhit") {
+        m_search.ponderhit();
+    } else if (command == "setoption") {
+        set_option(args);
+    } else if (command == "d") {
+        send("info string fen " + m_board.fen());
+    } else if (command == "quit") {
+        m_search.stop();
+        m_search.wait();
+        return false;
+    } else {
+        send("info string unknown command " + command);
+    }
+
+    return true;
+}
+
+void Uci::wait() { m_search.wait(); }
+
+[[nodiscard]] const Board &Uci::board() const { return m_board; }
+
+void Uci::send(std::string_view line) {
+    std::lock_guard<std::mutex> lock{m_output_mutex};
+    m_output << line << std::endl;
+}
+
+void Uci::identify() {
+    send("id name DreamChess++");
+    send("id author Mattia Zorzan");
+    send("option name Ponder type check default false");
+    send("option name BookFile type string default <empty>");
+
+    for (const auto &technique : TECHNIQUES) {
+        send("option name " + std::string{technique.first} +
+             " type check default true");
+    }
+
+    send("uciok");
+}
+
+void Uci::position(std::istringstream &args) {
+    std::string token;
+    args >> token;
+
+    Board board{};
+
+    if (token == "fen") {
+        std::string fen;
+
+        while (args >> token && token != "moves") {
+            fen += token + " ";
+        }
+
+        if (!board.load_fen(fen)) {
+            send("info string invalid fen " + fen);
+            return;
+        }
+    } else if (token == "startpos") {
+        args >> token;
+    } else {
+        send("info string invalid position command");
+        return;
+    }
+
+    if (token == "moves") {
+        while (args >> token) {
+            const std::optional<Move> move =
+                MoveGenerator::from_uci(board, token);
+
+            if (!move) {
+                send("info string illegal move " + token);
+                return;
+            }
+
+            board.make_move(*move);
+        }
+    }
+
+    m_board = board;
+}
+
+void Uci::go(std::istringstream &args) {
+    Search::Limits limits{};
+    std::string token;
+
+    const auto read = [&args](auto &value) {
+        int64_t number = 0;
+        args >> number;
+        value = static_cast<std::remove_reference_t<decltype(value)>>(
+            std::max<int64_t>(0, number));
+    };
+
+    while (args >> token) {
+        if (token == "depth") {
+            read(limits.m_depth);
+            limits.m_depth = std::clamp<int16_t>(limits.m_depth, 1,
+                                                 Search::MAX_PLY);
+        } else if (token == "nodes") {
+            read(limits.m_nodes);
+        } else if (token == "movetime") {
+            read(limits.m_movetime);
+        } else if (token == "wtime") {
+            read(limits.m_time[0]);
+        } else if (token == "btime") {
+            read(limits.m_time[1]);
+        } else if (token == "winc") {
+            read(limits.m_increment[0]);
+        } else if (token == "binc") {
+            read(limits.m_increment[1]);
+        } else if (token == "movestogo") {
+            read(limits.m_moves_to_go);
+        } else if (token == "infinite") {
+            limits.m_infinite = true;
+        } else if (token == "ponder") {
+            limits.m_ponder = true;
+        }
+    }
+
+    // Book Moves are played before any thinking begins
+    if (!limits.m_infinite && !limits.m_ponder && m_book.is_open()) {
+        const std::optional<Move> move = m_book.pick(m_board, m_random());
+
+        if (move) {
+            m_search.wait();
+            best_move({*move});
+            return;
+        }
+    }
+
+    m_search.start(
+        m_board, limits,
+        [this](const Search::Report &iteration) { report(iteration); },
+        [this](const std::vector<Move> &pv) { best_move(pv); });
+}
+
+void Uci::set_option(std::istringstream &args) {
+    std::string token;
+    std::string name;
+    std::string value;
+
+    args >> token;
+
+    while (args >> token && token != "value") {
+        name += name.empty() ? token : " " + token;
+    }
+
+    std::getline(args >> std::ws, value);
+
+    if (name == "Ponder") {
+        m_ponder = value == "true";
+    } else if (name == "BookFile") {
+        if (value.empty() || value == "<empty>") {
+            m_book.close();
+        } else if (!m_book.open(value)) {
+            send("info string cannot open book " + value);
+        }
+    } else {
+        const auto technique = std::find_if(
+            TECHNIQUES.begin(), TECHNIQUES.end(),
+            [&name](const auto &entry) { return entry.first == name; });
+
+        if (technique == TECHNIQUES.end()) {
+            send("info string unknown option " + name);
+            return;
+        }
+
+        // Read by the next search, the running one keeps its own copy
+        Search::Options options = m_search.options();
+        options.*(technique->second) = value == "true";
+        m_search.set_options(options);
+    }
+}
+
+void Uci::report(const Search::Report &iteration) {
+    std::ostringstream line;
+
+    line << "info depth " << iteration.m_depth << " score ";
+
+    if (std::abs(iteration.m_score) > Search::MATE_SCORE - Search::MAX_PLY) {
+        const int32_t plies = Search::MATE_SCORE - std::abs(iteration.m_score);
+        line << "mate "
+             << (iteration.m_score > 0 ? (plies + 1) / 2 : -(plies / 2));
+    } else {
+        line << "cp " << iteration.m_score;
+    }
+
+    const int64_t elapsed = std::max<int64_t>(1, iteration.m_elapsed);
+
+    line << " nodes " << iteration.m_nodes << " nps "
+         << iteration.m_nodes * 1000 / static_cast<uint64_t>(elapsed)
+         << " time " << iteration.m_elapsed << " pv";
+
+    for (const auto &move : iteration.m_pv) {
+        line << " " << move.to_uci();
+    }
+
+    send(line.str());
+}
+
+void Uci::best_move(const std::vector<Move> &pv) {
+    if (pv.empty()) {
+        send("bestmove 0000");
+        return;
+    }
+
+    std::string line = "bestmove " + pv.front().to_uci();
+
+    if (m_ponder && pv.size() > 1) {
+        line += " ponder " + pv[1].to_uci();
+    }
+
+    send(line);
+}
+}    // namespace dreamchess
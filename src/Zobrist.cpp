@@ -0,0 +1,115 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+
+#include "Zobrist.hpp"
+
+#include <array>
+
+/**
+ * @namespace dreamchess
+ * @brief The only namespace used to contain the DreamChess++ logic
+ * @details Used to avoid the std namespace pollution
+ */
+namespace dreamchess {
+namespace {
+constexpr uint16_t CASTLING_OFFSET{768};
+constexpr uint16_t EN_PASSANT_OFFSET{772};
+constexpr uint16_t TURN_OFFSET{780};
+
+/**
+ * @brief Fills the table with a SplitMix64 sequence
+ */
+constexpr std::array<uint64_t, Zobrist::TABLE_SIZE> make_table() {
+    std::array<uint64_t, Zobrist::TABLE_SIZE> table{};
+    uint64_t state = 0x3243F6A8885A308DULL;
+
+    for (auto &value : table) {
+        state += 0x9E3779B97F4A7C15ULL;
+
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value = z ^ (z >> 31);
+    }
+
+    return table;
+}
+
+constexpr std::array<uint64_t, Zobrist::TABLE_SIZE> TABLE{make_table()};
+
+/**
+ * @brief Polyglot piece kind: BLACK_PAWN 0, WHITE_PAWN 1, ..., WHITE_KING 11
+ */
+uint16_t kind(Board::piece_t piece) {
+    uint16_t type = 0;
+
+    for (uint16_t bits = Piece::type(piece); bits > 1; bits >>= 1) {
+        type++;
+    }
+
+    return type * 2 + (Piece::color(piece) == Piece::WHITE ? 1 : 0);
+}
+}    // namespace
+
+[[nodiscard]] uint64_t Zobrist::key(const Board &board) {
+    uint64_t key = 0;
+
+    for (uint16_t square = 0; square < 64; square++) {
+        if (board.piece_at(square) != Piece::NONE) {
+            key ^= piece(board.piece_at(square), square);
+        }
+    }
+
+    key ^= castling(board.castling_rights());
+    key ^= en_passant(board);
+
+    if (board.turn() == Piece::WHITE) {
+        key ^= turn();
+    }
+
+    return key;
+}
+
+[[nodiscard]] uint64_t Zobrist::piece(Board::piece_t piece, uint16_t square) {
+    return TABLE[64 * kind(piece) + square];
+}
+
+[[nodiscard]] uint64_t Zobrist::castling(uint8_t rights) {
+    uint64_t key = 0;
+
+    for (uint16_t i = 0; i < 4; i++) {
+        if (rights & (1 << i)) {
+            key ^= TABLE[CASTLING_OFFSET + i];
+        }
+    }
+
+    return key;
+}
+
+[[nodiscard]] uint64_t Zobrist::en_passant(const Board &board) {
+    const int16_t target = board.en_passant();
+
+    if (target == Board::NO_SQUARE) {
+        return 0;
+    }
+
+    // The pawn which can capture stands beside the one which double stepped
+    const int16_t rank = board.turn() == Piece::WHITE ? 4 : 3;
+    const Board::piece_t pawn = Piece::PAWN | board.turn();
+    const int16_t file = target % 8;
+
+    if ((file > 0 && board.piece_at(rank * 8 + file - 1) == pawn) ||
+        (file < 7 && board.piece_at(rank * 8 + file + 1) == pawn)) {
+        return TABLE[EN_PASSANT_OFFSET + file];
+    }
+
+    return 0;
+}
+
+[[nodiscard]] uint64_t Zobrist::turn() { return TABLE[TURN_OFFSET]; }
+}    // namespace dreamchess
@@ -0,0 +1,88 @@
+#include "Batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "Game.hpp"
+
+class BatchTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+};
+
+TEST_F(BatchTest, GamesAreReplayedOnePerLine) {
+    std::istringstream input{
+        "e2-e4 e7-e5 g1-f3\n"
+        "\n"
+        "# a comment\n"
+        "  d2-d4\td7-d5  \r\n"};
+
+    dreamchess::Batch batch{output};
+    batch.run(input);
+
+    dreamchess::Game first{};
+    ASSERT_TRUE(first.make_move("e2-e4"));
+    ASSERT_TRUE(first.make_move("e7-e5"));
+    ASSERT_TRUE(first.make_move("g1-f3"));
+
+    dreamchess::Game second{};
+    ASSERT_TRUE(second.make_move("d2-d4"));
+    ASSERT_TRUE(second.make_move("d7-d5"));
+
+    ASSERT_EQ(output.str(), "1 ok 3 " + first.board().fen() + "\n2 ok 2 " +
+                                second.board().fen() + "\n");
+    ASSERT_EQ(batch.totals().m_games, 2);
+    ASSERT_EQ(batch.totals().m_moves, 5);
+    ASSERT_EQ(batch.totals().m_rejected, 0);
+}
+
+TEST_F(BatchTest, GamesStopAtTheFirstRejectedMove) {
+    dreamchess::Batch batch{output};
+    batch.play("e2-e4 e2-e4 d2-d4");
+    batch.play("e2-e4 e7-e5 x");
+    // The rules are permissive, the game ends once a king is taken
+    batch.play("f2-f3 e7-e5 g2-g4 d8-h4 a2-a3 h4-e1");
+    batch.finish();
+
+    dreamchess::Game game{};
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    const std::string one = game.board().fen();
+    ASSERT_TRUE(game.make_move("e7-e5"));
+    const std::string two = game.board().fen();
+
+    std::istringstream lines{output.str()};
+    std::string line;
+
+    ASSERT_TRUE(std::getline(lines, line));
+    ASSERT_EQ(line, "1 illegal 1 e2-e4 " + one);
+    ASSERT_TRUE(std::getline(lines, line));
+    ASSERT_EQ(line, "2 syntax 2 x " + two);
+    ASSERT_TRUE(std::getline(lines, line));
+    ASSERT_EQ(line.rfind("3 over 6 ", 0), 0);
+
+    ASSERT_EQ(batch.totals().m_rejected, 2);
+}
+
+TEST_F(BatchTest, MovesAfterADrawAreRejected) {
+    dreamchess::Batch batch{output};
+    batch.play("g1-f3 g8-f6 f3-g1 f6-g8 g1-f3 g8-f6 f3-g1 f6-g8 e2-e4 e7-e5");
+    batch.finish();
+
+    ASSERT_EQ(output.str(), "1 over 8 e2-e4 rnbqkbnr/pppppppp/8/8/8/8/"
+                            "PPPPPPPP/RNBQKBNR w KQkq - 8 5\n");
+    ASSERT_EQ(batch.totals().m_moves, 8);
+    ASSERT_EQ(batch.totals().m_rejected, 1);
+}
+
+TEST_F(BatchTest, ResultsAreBuffered) {
+    dreamchess::Batch batch{output};
+    batch.play("e2-e4");
+
+    ASSERT_TRUE(output.str().empty());
+
+    batch.finish();
+
+    ASSERT_FALSE(output.str().empty());
+}
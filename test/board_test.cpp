@@ -2,7 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include "Move.hpp"
+#include "MoveGenerator.hpp"
 
 class BoardTest : public ::testing::Test {
 protected:
@@ -84,3 +88,199 @@ TEST_F(BoardTest, BoardIsCreatedCorrectly) {
     ASSERT_TRUE(bishop_check());
     ASSERT_TRUE(royals_check());
 }
+
+TEST_F(BoardTest, FenIsRoundTripped) {
+    ASSERT_EQ(board.fen(), std::string{dreamchess::Board::START_FEN});
+
+    const std::string fen =
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b Kq e3 4 17";
+
+    ASSERT_TRUE(board.load_fen(fen));
+    ASSERT_EQ(board.fen(), fen);
+    ASSERT_EQ(board.castling_rights(),
+              dreamchess::Board::WHITE_KINGSIDE |
+                  dreamchess::Board::BLACK_QUEENSIDE);
+    ASSERT_EQ(board.en_passant(), 20);
+    ASSERT_EQ(board.halfmove_clock(), 4);
+    ASSERT_EQ(board.fullmove_number(), 17);
+}
+
+TEST_F(BoardTest, MalformedFenIsRejected) {
+    ASSERT_FALSE(board.load_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq -"));
+    ASSERT_FALSE(board.load_fen("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR "
+                                "w KQkq - 0 1"));
+    ASSERT_FALSE(board.load_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR "
+                                "x KQkq - 0 1"));
+    ASSERT_FALSE(board.load_fen("4k2P/8/8/8/8/8/8/4K3 w - - 0 1"));
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/8/8/8/p3K3 b - - 0 1"));
+
+    // More Moves than a MoveList holds
+    ASSERT_FALSE(board.load_fen(
+        "QQQQQ1Qk/7Q/Q6Q/2Q4Q/Q4Q2/2Q3QQ/Q6Q/KQQQQQ1Q w - - 0 1"));
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/8/8/PPPPPPPP/3PK3 w - - 0 1"));
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/8/8/8/8 w - - 0 1"));
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/8/8/8/3KK3 w - - 0 1"));
+
+    // The en-passant square doesn't match the side to move or the pawns
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/4P3/8/8/4K3 w - e3 0 1"));
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/8/8/8/4K3 b - e3 0 1"));
+    ASSERT_FALSE(board.load_fen("4k3/8/8/4p3/8/8/8/4K3 b - e6 0 1"));
+    ASSERT_TRUE(royals_check());
+}
+
+TEST_F(BoardTest, MovesUpdateTheState) {
+    board.make_move(dreamchess::Move{12, 28, dreamchess::Piece::WHITE_PAWN,
+                                     dreamchess::Piece::NONE});
+
+    ASSERT_EQ(board.en_passant(), 20);
+    ASSERT_EQ(board.turn(), dreamchess::Piece::BLACK);
+
+    board.make_move(dreamchess::Move{62, 45, dreamchess::Piece::BLACK_KNIGHT,
+                                     dreamchess::Piece::NONE});
+
+    ASSERT_EQ(board.en_passant(), dreamchess::Board::NO_SQUARE);
+    ASSERT_EQ(board.halfmove_clock(), 1);
+    ASSERT_EQ(board.fullmove_number(), 2);
+
+    board.make_move(dreamchess::Move{4, 12, dreamchess::Piece::WHITE_KING,
+                                     dreamchess::Piece::NONE});
+
+    ASSERT_EQ(board.castling_rights(), dreamchess::Board::BLACK_KINGSIDE |
+                                           dreamchess::Board::BLACK_QUEENSIDE);
+}
+
+TEST_F(BoardTest, MaterialKeyFollowsMoves) {
+    using dreamchess::Piece;
+
+    ASSERT_EQ(board.material_count(board.material_key(), Piece::WHITE_PAWN),
+              8);
+    ASSERT_EQ(board.material_count(board.material_key(), Piece::BLACK_KING),
+              1);
+    ASSERT_EQ(board.material_count(board.material_key(), Piece::NONE), 0);
+
+    // Captures, promotions and en-passant, both ways
+    ASSERT_TRUE(board.load_fen("r3k2r/pPppqpb1/bn2pnp1/3PN3/1p2P3/"
+                               "2N2Q2/PpPBBPPP/R3K2R b KQkq - 0 1"));
+
+    uint64_t seed = 7;
+
+    for (int ply = 0; ply < 200; ply++) {
+        dreamchess::MoveList moves;
+        dreamchess::MoveGenerator::legal(board, moves);
+
+        if (moves.size() == 0) {
+            break;
+        }
+
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        const dreamchess::Move move = moves[(seed >> 33) % moves.size()];
+
+        const uint64_t before = board.material_key();
+        const dreamchess::Board::Undo undo = board.undo(move);
+
+        board.make_move(move);
+
+        dreamchess::Board loaded;
+        ASSERT_TRUE(loaded.load_fen(board.fen()));
+        ASSERT_EQ(board.material_key(), loaded.material_key());
+
+        board.unmake_move(move, undo);
+        ASSERT_EQ(board.material_key(), before);
+        board.make_move(move);
+    }
+}
+
+TEST_F(BoardTest, PositionsArePackedIn32Bytes) {
+    const std::vector<std::string> fens{
+        std::string{dreamchess::Board::START_FEN},
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b Kq - 3 42",
+        "8/8/8/8/4pP2/8/8/k6K b - f3 0 300", "8/8/8/8/8/8/8/4K2k w - - 99 1"};
+
+    for (const auto &fen : fens) {
+        ASSERT_TRUE(board.load_fen(fen));
+
+        const auto packed = board.pack();
+        ASSERT_TRUE(packed);
+
+        dreamchess::Board unpacked{};
+        ASSERT_TRUE(unpacked.unpack(*packed));
+        ASSERT_EQ(unpacked.fen(), fen);
+        ASSERT_EQ(unpacked.material_key(), board.material_key());
+    }
+
+    // A side never has more than 16 Pieces, so every Board packs
+    ASSERT_FALSE(board.load_fen("4k3/8/8/8/8/NNNNNNNN/NNNNNNNN/4K3 w - - 0 1"));
+
+    dreamchess::Board::packed_t malformed{};
+    malformed[0] = 1;
+    ASSERT_FALSE(board.unpack(malformed));
+
+    // A white PAWN on a1
+    malformed[8] = 1;
+    ASSERT_FALSE(board.unpack(malformed));
+
+    // A packed position with no KING, or two of them
+    ASSERT_TRUE(board.load_fen("4k3/8/8/8/8/8/8/4K3 w - - 0 1"));
+    auto packed = *board.pack();
+    ASSERT_TRUE(board.unpack(packed));
+
+    packed[8] = 0x55;
+    ASSERT_FALSE(board.unpack(packed));
+
+    packed[8] = 0xEE;
+    ASSERT_FALSE(board.unpack(packed));
+}
+
+TEST_F(BoardTest, AttackMapCountsAttackers) {
+    const auto &white = board.attack_map(dreamchess::Piece::WHITE);
+
+    // Pawns and knights only, the other Pieces defend each other
+    ASSERT_EQ(white.m_attackers[21], 3);
+    ASSERT_EQ(white.m_attackers[19], 2);
+    ASSERT_EQ(white.m_attackers[16], 2);
+    ASSERT_EQ(white.m_attackers[3], 1);
+    ASSERT_EQ(white.m_attackers[0], 0);
+    ASSERT_EQ(white.m_attacked >> 24, 0);
+
+    board.make_move(dreamchess::Move{12, 28, dreamchess::Piece::WHITE_PAWN,
+                                     dreamchess::Piece::NONE});
+
+    // The map follows the Board, the f1 bishop now sees a6
+    const auto &moved = board.attack_map(dreamchess::Piece::WHITE);
+    ASSERT_EQ(moved.m_attackers[40], 1);
+    ASSERT_EQ(moved.m_attackers[35], 1);
+    ASSERT_EQ(moved.m_attackers[37], 1);
+    ASSERT_EQ(moved.m_attackers[39], 1);
+}
+
+TEST_F(BoardTest, AttackMapMatchesTheMoveGenerator) {
+    ASSERT_TRUE(board.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/"
+                               "2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+    uint64_t seed = 11;
+
+    for (int ply = 0; ply < 200; ply++) {
+        for (const auto color :
+             {dreamchess::Piece::WHITE, dreamchess::Piece::BLACK}) {
+            const auto &map = board.attack_map(color);
+
+            for (int16_t square = 0; square < 64; square++) {
+                ASSERT_EQ(map.m_attackers[square] != 0,
+                          dreamchess::MoveGenerator::attacked(board, square,
+                                                              color));
+                ASSERT_EQ(board.square_attacked(square, color),
+                          map.m_attackers[square] != 0);
+            }
+        }
+
+        dreamchess::MoveList moves;
+        dreamchess::MoveGenerator::legal(board, moves);
+
+        if (moves.size() == 0) {
+            break;
+        }
+
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        board.make_move(moves[(seed >> 33) % moves.size()]);
+    }
+}
@@ -0,0 +1,220 @@
+#include "Book.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "Game.hpp"
+#include "MoveGenerator.hpp"
+#include "Zobrist.hpp"
+
+class BookTest : public ::testing::Test {
+protected:
+    const std::string path{"book_test.bin"};
+    dreamchess::Book book{};
+
+    struct Record {
+        uint64_t m_key;
+        uint16_t m_move;
+        uint16_t m_weight;
+    };
+
+    std::vector<Record> records{};
+
+    void add(std::string_view fen, std::string_view moves, std::string_view uci,
+             uint16_t weight) {
+        dreamchess::Board board{};
+        board.load_fen(fen);
+
+        std::stringstream stream{std::string{moves}};
+        std::string played;
+
+        while (stream >> played) {
+            board.make_move(
+                *dreamchess::MoveGenerator::from_uci(board, played));
+        }
+
+        dreamchess::Move move{};
+
+        const auto legal = dreamchess::MoveGenerator::from_uci(board, uci);
+
+        if (legal) {
+            move = *legal;
+        } else {
+            // Illegal Moves are encoded by hand, they must be filtered out
+            move = dreamchess::Move{(uci[1] - '1') * 8 + (uci[0] - 'a'),
+                                    (uci[3] - '1') * 8 + (uci[2] - 'a'),
+                                    dreamchess::Piece::WHITE_PAWN,
+                                    dreamchess::Piece::NONE};
+        }
+
+        records.push_back(Record{dreamchess::Zobrist::key(board),
+                                 dreamchess::Book::encode(move), weight});
+    }
+
+    void write() {
+        std::stable_sort(records.begin(), records.end(),
+                         [](const Record &lhs, const Record &rhs) {
+                             return lhs.m_key < rhs.m_key;
+                         });
+
+        std::ofstream file{path, std::ios::binary};
+
+        for (const auto &record : records) {
+            uint8_t bytes[dreamchess::Book::ENTRY_SIZE]{};
+
+            for (int i = 0; i < 8; i++) {
+                bytes[i] = static_cast<uint8_t>(record.m_key >> (56 - 8 * i));
+            }
+
+            bytes[8] = static_cast<uint8_t>(record.m_move >> 8);
+            bytes[9] = static_cast<uint8_t>(record.m_move);
+            bytes[10] = static_cast<uint8_t>(record.m_weight >> 8);
+            bytes[11] = static_cast<uint8_t>(record.m_weight);
+
+            file.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+        }
+    }
+
+    void SetUp() override {
+        const std::string_view start = dreamchess::Board::START_FEN;
+
+        add(start, "", "e2e4", 3);
+        add(start, "", "d2d4", 1);
+        add(start, "", "e2e5", 100);
+        add(start, "e2e4", "e7e5", 1);
+        add("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1", "", "e1g1", 5);
+
+        write();
+
+        ASSERT_TRUE(book.open(path));
+    }
+
+    void TearDown() override {
+        book.close();
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(BookTest, EntriesAreFound) {
+    dreamchess::Book::entry_list_t entries;
+    dreamchess::Board board{};
+
+    ASSERT_EQ(book.size(), 5);
+    ASSERT_EQ(book.probe(board, entries), 2);
+    ASSERT_EQ(entries[0].m_move.to_uci(), "e2e4");
+    ASSERT_EQ(entries[0].m_weight, 3);
+    ASSERT_EQ(entries[1].m_move.to_uci(), "d2d4");
+
+    ASSERT_TRUE(board.load_fen("8/8/8/8/8/8/8/K6k w - - 0 1"));
+    ASSERT_EQ(book.probe(board, entries), 0);
+}
+
+TEST_F(BookTest, PickIsWeighted) {
+    const dreamchess::Board board{};
+
+    ASSERT_EQ(book.pick(board, 0)->to_uci(), "e2e4");
+    ASSERT_EQ(book.pick(board, 2)->to_uci(), "e2e4");
+    ASSERT_EQ(book.pick(board, 3)->to_uci(), "d2d4");
+}
+
+TEST_F(BookTest, CastlingIsDecoded) {
+    dreamchess::Board board{};
+    board.load_fen("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+
+    ASSERT_EQ(book.pick(board, 0)->to_uci(), "e1g1");
+}
+
+TEST_F(BookTest, GameQueriesTheBook) {
+    dreamchess::Game game{};
+
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_EQ(game.book_move(book, 42)->to_uci(), "e7e5");
+
+    ASSERT_TRUE(game.make_move("e7-e5"));
+    ASSERT_FALSE(game.book_move(book, 42));
+}
+
+TEST_F(BookTest, TranspositionsShareTheKey) {
+    dreamchess::Board first{};
+    dreamchess::Board second{};
+
+    for (const auto *move : {"g1f3", "g8f6", "b1c3"}) {
+        first.make_move(*dreamchess::MoveGenerator::from_uci(first, move));
+    }
+
+    for (const auto *move : {"b1c3", "g8f6", "g1f3"}) {
+        second.make_move(*dreamchess::MoveGenerator::from_uci(second, move));
+    }
+
+    ASSERT_EQ(dreamchess::Zobrist::key(first),
+              dreamchess::Zobrist::key(second));
+
+    // The en-passant file only counts when a capture is possible
+    first.load_fen("4k3/8/8/8/4P3/8/8/4K3 b - e3 0 1");
+    second.load_fen("4k3/8/8/8/4P3/8/8/4K3 b - - 0 1");
+    ASSERT_EQ(dreamchess::Zobrist::key(first),
+              dreamchess::Zobrist::key(second));
+
+    first.load_fen("4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1");
+    second.load_fen("4k3/8/8/8/3pP3/8/8/4K3 b - - 0 1");
+    ASSERT_NE(dreamchess::Zobrist::key(first),
+              dreamchess::Zobrist::key(second));
+}
+
+TEST_F(BookTest, ReferenceGamesFollowThePolyglotLayout) {
+    using dreamchess::Piece;
+    using dreamchess::Zobrist;
+
+    // The games of the Polyglot specification, move by move
+    dreamchess::Board board{};
+    uint64_t key = Zobrist::key(board);
+
+    const auto play = [&board, &key](std::string_view uci, uint64_t moved) {
+        const uint64_t en_passant = Zobrist::en_passant(board);
+        board.make_move(*dreamchess::MoveGenerator::from_uci(board, uci));
+
+        key ^= moved ^ Zobrist::turn() ^ en_passant ^
+               Zobrist::en_passant(board);
+        ASSERT_EQ(Zobrist::key(board), key) << uci;
+    };
+
+    const auto pawn = [](dreamchess::Board::piece_t pawn, uint16_t from,
+                         uint16_t to) {
+        return Zobrist::piece(pawn, from) ^ Zobrist::piece(pawn, to);
+    };
+
+    play("e2e4", pawn(Piece::WHITE_PAWN, 12, 28));
+    play("d7d5", pawn(Piece::BLACK_PAWN, 51, 35));
+    play("e4e5", pawn(Piece::WHITE_PAWN, 28, 36));
+    play("f7f5", pawn(Piece::BLACK_PAWN, 53, 37));
+    ASSERT_NE(Zobrist::en_passant(board), 0);
+
+    play("e1e2", Zobrist::piece(Piece::WHITE_KING, 4) ^
+                     Zobrist::piece(Piece::WHITE_KING, 12) ^
+                     Zobrist::castling(dreamchess::Board::WHITE_KINGSIDE |
+                                       dreamchess::Board::WHITE_QUEENSIDE));
+    play("e8f7", Zobrist::piece(Piece::BLACK_KING, 60) ^
+                     Zobrist::piece(Piece::BLACK_KING, 53) ^
+                     Zobrist::castling(dreamchess::Board::BLACK_KINGSIDE |
+                                       dreamchess::Board::BLACK_QUEENSIDE));
+
+    board = dreamchess::Board{};
+    key = Zobrist::key(board);
+
+    play("a2a4", pawn(Piece::WHITE_PAWN, 8, 24));
+    play("b7b5", pawn(Piece::BLACK_PAWN, 49, 33));
+    play("h2h4", pawn(Piece::WHITE_PAWN, 15, 31));
+    play("b5b4", pawn(Piece::BLACK_PAWN, 33, 25));
+    play("c2c4", pawn(Piece::WHITE_PAWN, 10, 26));
+    ASSERT_NE(Zobrist::en_passant(board), 0);
+
+    play("b4c3", pawn(Piece::BLACK_PAWN, 25, 18) ^
+                     Zobrist::piece(Piece::WHITE_PAWN, 26));
+    play("a1a3", Zobrist::piece(Piece::WHITE_ROOK, 0) ^
+                     Zobrist::piece(Piece::WHITE_ROOK, 16) ^
+                     Zobrist::castling(dreamchess::Board::WHITE_QUEENSIDE));
+}
@@ -0,0 +1,164 @@
+#include "Broadcast.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Game.hpp"
+#include "MoveGenerator.hpp"
+
+class BroadcastTest : public ::testing::Test {
+protected:
+    std::shared_ptr<dreamchess::Broadcast> broadcast =
+        std::make_shared<dreamchess::Broadcast>();
+
+    // A pseudo-random game: the input of every Move and the FEN of every ply
+    std::vector<std::string> inputs;
+    std::vector<std::string> fens;
+
+    void SetUp() override {
+        dreamchess::Game game{};
+        uint64_t seed = 47;
+
+        fens.push_back(game.board().fen());
+
+        for (int ply = 0; ply < 400; ply++) {
+            dreamchess::MoveList legal;
+            dreamchess::MoveGenerator::legal(game.board(), legal);
+
+            if (legal.size() == 0) {
+                break;
+            }
+
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const dreamchess::Move move = legal[(seed >> 33) % legal.size()];
+            std::string input = move.to_uci().insert(2, "-");
+
+            if (input.size() == 6) {
+                input.insert(5, "=");
+                input[6] = dreamchess::Piece::to_fen(move.promotion_piece());
+            }
+
+            ASSERT_TRUE(game.make_move(input)) << input;
+            inputs.push_back(input);
+            fens.push_back(game.board().fen());
+        }
+    }
+
+    [[nodiscard]] static std::string fen(
+        const dreamchess::Broadcast::Snapshot &snapshot) {
+        dreamchess::Board board{};
+        EXPECT_TRUE(board.unpack(snapshot.m_board));
+
+        return board.fen();
+    }
+};
+
+TEST_F(BroadcastTest, ChangesArePublished) {
+    ASSERT_FALSE(broadcast->snapshot());
+
+    dreamchess::Game game{};
+    auto cursor = broadcast->subscribe();
+    game.broadcast_to(broadcast);
+
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_FALSE(game.make_move("e2-e4"));
+    ASSERT_TRUE(game.make_move("e7-e5"));
+
+    const auto snapshot = broadcast->snapshot();
+    ASSERT_TRUE(snapshot);
+    ASSERT_EQ(snapshot->m_sequence, 3);
+    ASSERT_EQ(fen(*snapshot), game.board().fen());
+
+    auto event = broadcast->poll(cursor);
+    ASSERT_TRUE(event);
+    ASSERT_EQ(event->m_kind, dreamchess::Broadcast::Event::RESET);
+
+    event = broadcast->poll(cursor);
+    ASSERT_TRUE(event);
+    ASSERT_EQ(event->m_sequence, 1);
+    ASSERT_EQ(event->m_kind, dreamchess::Broadcast::Event::MOVE);
+    ASSERT_EQ(event->m_move,
+              dreamchess::Move(12, 28, dreamchess::Piece::WHITE_PAWN,
+                               dreamchess::Piece::NONE));
+
+    ASSERT_TRUE(broadcast->poll(cursor));
+    ASSERT_FALSE(broadcast->poll(cursor));
+
+    game.reset();
+    event = broadcast->poll(cursor);
+    ASSERT_EQ(event->m_kind, dreamchess::Broadcast::Event::RESET);
+    ASSERT_EQ(fen(*broadcast->snapshot()), dreamchess::Board::START_FEN);
+}
+
+TEST_F(BroadcastTest, SlowReadersLoseTheOldestEvents) {
+    dreamchess::Broadcast small{5};
+    ASSERT_EQ(small.capacity(), 8);
+
+    auto cursor = small.subscribe();
+    const dreamchess::Board board{};
+
+    for (int i = 0; i < 20; i++) {
+        small.publish_reset(board);
+    }
+
+    const auto event = small.poll(cursor);
+    ASSERT_TRUE(event);
+    ASSERT_EQ(event->m_sequence, 12);
+    ASSERT_EQ(cursor.m_lost, 12);
+    ASSERT_EQ(small.subscribe().m_next, 20);
+}
+
+TEST_F(BroadcastTest, ReadersNeverSeeTornPositions) {
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> failures{0};
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&] {
+            auto cursor = broadcast->subscribe();
+            uint64_t expected = cursor.m_next;
+
+            for (bool last = false; !last;) {
+                last = done.load();
+
+                if (const auto snapshot = broadcast->snapshot()) {
+                    const std::size_t ply = snapshot->m_sequence - 1;
+                    failures += fen(*snapshot) != fens[ply];
+                }
+
+                while (const auto event = broadcast->poll(cursor)) {
+                    failures += event->m_sequence != expected;
+                    expected = event->m_sequence + 1;
+
+                    if (event->m_kind == dreamchess::Broadcast::Event::MOVE) {
+                        const std::string &input =
+                            inputs[event->m_sequence - 1];
+                        failures += event->m_move.to_uci().substr(0, 4) !=
+                                    input.substr(0, 2) + input.substr(3, 2);
+                    }
+                }
+            }
+        });
+    }
+
+    dreamchess::Game game{};
+    game.broadcast_to(broadcast);
+
+    for (const auto &input : inputs) {
+        ASSERT_TRUE(game.make_move(input));
+    }
+
+    done = true;
+
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(failures, 0);
+    ASSERT_EQ(broadcast->snapshot()->m_sequence, inputs.size() + 1);
+}
@@ -0,0 +1,97 @@
+#include "Endgame.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include "Evaluation.hpp"
+#include "Move.hpp"
+
+class EndgameTest : public ::testing::Test {
+protected:
+    [[nodiscard]] static dreamchess::Endgame::Class classify(
+        std::string_view fen) {
+        dreamchess::Board board;
+        EXPECT_TRUE(board.load_fen(fen));
+
+        return dreamchess::Endgame::classify(board);
+    }
+
+    [[nodiscard]] static int32_t evaluate(std::string_view fen) {
+        dreamchess::Board board;
+        EXPECT_TRUE(board.load_fen(fen));
+
+        return dreamchess::Evaluation::evaluate(board);
+    }
+};
+
+TEST_F(EndgameTest, MaterialIsClassified) {
+    using dreamchess::Endgame;
+
+    EXPECT_EQ(classify(dreamchess::Board::START_FEN), Endgame::GENERIC);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/8 w - - 0 1"),
+              Endgame::INSUFFICIENT_MATERIAL);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/6n1 w - - 0 1"),
+              Endgame::INSUFFICIENT_MATERIAL);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/5B2 b - - 0 1"),
+              Endgame::INSUFFICIENT_MATERIAL);
+    EXPECT_EQ(classify("8/8/4k3/2b5/8/3K4/8/5B2 w - - 0 1"),
+              Endgame::BISHOPS_ONLY);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/1N4N1 w - - 0 1"), Endgame::KNNK);
+    EXPECT_EQ(classify("8/8/4k3/8/4P3/3K4/8/8 w - - 0 1"), Endgame::KPK);
+    EXPECT_EQ(classify("8/8/4k3/4p3/8/3K4/8/8 w - - 0 1"), Endgame::KPK);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/1N3B2 w - - 0 1"), Endgame::KBNK);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/7R w - - 0 1"), Endgame::KXK);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/q7 w - - 0 1"), Endgame::KXK);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/2B2B2 w - - 0 1"), Endgame::KXK);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/8/RR6 w - - 0 1"), Endgame::GENERIC);
+    EXPECT_EQ(classify("8/8/4k3/8/8/3K4/3P4/7R w - - 0 1"), Endgame::GENERIC);
+    EXPECT_EQ(classify("8/8/4k3/4p3/8/3K4/3P4/8 w - - 0 1"), Endgame::GENERIC);
+}
+
+TEST_F(EndgameTest, DeadDrawsAreDetected) {
+    dreamchess::Board board;
+
+    ASSERT_TRUE(board.load_fen("8/8/4k3/8/8/3K4/8/5B2 w - - 0 1"));
+    EXPECT_TRUE(dreamchess::Endgame::is_dead_draw(board));
+
+    // Both bishops on light squares, then on different colors
+    ASSERT_TRUE(board.load_fen("8/8/4k3/3b4/8/3K4/8/5B2 w - - 0 1"));
+    EXPECT_TRUE(dreamchess::Endgame::is_dead_draw(board));
+    ASSERT_TRUE(board.load_fen("8/8/4k3/2b5/8/3K4/8/5B2 w - - 0 1"));
+    EXPECT_FALSE(dreamchess::Endgame::is_dead_draw(board));
+
+    ASSERT_TRUE(board.load_fen("8/8/4k3/8/8/3K4/8/1N4N1 w - - 0 1"));
+    EXPECT_FALSE(dreamchess::Endgame::is_dead_draw(board));
+
+    // The last capture leaves a lone knight
+    ASSERT_TRUE(board.load_fen("4k3/8/8/8/8/8/3n4/4KR2 b - - 0 1"));
+    EXPECT_FALSE(dreamchess::Endgame::is_dead_draw(board));
+    board.make_move(dreamchess::Move{11, 5, dreamchess::Piece::BLACK_KNIGHT,
+                                     dreamchess::Piece::NONE});
+    EXPECT_TRUE(dreamchess::Endgame::is_dead_draw(board));
+}
+
+TEST_F(EndgameTest, EvaluationIsDispatched) {
+    using dreamchess::Evaluation;
+
+    EXPECT_EQ(evaluate("8/8/4k3/8/8/3K4/8/6n1 w - - 0 1"), 0);
+    EXPECT_EQ(evaluate("8/8/4k3/8/8/3K4/8/1N4N1 w - - 0 1"), 0);
+
+    // A rook pawn with the defending king in front is a draw
+    EXPECT_EQ(evaluate("k7/8/8/8/8/8/P7/1K6 w - - 0 1"), 0);
+    EXPECT_GT(evaluate("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"),
+              Evaluation::KNOWN_WIN);
+    EXPECT_LT(evaluate("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"),
+              -Evaluation::KNOWN_WIN);
+
+    // The bare king is better off in the center
+    EXPECT_GT(evaluate("8/8/8/8/8/8/8/k1K4R w - - 0 1"),
+              evaluate("8/8/8/3k4/8/8/8/2K4R w - - 0 1"));
+    EXPECT_GT(evaluate("8/8/8/3k4/8/8/8/2K4R w - - 0 1"),
+              Evaluation::KNOWN_WIN);
+
+    // In KBNK, only the corners of the bishop's color matter
+    EXPECT_GT(evaluate("k7/8/2K5/8/8/8/8/1N3B2 w - - 0 1"),
+              evaluate("7k/8/5K2/8/8/8/8/1N3B2 w - - 0 1"));
+}
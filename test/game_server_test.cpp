@@ -0,0 +1,129 @@
+#include "GameServer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+
+#include "SessionTable.hpp"
+
+TEST(GameServerTest, SessionsArePlayedThroughCommands) {
+    dreamchess::GameServer server{};
+    std::string reply;
+
+    server.execute("new", reply);
+    ASSERT_EQ(reply, "ok 1\n");
+
+    reply.clear();
+    server.execute("move 1 e2-e4", reply);
+    ASSERT_EQ(reply, "ok\n");
+
+    reply.clear();
+    server.execute("move 1 e2-e4", reply);
+    ASSERT_EQ(reply, "illegal\n");
+
+    reply.clear();
+    server.execute("move 1 e7e5", reply);
+    ASSERT_EQ(reply, "error malformed move\n");
+
+    reply.clear();
+    server.execute("move 2 e7-e5", reply);
+    ASSERT_EQ(reply, "error unknown session\n");
+
+    reply.clear();
+    server.execute("fen 1", reply);
+    ASSERT_EQ(reply,
+              "ok rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 "
+              "1\n");
+
+    reply.clear();
+    server.execute("targets 1 g8", reply);
+    ASSERT_EQ(reply, "ok f6 h6\n");
+
+    reply.clear();
+    server.execute("targets 1 e4", reply);
+    ASSERT_EQ(reply, "ok\n");
+
+    reply.clear();
+    server.execute("targets 1 e9", reply);
+    ASSERT_EQ(reply, "error malformed square\n");
+
+    reply.clear();
+    server.execute("resign 1", reply);
+    ASSERT_EQ(reply, "error unknown command\n");
+
+    reply.clear();
+    server.execute("close 1", reply);
+    ASSERT_EQ(reply, "ok\n");
+
+    reply.clear();
+    server.execute("close 1", reply);
+    ASSERT_EQ(reply, "error unknown session\n");
+
+    ASSERT_EQ(server.statistics().m_moves, 1);
+    ASSERT_EQ(server.statistics().m_illegal, 1);
+}
+
+TEST(GameServerTest, ClosedGamesAreReused) {
+    dreamchess::SessionTable sessions;
+
+    const auto first = sessions.open();
+    ASSERT_TRUE(sessions.with(
+        first, [](dreamchess::Game &game) { game.make_move("e2-e4"); }));
+    ASSERT_TRUE(sessions.close(first));
+    ASSERT_EQ(sessions.size(), 0);
+    ASSERT_EQ(sessions.pooled(), 1);
+
+    // A new id, on a Game back at the starting position
+    const auto second = sessions.open();
+    ASSERT_NE(first, second);
+    ASSERT_EQ(sessions.pooled(), 0);
+    ASSERT_TRUE(sessions.with(second, [](dreamchess::Game &game) {
+        ASSERT_EQ(game.history().size(), 0);
+    }));
+    ASSERT_FALSE(sessions.with(first, [](dreamchess::Game &) {}));
+}
+
+TEST(GameServerTest, CommandsAreServedOverTcp) {
+    dreamchess::GameServer server{2};
+    ASSERT_TRUE(server.listen_tcp(0));
+    ASSERT_NE(server.port(), 0);
+
+    std::thread serving{&dreamchess::GameServer::run, &server};
+
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in remote{};
+    remote.sin_family = AF_INET;
+    remote.sin_port = htons(server.port());
+    remote.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(
+        connect(fd, reinterpret_cast<sockaddr *>(&remote), sizeof(remote)),
+        0);
+
+    // Pipelined, the second command split across writes
+    const std::string request{"new\r\nmove 1 e2-e4\nmove 1 e7"};
+    ASSERT_EQ(write(fd, request.data(), request.size()),
+              static_cast<ssize_t>(request.size()));
+    ASSERT_EQ(write(fd, "-e5\n", 4), 4);
+
+    std::string replies;
+    char buffer[256];
+
+    while (replies != "ok 1\nok\nok\n") {
+        const ssize_t bytes = read(fd, buffer, sizeof(buffer));
+        ASSERT_GT(bytes, 0);
+        replies.append(buffer, static_cast<std::size_t>(bytes));
+    }
+
+    close(fd);
+    server.stop();
+    serving.join();
+
+    ASSERT_EQ(server.statistics().m_connections, 1);
+    ASSERT_EQ(server.statistics().m_moves, 2);
+}
@@ -0,0 +1,162 @@
+#include "GameStore.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "GameStoreWriter.hpp"
+#include "MoveGenerator.hpp"
+
+class GameStoreTest : public ::testing::Test {
+protected:
+    const std::string path{"game_store_test.dcgs"};
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    // Plays pseudo-random legal moves from a position
+    static void play(dreamchess::Board &board, dreamchess::History &history,
+                     std::size_t plies, uint64_t seed) {
+        for (std::size_t ply = 0; ply < plies; ply++) {
+            dreamchess::MoveList moves;
+            dreamchess::MoveGenerator::legal(board, moves);
+
+            if (moves.size() == 0) {
+                break;
+            }
+
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const dreamchess::Move move = moves[(seed >> 33) % moves.size()];
+
+            history.add_step(board, move);
+            board.make_move(move);
+        }
+    }
+};
+
+TEST_F(GameStoreTest, GamesAreStoredAndReplayed) {
+    std::vector<dreamchess::Board> boards;
+    std::vector<dreamchess::History> histories;
+
+    dreamchess::GameStoreWriter writer;
+    ASSERT_TRUE(writer.open(path));
+
+    for (uint64_t seed = 0; seed < 10; seed++) {
+        dreamchess::Board board{};
+
+        if (seed % 3 == 0) {
+            ASSERT_TRUE(board.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/"
+                                       "2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1"));
+        }
+
+        dreamchess::History history;
+        play(board, history, 50 + seed * 20, seed);
+
+        dreamchess::Pgn::Tags tags;
+        tags.m_white = "White " + std::to_string(seed);
+
+        ASSERT_TRUE(writer.add(tags, board, history));
+
+        boards.push_back(board);
+        histories.push_back(std::move(history));
+    }
+
+    ASSERT_EQ(writer.size(), 10);
+    ASSERT_TRUE(writer.close());
+
+    dreamchess::GameStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(store.size(), 10);
+
+    // Backwards, any game is reached directly
+    for (std::size_t game = store.size(); game-- > 0;) {
+        const auto record = store.record(game);
+
+        ASSERT_TRUE(record.has_value());
+        ASSERT_EQ(record->m_tags[4], "White " + std::to_string(game));
+        ASSERT_EQ(record->m_tags[0], "?");
+        ASSERT_EQ(record->m_fen.empty(), game % 3 != 0);
+        ASSERT_EQ(record->m_result, dreamchess::Pgn::result(boards[game]));
+        ASSERT_EQ(record->m_plies, histories[game].size());
+
+        std::vector<dreamchess::Move> moves;
+        dreamchess::Board board{};
+        const auto plies = store.replay(
+            game, board,
+            [&moves](const dreamchess::Board &, const dreamchess::Move &move) {
+                moves.push_back(move);
+            });
+
+        ASSERT_TRUE(plies.has_value());
+        ASSERT_EQ(*plies, histories[game].size());
+        ASSERT_EQ(board.fen(), boards[game].fen());
+
+        for (std::size_t ply = 0; ply < moves.size(); ply++) {
+            ASSERT_EQ(moves[ply], histories[game].move(ply));
+        }
+    }
+
+    ASSERT_FALSE(store.record(10).has_value());
+}
+
+TEST_F(GameStoreTest, PgnGamesAreStored) {
+    const std::string game{
+        "[Event \"Club\"]\n[White \"Alice\"]\n[Black \"Bob\"]\n"
+        "[Result \"1-0\"]\n\n1. e4 e5 2. Bc4 Nc6 3. Qh5 Nf6 4. Qxf7# 1-0\n"};
+
+    dreamchess::GameStoreWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.add_pgn(game));
+    ASSERT_FALSE(writer.add_pgn("1. e4 e4 *"));
+    ASSERT_TRUE(writer.close());
+
+    dreamchess::GameStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(store.size(), 1);
+
+    const auto record = store.record(0);
+    ASSERT_TRUE(record.has_value());
+    ASSERT_EQ(record->m_tags[0], "Club");
+    ASSERT_EQ(record->m_tags[1], "");
+    ASSERT_EQ(record->m_tags[5], "Bob");
+    ASSERT_EQ(record->m_result, "1-0");
+    ASSERT_EQ(record->m_plies, 7);
+
+    dreamchess::Board board{};
+    ASSERT_EQ(store.replay(0, board), 7);
+    ASSERT_TRUE(dreamchess::MoveGenerator::in_check(board));
+}
+
+TEST_F(GameStoreTest, IllegalGamesAreRejected) {
+    // The interactive Game is more permissive than the full rules
+    dreamchess::Game game{};
+    ASSERT_TRUE(game.make_move("f1-c4"));
+
+    dreamchess::GameStoreWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_FALSE(writer.add({}, game.board(), game.history()));
+    ASSERT_EQ(writer.size(), 0);
+    ASSERT_TRUE(writer.close());
+
+    dreamchess::GameStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(store.size(), 0);
+}
+
+TEST_F(GameStoreTest, MalformedFilesAreRejected) {
+    dreamchess::GameStore store;
+
+    ASSERT_FALSE(store.open(path));
+
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "DCGS not a game store at all";
+    }
+
+    ASSERT_FALSE(store.open(path));
+    ASSERT_EQ(store.size(), 0);
+}
@@ -3,6 +3,8 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include "Piece.hpp"
 
@@ -279,6 +281,168 @@ TEST_F(GameTest, KingsideCastleIsCorrect) {
     game.reset();
 }
 
+TEST_F(GameTest, CastlingThroughCheckIsRejected) {
+    ASSERT_TRUE(game.make_move("g1-f3"));
+    ASSERT_TRUE(game.make_move("b7-b6"));
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_TRUE(game.make_move("c8-a6"));
+    ASSERT_TRUE(game.make_move("f1-h3"));
+    ASSERT_TRUE(game.make_move("a7-a5"));
+
+    // The a6 bishop attacks f1
+    ASSERT_FALSE(game.make_move("e1-g1"));
+}
+
+TEST_F(GameTest, MoveSyntaxIsChecked) {
+    ASSERT_TRUE(dreamchess::Game::is_move_syntax_correct("e2-e4"));
+    ASSERT_TRUE(dreamchess::Game::is_move_syntax_correct("e7-e8=Q"));
+    ASSERT_TRUE(dreamchess::Game::is_move_syntax_correct("a2-a1=n"));
+    ASSERT_FALSE(dreamchess::Game::is_move_syntax_correct("e2e4"));
+    ASSERT_FALSE(dreamchess::Game::is_move_syntax_correct("e2-e9"));
+    ASSERT_FALSE(dreamchess::Game::is_move_syntax_correct("i2-e4"));
+    ASSERT_FALSE(dreamchess::Game::is_move_syntax_correct("e7-e8=K"));
+    ASSERT_FALSE(dreamchess::Game::is_move_syntax_correct("e7-e8Q"));
+    ASSERT_FALSE(dreamchess::Game::is_move_syntax_correct("e2-e4 "));
+}
+
+TEST_F(GameTest, DestinationsMatchMakeMove) {
+    // Castling, en-passant, a promotion and the permissive rules
+    const std::vector<std::string> moves{"e2-e4", "d7-d5", "e4-e5", "f7-f5",
+                                         "g1-f3", "d5-d4", "f1-c4", "d4-d3",
+                                         "e1-g1", "d3-c2", "e5-f6", ""};
+
+    for (std::size_t ply = 0; ply < moves.size(); ply++) {
+        const auto &destinations = game.destinations();
+
+        for (uint16_t source = 0; source < 64; source++) {
+            for (uint16_t destination = 0; destination < 64; destination++) {
+                dreamchess::Game trial{};
+
+                for (std::size_t played = 0; played < ply; played++) {
+                    ASSERT_TRUE(trial.make_move(moves[played]));
+                }
+
+                const std::string input{
+                    static_cast<char>('a' + source % 8),
+                    static_cast<char>('1' + source / 8), '-',
+                    static_cast<char>('a' + destination % 8),
+                    static_cast<char>('1' + destination / 8)};
+
+                ASSERT_EQ(destinations[source] >> destination & 1,
+                          trial.make_move(input))
+                    << ply << " " << input;
+            }
+
+            ASSERT_EQ(game.destinations(source), destinations[source]);
+        }
+
+        if (!moves[ply].empty()) {
+            ASSERT_TRUE(game.make_move(moves[ply]));
+        }
+    }
+
+    ASSERT_EQ(game.destinations(64), 0);
+}
+
 TEST_F(GameTest, BoardIsPrintedCorrectly) {
     ASSERT_TRUE(terminal_output_check());
-}
\ No newline at end of file
+}
+
+TEST_F(GameTest, ThreefoldRepetitionEndsTheGame) {
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(game.draw_reason(), dreamchess::Game::NO_DRAW);
+
+        ASSERT_TRUE(game.make_move("g1-f3"));
+        ASSERT_TRUE(game.make_move("g8-f6"));
+        ASSERT_TRUE(game.make_move("f3-g1"));
+        ASSERT_TRUE(game.make_move("f6-g8"));
+    }
+
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::THREEFOLD_REPETITION);
+    ASSERT_FALSE(game.is_in_game());
+
+    game.reset();
+    ASSERT_TRUE(game.is_in_game());
+}
+
+TEST_F(GameTest, IrreversibleMovesBreakRepetitions) {
+    const auto knights_out_and_back = [this] {
+        return game.make_move("g1-f3") && game.make_move("g8-f6") &&
+               game.make_move("f3-g1") && game.make_move("f6-g8");
+    };
+
+    ASSERT_TRUE(knights_out_and_back());
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_TRUE(game.make_move("e7-e5"));
+    ASSERT_TRUE(knights_out_and_back());
+
+    // Each position occurred twice, on both sides of the pawn moves
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::NO_DRAW);
+
+    ASSERT_TRUE(knights_out_and_back());
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::THREEFOLD_REPETITION);
+    ASSERT_EQ(dreamchess::Game::describe(game.draw_reason()),
+              "threefold repetition");
+    game.reset();
+}
+
+TEST_F(GameTest, FiftyMoveRuleEndsTheGame) {
+    ASSERT_TRUE(game.load_pgn("[SetUp \"1\"]\n"
+                              "[FEN \"6k1/5ppp/8/8/8/8/8/R5K1 w - - 98 80\"]\n"
+                              "\n80. Kf1 Kf8 *\n"));
+
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::FIFTY_MOVES);
+    ASSERT_FALSE(game.is_in_game());
+    ASSERT_EQ(dreamchess::Game::describe(game.draw_reason()),
+              "fifty-move rule");
+
+    // A mate on the hundredth halfmove stands
+    ASSERT_TRUE(game.load_pgn("[SetUp \"1\"]\n"
+                              "[FEN \"6k1/5ppp/8/8/8/8/8/R5K1 w - - 99 80\"]\n"
+                              "\n80. Ra8# *\n"));
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::NO_DRAW);
+    game.reset();
+}
+
+TEST_F(GameTest, InsufficientMaterialEndsTheGame) {
+    ASSERT_TRUE(game.load_pgn("[SetUp \"1\"]\n"
+                              "[FEN \"4k3/8/8/8/8/8/3n4/4KR2 b - - 0 1\"]\n"
+                              "\n1... Nxf1 *\n"));
+
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::INSUFFICIENT_MATERIAL);
+    ASSERT_FALSE(game.is_in_game());
+
+    game.reset();
+    ASSERT_EQ(game.draw_reason(), dreamchess::Game::NO_DRAW);
+}
+
+TEST_F(GameTest, EngineMovesAreTimedAndPlayed) {
+    dreamchess::Search::Limits limits{};
+    limits.m_time = {2000, 2000};
+    limits.m_increment = {20, 20};
+
+    for (int ply = 0; ply < 6; ply++) {
+        ASSERT_TRUE(game.engine_move(limits));
+    }
+
+    ASSERT_EQ(game.history().size(), 6);
+
+    const dreamchess::TimeManager::Statistics statistics =
+        game.engine_statistics();
+    ASSERT_EQ(statistics.m_moves, 6);
+
+    // Moves searched to a node limit have no deadline
+    limits = dreamchess::Search::Limits{};
+    limits.m_nodes = 5000;
+
+    ASSERT_TRUE(game.engine_move(limits));
+    ASSERT_EQ(game.engine_statistics().m_moves, 6);
+
+    // Once mated, the engine has no legal Move left
+    ASSERT_TRUE(game.load_pgn("[SetUp \"1\"]\n"
+                              "[FEN \"6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1\"]\n"
+                              "\n*\n"));
+    ASSERT_EQ(game.engine_move(limits)->to_uci(), "a1a8");
+    ASSERT_FALSE(game.engine_move(limits));
+    game.reset();
+}
@@ -0,0 +1,109 @@
+#include "History.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "MoveGenerator.hpp"
+#include "Piece.hpp"
+
+class HistoryTest : public ::testing::Test {
+protected:
+    dreamchess::History history{};
+    dreamchess::Board board{};
+
+    // Plays pseudo-random legal moves, returning the FEN before each one
+    std::vector<std::string> play(std::size_t plies) {
+        std::vector<std::string> fens;
+        uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+        for (std::size_t ply = 0; ply < plies; ply++) {
+            dreamchess::MoveList moves;
+            dreamchess::MoveGenerator::legal(board, moves);
+
+            if (moves.size() == 0) {
+                break;
+            }
+
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const dreamchess::Move move = moves[(seed >> 33) % moves.size()];
+
+            fens.push_back(board.fen());
+            history.add_step(board, move);
+            board.make_move(move);
+        }
+
+        return fens;
+    }
+};
+
+TEST_F(HistoryTest, ExportsEveryStep) {
+    dreamchess::Game game{};
+
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_TRUE(game.make_move("g8-f6"));
+
+    const std::string expected =
+        "1. e4\n2. " +
+        std::string{dreamchess::Piece::unicode_representation(
+            dreamchess::Piece::BLACK_KNIGHT)} +
+        "f6\n";
+
+    ASSERT_EQ(game.history().size(), 2);
+    ASSERT_EQ(game.history().export_all(), expected);
+}
+
+TEST_F(HistoryTest, StreamMatchesString) {
+    ASSERT_TRUE(board.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/"
+                               "PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+    const std::size_t plies = play(2000).size();
+    std::ostringstream stream;
+    history.export_all(stream);
+
+    ASSERT_GT(plies, 100);
+    ASSERT_GT(stream.str().size(), 4096);
+    ASSERT_EQ(stream.str(), history.export_all());
+}
+
+TEST_F(HistoryTest, RebuildsEveryPosition) {
+    ASSERT_TRUE(board.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/"
+                               "PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+    const std::vector<std::string> fens = play(400);
+
+    ASSERT_EQ(history.size(), fens.size());
+    ASSERT_EQ(history.position(board, history.size()).fen(), board.fen());
+
+    for (std::size_t ply = 0; ply < fens.size(); ply++) {
+        ASSERT_EQ(history.position(board, ply).fen(), fens[ply]) << ply;
+    }
+}
+
+TEST_F(HistoryTest, UnmakesSpecialMoves) {
+    const std::vector<std::string> fens{
+        "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 3 10",
+        "r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 3 10",
+        "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1",
+        "1n2k3/P7/8/8/8/8/8/4K3 w - - 0 1"};
+    const std::vector<std::string> moves{"e1g1", "e8c8", "e5d6", "a7b8n"};
+
+    for (std::size_t i = 0; i < fens.size(); i++) {
+        dreamchess::Board position{};
+        ASSERT_TRUE(position.load_fen(fens[i]));
+
+        const auto move =
+            dreamchess::MoveGenerator::from_uci(position, moves[i]);
+        ASSERT_TRUE(move.has_value());
+
+        const dreamchess::Board::Undo undo = position.undo(*move);
+        position.make_move(*move);
+        ASSERT_NE(position.fen(), fens[i]);
+
+        position.unmake_move(*move, undo);
+        ASSERT_EQ(position.fen(), fens[i]);
+    }
+}
@@ -0,0 +1,257 @@
+#include "Journal.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "MoveGenerator.hpp"
+
+class JournalTest : public ::testing::Test {
+protected:
+    const std::string path{"journal_test.dcj"};
+
+    // Both sides promote, black with a capture
+    const std::vector<std::string> moves{
+        "a2-a4", "h7-h5", "a4-a5", "h5-h4", "a5-a6", "h4-h3",
+        "a6-b7", "h3-g2", "b7-a8=N", "g2-h1=q", "g1-f3"};
+
+    void SetUp() override { std::remove(path.c_str()); }
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    void play(dreamchess::Game &game) {
+        for (const auto &move : moves) {
+            ASSERT_TRUE(game.make_move(move)) << move;
+        }
+    }
+
+    // Plays pseudo-random legal moves, returns the FEN of every ply
+    static std::vector<std::string> play_random(dreamchess::Game &game,
+                                                std::size_t plies,
+                                                uint64_t seed) {
+        std::vector<std::string> fens{game.board().fen()};
+
+        for (std::size_t ply = 0; ply < plies; ply++) {
+            dreamchess::MoveList legal;
+            dreamchess::MoveGenerator::legal(game.board(), legal);
+
+            if (legal.size() == 0) {
+                break;
+            }
+
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const dreamchess::Move move = legal[(seed >> 33) % legal.size()];
+            std::string input = move.to_uci().insert(2, "-");
+
+            if (input.size() == 6) {
+                input.insert(5, "=");
+                input[6] = dreamchess::Piece::to_fen(move.promotion_piece());
+            }
+
+            EXPECT_TRUE(game.make_move(input)) << input;
+            fens.push_back(game.board().fen());
+        }
+
+        return fens;
+    }
+};
+
+TEST_F(JournalTest, GameIsRecovered) {
+    dreamchess::Game game{};
+    ASSERT_TRUE(game.open_journal(path));
+    play(game);
+    ASSERT_TRUE(game.sync_journal());
+
+    // Recovered from the file while the first Game is still running
+    dreamchess::Game recovered{};
+    ASSERT_TRUE(recovered.open_journal(path));
+    ASSERT_TRUE(recovered.close_journal());
+
+    ASSERT_EQ(recovered.board().fen(), game.board().fen());
+    ASSERT_EQ(recovered.history().size(), moves.size());
+}
+
+TEST_F(JournalTest, TornRecordsAreCutOff) {
+    {
+        dreamchess::Game game{};
+        ASSERT_TRUE(game.open_journal(path));
+        play(game);
+        ASSERT_TRUE(game.close_journal());
+    }
+
+    // A crash in the middle of a record
+    std::ofstream{path, std::ios::binary | std::ios::app} << "\x12\x34\x56";
+
+    dreamchess::Game recovered{};
+    ASSERT_TRUE(recovered.open_journal(path));
+    ASSERT_EQ(recovered.history().size(), moves.size());
+
+    // Moves after the recovery follow the last whole record
+    ASSERT_TRUE(recovered.make_move("g8-f6"));
+    ASSERT_TRUE(recovered.close_journal());
+
+    const auto journaled = dreamchess::Journal::read(path);
+    ASSERT_TRUE(journaled);
+    ASSERT_EQ(journaled->m_moves.size(), moves.size() + 1);
+}
+
+TEST_F(JournalTest, ResetStartsANewGame) {
+    dreamchess::Game game{};
+    play(game);
+
+    // The Moves played before the journal is opened are written first
+    ASSERT_TRUE(game.open_journal(path));
+    ASSERT_TRUE(game.sync_journal());
+    ASSERT_EQ(dreamchess::Journal::read(path)->m_moves.size(), moves.size());
+
+    game.reset();
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_TRUE(game.close_journal());
+
+    const auto journaled = dreamchess::Journal::read(path);
+    ASSERT_TRUE(journaled);
+    ASSERT_EQ(journaled->m_moves.size(), 1);
+    ASSERT_EQ(journaled->m_moves[0].source(), 12);
+    ASSERT_EQ(journaled->m_moves[0].destination(), 28);
+}
+
+TEST_F(JournalTest, RecordsAreWrittenInBatches) {
+    dreamchess::Journal journal{};
+    ASSERT_TRUE(journal.open(path));
+
+    const dreamchess::Move move{12, 28, dreamchess::Piece::WHITE_PAWN,
+                                dreamchess::Piece::NONE};
+
+    for (int i = 0; i < 1000; i++) {
+        journal.append(move);
+    }
+
+    ASSERT_TRUE(journal.sync());
+    ASSERT_GE(journal.syncs(), 1);
+    ASSERT_LE(journal.syncs(), 1000);
+    ASSERT_TRUE(journal.close());
+    ASSERT_EQ(dreamchess::Journal::read(path)->m_moves.size(), 1000);
+}
+
+TEST_F(JournalTest, SeekStartsFromTheNearestSnapshot) {
+    dreamchess::Game game{};
+    ASSERT_TRUE(game.open_journal(path));
+    const std::vector<std::string> fens = play_random(game, 300, 46);
+    ASSERT_TRUE(game.close_journal());
+
+    const auto contents = dreamchess::Journal::read(path);
+    ASSERT_TRUE(contents);
+    ASSERT_EQ(contents->m_moves.size(), fens.size() - 1);
+    ASSERT_EQ(contents->m_snapshots.size(),
+              contents->m_moves.size() /
+                  dreamchess::Journal::SNAPSHOT_INTERVAL);
+
+    for (std::size_t ply = 0; ply < fens.size(); ply++) {
+        const auto board = dreamchess::Journal::seek(*contents, ply);
+        ASSERT_TRUE(board);
+        ASSERT_EQ(board->fen(), fens[ply]) << ply;
+    }
+
+    ASSERT_FALSE(dreamchess::Journal::seek(*contents, fens.size()));
+}
+
+TEST_F(JournalTest, ResumeReplaysTheMovesAfterTheLastSnapshot) {
+    std::string fen;
+
+    {
+        dreamchess::Game game{};
+        ASSERT_TRUE(game.open_journal(path));
+        fen = play_random(game, 200, 2021).back();
+    }
+
+    dreamchess::Game recovered{};
+    ASSERT_TRUE(recovered.open_journal(path));
+
+    const auto contents = dreamchess::Journal::read(path);
+    ASSERT_EQ(recovered.board().fen(), fen);
+    constexpr std::size_t interval = dreamchess::Journal::SNAPSHOT_INTERVAL;
+    ASSERT_EQ(recovered.history().size(), contents->m_moves.size());
+
+    // The resumed Game keeps the snapshots on the same plies
+    const std::vector<std::string> fens = play_random(recovered, 100, 7);
+    ASSERT_TRUE(recovered.close_journal());
+
+    const auto resumed = dreamchess::Journal::read(path);
+    ASSERT_EQ(resumed->m_snapshots.size(), resumed->m_moves.size() / interval);
+    ASSERT_EQ(dreamchess::Journal::seek(*resumed, resumed->m_moves.size())
+                  ->fen(),
+              fens.back());
+}
+
+TEST_F(JournalTest, ResumeKeepsTheWholeGame) {
+    // Pawn pushes, each followed by a knight shuffle which repeats once
+    const std::vector<std::string> pawns{
+        "a2-a3", "h7-h6", "a3-a4", "h6-h5", "a4-a5", "h5-h4", "b2-b3",
+        "g7-g6", "b3-b4", "g6-g5", "b4-b5", "g5-g4", "c2-c3", "f7-f6",
+        "c3-c4", "f6-f5", "d2-d3", "e7-e6", "d3-d4", "e6-e5", "e2-e3",
+        "d7-d6"};
+    const std::vector<std::string> shuffle{"g1-f3", "b8-c6", "f3-g1",
+                                           "c6-b8"};
+    std::string exported;
+
+    {
+        dreamchess::Game game{};
+        ASSERT_TRUE(game.open_journal(path));
+
+        for (std::size_t i = 0; i < pawns.size(); i += 2) {
+            ASSERT_TRUE(game.make_move(pawns[i]));
+            ASSERT_TRUE(game.make_move(pawns[i + 1]));
+
+            for (const auto &move : shuffle) {
+                ASSERT_TRUE(game.make_move(move)) << move;
+            }
+        }
+
+        // The first two occurrences straddle the snapshot
+        ASSERT_EQ(game.history().size(),
+                  dreamchess::Journal::SNAPSHOT_INTERVAL + 2);
+        exported = game.history().export_all();
+    }
+
+    dreamchess::Game recovered{};
+    ASSERT_TRUE(recovered.open_journal(path));
+    ASSERT_EQ(recovered.history().export_all(), exported);
+
+    for (const auto &move : shuffle) {
+        ASSERT_TRUE(recovered.is_in_game());
+        ASSERT_TRUE(recovered.make_move(move)) << move;
+    }
+
+    ASSERT_FALSE(recovered.is_in_game());
+}
+
+TEST_F(JournalTest, GamesFromAPositionStartWithASnapshot) {
+    dreamchess::Game game{};
+    ASSERT_TRUE(game.load_pgn(
+        "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"]\n\n1. e4 Kd7 *"));
+    ASSERT_TRUE(game.open_journal(path));
+    ASSERT_TRUE(game.close_journal());
+
+    const auto contents = dreamchess::Journal::read(path);
+    ASSERT_EQ(contents->m_snapshots.size(), 1);
+    ASSERT_EQ(contents->m_snapshots[0].m_ply, 0);
+    ASSERT_EQ(dreamchess::Journal::seek(*contents, 0)->fen(),
+              "4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+
+    dreamchess::Game recovered{};
+    ASSERT_TRUE(recovered.open_journal(path));
+    ASSERT_EQ(recovered.board().fen(), game.board().fen());
+}
+
+TEST_F(JournalTest, OtherFilesAreLeftAlone) {
+    std::ofstream{path} << "not a journal\n";
+
+    dreamchess::Game game{};
+    ASSERT_FALSE(game.open_journal(path));
+    ASSERT_FALSE(dreamchess::Journal::read(path));
+    ASSERT_FALSE(dreamchess::Journal::read("missing_journal.dcj"));
+}
@@ -0,0 +1,64 @@
+#include "Kpk.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Move.hpp"
+
+namespace {
+std::optional<bool> probe(std::string_view fen) {
+    dreamchess::Board board{};
+    EXPECT_TRUE(board.load_fen(fen));
+
+    return dreamchess::Kpk::probe(board);
+}
+}    // namespace
+
+TEST(KpkTest, OtherMaterialIsNotProbed) {
+    EXPECT_EQ(probe(dreamchess::Board::START_FEN), std::nullopt);
+    EXPECT_EQ(probe("4k3/8/8/8/8/8/8/4K3 w - - 0 1"), std::nullopt);
+    EXPECT_EQ(probe("4k3/8/8/8/8/8/3PP3/4K3 w - - 0 1"), std::nullopt);
+}
+
+TEST(KpkTest, PawnOnTheLastRankIsNotProbed) {
+    // Unreachable through a FEN, a push which doesn't promote leaves it there
+    dreamchess::Board board{};
+    ASSERT_TRUE(board.load_fen("7k/4P3/8/8/8/8/8/K7 w - - 0 1"));
+    board.make_move(dreamchess::Move{52, 60, dreamchess::Piece::WHITE_PAWN,
+                                     dreamchess::Piece::NONE});
+    EXPECT_EQ(dreamchess::Kpk::probe(board), std::nullopt);
+
+    ASSERT_TRUE(board.load_fen("k7/8/8/8/8/8/4p3/7K b - - 0 1"));
+    board.make_move(dreamchess::Move{12, 4, dreamchess::Piece::BLACK_PAWN,
+                                     dreamchess::Piece::NONE});
+    EXPECT_EQ(dreamchess::Kpk::probe(board), std::nullopt);
+}
+
+TEST(KpkTest, OppositionDecides) {
+    EXPECT_EQ(probe("8/4k3/8/4K3/4P3/8/8/8 w - - 0 1"), false);
+    EXPECT_EQ(probe("8/4k3/8/4K3/4P3/8/8/8 b - - 0 1"), true);
+}
+
+TEST(KpkTest, KingOnTheSixthRankWins) {
+    EXPECT_EQ(probe("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"), true);
+    EXPECT_EQ(probe("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"), true);
+}
+
+TEST(KpkTest, RookPawnIsADraw) {
+    EXPECT_EQ(probe("k7/8/K7/P7/8/8/8/8 w - - 0 1"), false);
+    EXPECT_EQ(probe("7k/8/7K/7P/8/8/8/8 b - - 0 1"), false);
+}
+
+TEST(KpkTest, PawnOutrunsTheKing) {
+    EXPECT_EQ(probe("8/8/8/8/8/8/P7/K6k w - - 0 1"), true);
+    EXPECT_EQ(probe("7k/8/8/8/8/8/P7/K7 b - - 0 1"), true);
+}
+
+TEST(KpkTest, BlackPawnIsMirrored) {
+    EXPECT_EQ(probe("8/8/8/4p3/4k3/8/4K3/8 b - - 0 1"), false);
+    EXPECT_EQ(probe("8/8/8/4p3/4k3/8/4K3/8 w - - 0 1"), true);
+    EXPECT_EQ(probe("8/8/8/3p4/3k4/8/3K4/8 w - - 0 1"), true);
+}
+
+TEST(KpkTest, UndefendedPawnFalls) {
+    EXPECT_EQ(probe("8/8/8/8/8/3k4/3P4/7K b - - 0 1"), false);
+}
@@ -0,0 +1,81 @@
+#include "MoveGenerator.hpp"
+
+#include <gtest/gtest.h>
+
+class MoveGeneratorTest : public ::testing::Test {
+protected:
+    [[nodiscard]] static uint64_t perft(const dreamchess::Board &board,
+                                        uint16_t depth) {
+        dreamchess::MoveList moves;
+        dreamchess::MoveGenerator::legal(board, moves);
+
+        if (depth == 1) {
+            return moves.size();
+        }
+
+        uint64_t nodes = 0;
+
+        for (const auto &move : moves) {
+            dreamchess::Board next = board;
+            next.make_move(move);
+            nodes += perft(next, depth - 1);
+        }
+
+        return nodes;
+    }
+
+    [[nodiscard]] static uint64_t perft(std::string_view fen,
+                                        uint16_t depth) {
+        dreamchess::Board board{};
+
+        if (!board.load_fen(fen)) {
+            return 0;
+        }
+
+        return perft(board, depth);
+    }
+};
+
+TEST_F(MoveGeneratorTest, StartingPositionPerft) {
+    ASSERT_EQ(perft(dreamchess::Board::START_FEN, 1), 20);
+    ASSERT_EQ(perft(dreamchess::Board::START_FEN, 3), 8902);
+}
+
+TEST_F(MoveGeneratorTest, CastlingAndPromotionsPerft) {
+    ASSERT_EQ(perft("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R "
+                    "w KQkq - 0 1",
+                    2),
+              2039);
+    ASSERT_EQ(perft("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 "
+                    "w kq - 0 1",
+                    3),
+              9467);
+}
+
+TEST_F(MoveGeneratorTest, EnPassantAndPinsPerft) {
+    ASSERT_EQ(perft("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4), 43238);
+}
+
+TEST_F(MoveGeneratorTest, CheckIsDetected) {
+    dreamchess::Board board{};
+
+    ASSERT_TRUE(board.load_fen("4k3/8/8/8/8/8/8/4R1K1 b - - 0 1"));
+    ASSERT_TRUE(dreamchess::MoveGenerator::in_check(board));
+
+    ASSERT_TRUE(board.load_fen("4k3/8/8/8/8/8/4P3/4R1K1 b - - 0 1"));
+    ASSERT_FALSE(dreamchess::MoveGenerator::in_check(board));
+}
+
+TEST_F(MoveGeneratorTest, UciMovesAreParsed) {
+    dreamchess::Board board{};
+
+    ASSERT_TRUE(dreamchess::MoveGenerator::from_uci(board, "g1f3"));
+    ASSERT_FALSE(dreamchess::MoveGenerator::from_uci(board, "g1g3"));
+    ASSERT_FALSE(dreamchess::MoveGenerator::from_uci(board, "e1g1"));
+
+    ASSERT_TRUE(board.load_fen("8/4P1k1/8/8/8/8/8/4K3 w - - 0 1"));
+    const auto promotion = dreamchess::MoveGenerator::from_uci(board, "e7e8n");
+
+    ASSERT_TRUE(promotion);
+    ASSERT_EQ(promotion->promotion_piece(), dreamchess::Piece::WHITE_KNIGHT);
+}
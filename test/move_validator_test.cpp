@@ -0,0 +1,117 @@
+#include "MoveValidator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "MoveGenerator.hpp"
+
+class MoveValidatorTest : public ::testing::Test {
+protected:
+    std::vector<dreamchess::Board> positions;
+    std::vector<dreamchess::MoveValidator::Query> queries;
+
+    // Random positions, each followed by its pseudo-legal Moves and by
+    // Moves breaking the rules in every way
+    void SetUp() override {
+        const std::vector<std::string> fens{
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - "
+            "0 1",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 "
+            "1"};
+        uint64_t seed = 2021;
+
+        for (const auto &fen : fens) {
+            dreamchess::Board board{};
+            ASSERT_TRUE(board.load_fen(fen));
+
+            for (int ply = 0; ply < 60; ply++) {
+                dreamchess::MoveList moves;
+                dreamchess::MoveGenerator::pseudo_legal(board, moves);
+
+                const auto position = static_cast<uint32_t>(positions.size());
+                positions.push_back(board);
+
+                for (const auto &move : moves) {
+                    queries.push_back({position, move});
+                }
+
+                for (int i = 0; i < 40; i++) {
+                    seed = seed * 6364136223846793005ULL +
+                           1442695040888963407ULL;
+                    const auto source = static_cast<int16_t>(seed >> 58);
+                    const auto destination =
+                        static_cast<int16_t>(seed >> 52 & 63);
+                    const auto promotion =
+                        i % 4 == 0 ? dreamchess::Piece::QUEEN | board.turn()
+                                   : dreamchess::Piece::NONE;
+
+                    queries.push_back(
+                        {position,
+                         dreamchess::Move{source, destination,
+                                          board.piece_at(source), promotion}});
+                }
+
+                dreamchess::MoveList legal;
+                dreamchess::MoveGenerator::legal(board, legal);
+
+                if (legal.size() == 0) {
+                    break;
+                }
+
+                board.make_move(legal[(seed >> 33) % legal.size()]);
+            }
+        }
+    }
+};
+
+TEST_F(MoveValidatorTest, AnswersMatchTheMoveGenerator) {
+    const auto bitmap =
+        dreamchess::MoveValidator{}.validate(positions, queries);
+    std::size_t legal = 0;
+
+    ASSERT_EQ(bitmap.size(), (queries.size() + 63) / 64);
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        const bool expected = dreamchess::MoveGenerator::is_legal(
+            positions[queries[i].m_position], queries[i].m_move);
+
+        ASSERT_EQ(dreamchess::MoveValidator::is_set(bitmap, i), expected)
+            << positions[queries[i].m_position].fen() << " "
+            << queries[i].m_move.to_uci();
+
+        legal += expected;
+    }
+
+    // Both answers are well represented
+    ASSERT_GT(legal, queries.size() / 4);
+    ASSERT_LT(legal, queries.size() * 3 / 4);
+}
+
+TEST_F(MoveValidatorTest, ThreadsDontChangeTheAnswers) {
+    const auto bitmap =
+        dreamchess::MoveValidator{}.validate(positions, queries);
+
+    for (uint16_t threads = 2; threads <= 5; threads++) {
+        ASSERT_EQ(dreamchess::MoveValidator{threads}.validate(positions,
+                                                              queries),
+                  bitmap);
+    }
+}
+
+TEST_F(MoveValidatorTest, UnknownPositionsAreInvalid) {
+    queries.resize(3);
+    queries[1].m_position = static_cast<uint32_t>(positions.size());
+
+    const auto bitmap =
+        dreamchess::MoveValidator{}.validate(positions, queries);
+
+    ASSERT_EQ(bitmap.size(), 1);
+    ASSERT_TRUE(dreamchess::MoveValidator::is_set(bitmap, 0));
+    ASSERT_FALSE(dreamchess::MoveValidator::is_set(bitmap, 1));
+    ASSERT_FALSE(dreamchess::MoveValidator::is_set(bitmap, 64));
+    ASSERT_TRUE(dreamchess::MoveValidator{}.validate(positions, {}).empty());
+}
@@ -0,0 +1,118 @@
+#include "PgnPipeline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MoveGenerator.hpp"
+#include "Pgn.hpp"
+
+class PgnPipelineTest : public ::testing::Test {
+protected:
+    static std::string text;
+
+    static void SetUpTestSuite() {
+        std::ostringstream stream;
+
+        for (uint64_t seed = 0; seed < 60; seed++) {
+            dreamchess::Board board{};
+            dreamchess::History history;
+            uint64_t random = seed;
+
+            for (std::size_t ply = 0; ply < 20 + seed; ply++) {
+                dreamchess::MoveList moves;
+                dreamchess::MoveGenerator::legal(board, moves);
+
+                if (moves.size() == 0) {
+                    break;
+                }
+
+                random = random * 6364136223846793005ULL +
+                         1442695040888963407ULL;
+                const dreamchess::Move move =
+                    moves[(random >> 33) % moves.size()];
+
+                history.add_step(board, move);
+                board.make_move(move);
+            }
+
+            dreamchess::Pgn::Tags tags;
+            tags.m_round = std::to_string(seed);
+            dreamchess::Pgn::write(stream, tags, board, history);
+
+            // Every tenth game is broken
+            if (seed % 10 == 9) {
+                stream << "[Round \"broken\"]\n\n1. e4 e4 *\n\n";
+            }
+        }
+
+        text = stream.str();
+    }
+};
+
+std::string PgnPipelineTest::text{};
+
+TEST_F(PgnPipelineTest, ResultsAreOrdered) {
+    // Tiny chunks and queues, so that the stages wait for each other
+    const dreamchess::PgnPipeline pipeline{4, 1, 512};
+
+    std::vector<std::string> rounds;
+    std::vector<std::string> fens;
+    uint64_t expected_index = 0;
+
+    const dreamchess::PgnReader::Statistics statistics = pipeline.run(
+        text, [&](const dreamchess::PgnPipeline::Result &result) {
+            ASSERT_EQ(result.m_index, expected_index++);
+
+            rounds.emplace_back(dreamchess::Pgn::tag(result.m_game, "Round"));
+            fens.push_back(result.m_plies ? result.m_board.fen() : "");
+        });
+
+    ASSERT_EQ(statistics.m_games, 66);
+    ASSERT_EQ(statistics.m_errors, 6);
+    ASSERT_EQ(rounds.size(), 66);
+    ASSERT_EQ(rounds[0], "0");
+    ASSERT_EQ(rounds[10], "broken");
+    ASSERT_EQ(rounds[65], "broken");
+
+    // Same outcome as the sequential replay
+    std::size_t offset = 0;
+
+    for (std::size_t game = 0; game < fens.size(); game++) {
+        while (text[offset] == '\n') {
+            offset++;
+        }
+
+        const std::string_view pgn = std::string_view{text}.substr(
+            offset,
+            dreamchess::PgnReader::game_length(
+                std::string_view{text}.substr(offset)));
+        offset += pgn.size();
+
+        dreamchess::Board board{};
+        const auto plies = dreamchess::Pgn::replay(pgn, board);
+
+        ASSERT_EQ(plies ? board.fen() : "", fens[game]);
+    }
+}
+
+TEST_F(PgnPipelineTest, WorkerCountDoesNotMatter) {
+    const dreamchess::PgnReader::Statistics single =
+        dreamchess::PgnPipeline{1}.run(text);
+    const dreamchess::PgnReader::Statistics several =
+        dreamchess::PgnPipeline{3, 2, 1024}.run(text);
+
+    ASSERT_EQ(single.m_games, several.m_games);
+    ASSERT_EQ(single.m_plies, several.m_plies);
+    ASSERT_EQ(single.m_errors, several.m_errors);
+    ASSERT_EQ(single.m_bytes, text.size());
+}
+
+TEST_F(PgnPipelineTest, EmptyTextHasNoGames) {
+    const dreamchess::PgnReader::Statistics statistics =
+        dreamchess::PgnPipeline{2}.run("\n\n");
+
+    ASSERT_EQ(statistics.m_games, 0);
+}
@@ -0,0 +1,202 @@
+#include "Pgn.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Game.hpp"
+#include "MoveGenerator.hpp"
+#include "PgnReader.hpp"
+
+class PgnTest : public ::testing::Test {
+protected:
+    // Plays pseudo-random legal moves from a position
+    static void play(dreamchess::Board &board, dreamchess::History &history,
+                     std::size_t plies, uint64_t seed) {
+        for (std::size_t ply = 0; ply < plies; ply++) {
+            dreamchess::MoveList moves;
+            dreamchess::MoveGenerator::legal(board, moves);
+
+            if (moves.size() == 0) {
+                break;
+            }
+
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const dreamchess::Move move = moves[(seed >> 33) % moves.size()];
+
+            history.add_step(board, move);
+            board.make_move(move);
+        }
+    }
+
+    [[nodiscard]] static std::string san(std::string_view fen,
+                                         std::string_view uci) {
+        dreamchess::Board board{};
+
+        if (!board.load_fen(fen)) {
+            return {};
+        }
+
+        const auto move = dreamchess::MoveGenerator::from_uci(board, uci);
+
+        return move ? dreamchess::Pgn::san(board, *move) : std::string{};
+    }
+};
+
+TEST_F(PgnTest, WritesStandardAlgebraicNotation) {
+    ASSERT_EQ(san(dreamchess::Board::START_FEN, "g1f3"), "Nf3");
+    ASSERT_EQ(san(dreamchess::Board::START_FEN, "e2e4"), "e4");
+    ASSERT_EQ(san("3k4/8/8/8/8/8/8/R3K2R w KQ - 0 1", "e1c1"), "O-O-O+");
+    ASSERT_EQ(san("4k3/8/8/8/8/8/8/R4RK1 w - - 0 1", "a1d1"), "Rad1");
+    ASSERT_EQ(san("4k3/8/8/8/R7/8/8/R3K3 w - - 0 1", "a1a2"), "R1a2");
+    ASSERT_EQ(san("k7/8/8/8/8/2Q1Q3/8/2Q1K3 w - - 0 1", "c3d2"), "Qc3d2");
+    ASSERT_EQ(san("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6"), "exd6");
+    ASSERT_EQ(san("4k3/P7/8/8/8/8/8/4K3 w - - 0 1", "a7a8q"), "a8=Q+");
+    ASSERT_EQ(san("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", "a1a8"), "Ra8#");
+}
+
+TEST_F(PgnTest, ParsesEveryLegalMove) {
+    dreamchess::Board board{};
+    dreamchess::History history;
+    ASSERT_TRUE(board.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/"
+                               "PPPBBPPP/R3K2R w KQkq - 0 1"));
+
+    for (uint64_t seed = 0; seed < 20; seed++) {
+        dreamchess::Board position = board;
+        play(position, history, 30, seed);
+
+        dreamchess::MoveList moves;
+        dreamchess::MoveGenerator::legal(position, moves);
+
+        for (const auto &move : moves) {
+            const std::string text = dreamchess::Pgn::san(position, move);
+            const auto parsed = dreamchess::Pgn::parse_san(position, text);
+
+            ASSERT_TRUE(parsed.has_value()) << text;
+            ASSERT_EQ(*parsed, move) << text;
+        }
+    }
+}
+
+TEST_F(PgnTest, SkipsCommentsAndVariations) {
+    const std::string game{
+        "[Event \"Test\"]\n[Site \"?\"]\n[Result \"*\"]\n\n"
+        "1.e4 {best by test} e5 2. Nf3 (2. f4 exf4 (2... d5) 3. Nf3) 2... "
+        "Nc6 $1 ; a comment\n3. Bb5! a6 4. Ba4 Nf6 5. O-O Be7 *\n"};
+
+    dreamchess::Board board{};
+    const auto plies = dreamchess::Pgn::replay(game, board);
+
+    ASSERT_TRUE(plies.has_value());
+    ASSERT_EQ(*plies, 10);
+    ASSERT_EQ(board.fen(),
+              "r1bqk2r/1pppbppp/p1n2n2/4p3/B3P3/5N2/PPPP1PPP/RNBQ1RK1 w kq - "
+              "4 6");
+    ASSERT_EQ(dreamchess::Pgn::tag(game, "Event"), "Test");
+    ASSERT_TRUE(dreamchess::Pgn::tag(game, "White").empty());
+}
+
+TEST_F(PgnTest, RejectsIllegalMoves) {
+    dreamchess::Board board{};
+
+    ASSERT_FALSE(dreamchess::Pgn::replay("1. e4 e5 2. Ke3 *", board));
+    ASSERT_FALSE(dreamchess::Pgn::replay("1. Nd2 *", board));
+}
+
+TEST_F(PgnTest, WrittenGamesAreReplayed) {
+    dreamchess::Board board{};
+    ASSERT_TRUE(board.load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/"
+                               "PPPBBPPP/R3K2R b KQkq - 0 1"));
+
+    dreamchess::History history;
+    play(board, history, 200, 7);
+
+    dreamchess::Pgn::Tags tags;
+    tags.m_white = "Quote \"White\"";
+
+    std::ostringstream stream;
+    dreamchess::Pgn::write(stream, tags, board, history);
+    const std::string game = stream.str();
+
+    std::istringstream lines{game};
+
+    for (std::string line; std::getline(lines, line);) {
+        ASSERT_LE(line.size(), dreamchess::Pgn::LINE_LENGTH);
+    }
+
+    ASSERT_NE(game.find("[SetUp \"1\"]"), std::string::npos);
+    ASSERT_NE(game.find("1... "), std::string::npos);
+    ASSERT_EQ(dreamchess::Pgn::tag(game, "White"), "Quote \\\"White\\\"");
+
+    dreamchess::Board replayed{};
+    const auto plies = dreamchess::Pgn::replay(game, replayed);
+
+    ASSERT_TRUE(plies.has_value());
+    ASSERT_EQ(*plies, history.size());
+    ASSERT_EQ(replayed.fen(), board.fen());
+}
+
+TEST_F(PgnTest, ReaderSplitsGames) {
+    const std::string path{"pgn_test.pgn"};
+
+    {
+        std::ofstream file{path};
+
+        for (uint64_t seed = 0; seed < 3; seed++) {
+            dreamchess::Board board{};
+            dreamchess::History history;
+            play(board, history, 40, seed);
+            dreamchess::Pgn::write(file, {}, board, history);
+        }
+
+        file << "[Event \"Comment\"]\n\n1. e4 {a comment\n[spanning] lines} "
+                "e5 *\n";
+    }
+
+    dreamchess::PgnReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    const dreamchess::PgnReader::Statistics statistics = reader.replay_all();
+
+    ASSERT_EQ(statistics.m_games, 4);
+    ASSERT_EQ(statistics.m_errors, 0);
+    ASSERT_EQ(statistics.m_plies, 122);
+    ASSERT_EQ(statistics.m_bytes, reader.text().size());
+
+    reader.rewind();
+    const auto first = reader.next();
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first->substr(0, 7), "[Event ");
+    ASSERT_EQ(dreamchess::Pgn::tag(*first, "Result"),
+              dreamchess::Pgn::tag(*reader.next(), "Result"));
+
+    std::remove(path.c_str());
+}
+
+TEST_F(PgnTest, GameIsExportedAndLoaded) {
+    dreamchess::Game game{};
+
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_TRUE(game.make_move("e7-e5"));
+    ASSERT_TRUE(game.make_move("g1-f3"));
+
+    const std::string path{"pgn_game_test.pgn"};
+    ASSERT_TRUE(game.export_pgn(path));
+
+    dreamchess::PgnReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    dreamchess::Game loaded{};
+    ASSERT_TRUE(loaded.load_pgn(*reader.next()));
+    ASSERT_EQ(loaded.board().fen(), game.board().fen());
+    ASSERT_EQ(loaded.history().export_all(), game.history().export_all());
+
+    ASSERT_FALSE(loaded.load_pgn("1. e4 e4 *"));
+    ASSERT_EQ(loaded.board().fen(), game.board().fen());
+
+    std::remove(path.c_str());
+}
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string_view>
+
 TEST(PieceTest, PiecesAreConvertedCorrectly) {
     ASSERT_EQ(
         dreamchess::Piece::unicode_representation(dreamchess::Piece::NONE),
@@ -42,4 +44,38 @@ TEST(PieceTest, PiecesAreConvertedCorrectly) {
     ASSERT_EQ(dreamchess::Piece::unicode_representation(
                   dreamchess::Piece::BLACK_KING),
               "♚");
-}
\ No newline at end of file
+}
+
+TEST(PieceTest, TraitsAreBuiltAtCompileTime) {
+    static_assert(dreamchess::Piece::to_fen(dreamchess::Piece::BLACK_QUEEN) ==
+                  'q');
+    static_assert(dreamchess::Piece::to_enum('N') ==
+                  dreamchess::Piece::WHITE_KNIGHT);
+    static_assert(
+        dreamchess::Piece::traits(dreamchess::Piece::WHITE_ROOK).m_value ==
+        500);
+
+    for (const char fen : std::string_view{"pnbrqkPNBRQK"}) {
+        const auto piece = dreamchess::Piece::to_enum(fen);
+
+        ASSERT_NE(piece, dreamchess::Piece::NONE);
+        ASSERT_EQ(dreamchess::Piece::to_fen(piece), fen);
+    }
+
+    ASSERT_EQ(dreamchess::Piece::to_enum('x'), dreamchess::Piece::NONE);
+    ASSERT_EQ(dreamchess::Piece::to_enum('\xe2'), dreamchess::Piece::NONE);
+    ASSERT_EQ(dreamchess::Piece::to_fen(dreamchess::Piece::NONE), ' ');
+
+    const auto &queen =
+        dreamchess::Piece::traits(dreamchess::Piece::BLACK_QUEEN);
+    const auto &bishop =
+        dreamchess::Piece::traits(dreamchess::Piece::WHITE_BISHOP);
+    const auto &knight =
+        dreamchess::Piece::traits(dreamchess::Piece::WHITE_KNIGHT);
+
+    ASSERT_TRUE(queen.m_diagonal_slider && queen.m_orthogonal_slider);
+    ASSERT_TRUE(bishop.m_diagonal_slider && !bishop.m_orthogonal_slider);
+    ASSERT_FALSE(knight.m_diagonal_slider || knight.m_orthogonal_slider);
+    ASSERT_EQ(
+        dreamchess::Piece::traits(dreamchess::Piece::BLACK_KING).m_value, 0);
+}
@@ -0,0 +1,179 @@
+#include "PositionIndex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "GameStoreWriter.hpp"
+#include "MoveGenerator.hpp"
+#include "PositionIndexBuilder.hpp"
+
+class PositionIndexTest : public ::testing::Test {
+protected:
+    const std::string store_path{"position_index_test.dcgs"};
+    const std::string head_path{"position_index_test_head.dcgs"};
+    const std::string index_path{"position_index_test.dcpi"};
+    const std::string other_path{"position_index_test_other.dcpi"};
+    const std::string merged_path{"position_index_test_merged.dcpi"};
+
+    void TearDown() override {
+        for (const auto &path :
+             {store_path, head_path, index_path, other_path, merged_path}) {
+            std::remove(path.c_str());
+        }
+    }
+
+    // Stores pseudo-random legal games, the same ones on every call
+    static void write_store(const std::string &path, uint64_t games) {
+        dreamchess::GameStoreWriter writer;
+        ASSERT_TRUE(writer.open(path));
+
+        for (uint64_t game = 0; game < games; game++) {
+            dreamchess::Board board{};
+            dreamchess::History history;
+            uint64_t seed = game;
+
+            for (uint64_t ply = 0; ply < 30 + game * 7; ply++) {
+                dreamchess::MoveList moves;
+                dreamchess::MoveGenerator::legal(board, moves);
+
+                if (moves.size() == 0) {
+                    break;
+                }
+
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                const auto move = moves[(seed >> 33) % moves.size()];
+
+                history.add_step(board, move);
+                board.make_move(move);
+            }
+
+            ASSERT_TRUE(writer.add({}, board, history));
+        }
+
+        ASSERT_TRUE(writer.close());
+    }
+
+    static std::string read(const std::string &path) {
+        std::ifstream file{path, std::ios::binary};
+
+        return {std::istreambuf_iterator<char>{file},
+                std::istreambuf_iterator<char>{}};
+    }
+};
+
+TEST_F(PositionIndexTest, EveryPositionIsFound) {
+    write_store(store_path, 12);
+
+    dreamchess::GameStore store;
+    ASSERT_TRUE(store.open(store_path));
+    ASSERT_TRUE(dreamchess::PositionIndexBuilder{3}.build(store, index_path));
+
+    dreamchess::PositionIndex index;
+    ASSERT_TRUE(index.open(index_path));
+
+    std::size_t positions = 0;
+
+    for (std::size_t game = 0; game < store.size(); game++) {
+        uint32_t ply = 0;
+        const auto has = [&index, game](const dreamchess::Board &board,
+                                        uint32_t at) {
+            const auto [begin, end] = index.find(board);
+
+            return std::any_of(begin, end, [game, at](const auto &entry) {
+                return entry.m_game == game && entry.m_ply == at;
+            });
+        };
+
+        dreamchess::Board board{};
+        const auto plies = store.replay(
+            game, board,
+            [&has, &ply](const dreamchess::Board &position,
+                         const dreamchess::Move &) {
+                EXPECT_TRUE(has(position, ply++));
+            });
+
+        ASSERT_TRUE(plies.has_value());
+        EXPECT_TRUE(has(board, *plies));
+        positions += *plies + 1;
+    }
+
+    EXPECT_EQ(index.size(), positions);
+    EXPECT_TRUE(std::is_sorted(index.entries(),
+                               index.entries() + index.size()));
+
+    // Every game starts from the neutral position
+    const auto [begin, end] = index.find(dreamchess::Board{});
+    EXPECT_EQ(std::count_if(begin, end,
+                            [](const auto &entry) { return entry.m_ply == 0; }),
+              12);
+
+    const auto [missing, missing_end] = index.find(0x0123456789abcdefULL);
+    EXPECT_EQ(missing, missing_end);
+}
+
+TEST_F(PositionIndexTest, ThreadsDontChangeTheFile) {
+    write_store(store_path, 9);
+
+    dreamchess::GameStore store;
+    ASSERT_TRUE(store.open(store_path));
+
+    ASSERT_TRUE(dreamchess::PositionIndexBuilder{1}.build(store, index_path));
+    ASSERT_TRUE(dreamchess::PositionIndexBuilder{4}.build(store, other_path));
+
+    EXPECT_EQ(read(index_path), read(other_path));
+}
+
+TEST_F(PositionIndexTest, MergeUpdatesAnIndex) {
+    // The first games indexed, then the whole store written again
+    write_store(head_path, 6);
+    write_store(store_path, 10);
+
+    dreamchess::GameStore head;
+    dreamchess::GameStore store;
+    ASSERT_TRUE(head.open(head_path));
+    ASSERT_TRUE(store.open(store_path));
+
+    const dreamchess::PositionIndexBuilder builder{2};
+    ASSERT_TRUE(builder.build(head, index_path));
+    ASSERT_TRUE(builder.build(store, other_path, head.size()));
+    ASSERT_TRUE(dreamchess::PositionIndexBuilder::merge(
+        {index_path, other_path}, merged_path));
+
+    const std::string merged = read(merged_path);
+    ASSERT_TRUE(builder.build(store, index_path));
+    EXPECT_EQ(merged, read(index_path));
+
+    // Entries found in every input are written once
+    ASSERT_TRUE(dreamchess::PositionIndexBuilder::merge(
+        {index_path, index_path}, merged_path));
+    EXPECT_EQ(read(merged_path), read(index_path));
+}
+
+TEST_F(PositionIndexTest, MalformedFilesAreRejected) {
+    dreamchess::PositionIndex index;
+
+    EXPECT_FALSE(index.open("missing.dcpi"));
+
+    write_store(store_path, 3);
+
+    dreamchess::GameStore store;
+    ASSERT_TRUE(store.open(store_path));
+    ASSERT_TRUE(dreamchess::PositionIndexBuilder{}.build(store, index_path));
+
+    const std::string bytes = read(index_path);
+
+    std::ofstream{other_path, std::ios::binary}
+        << bytes.substr(0, bytes.size() - 1);
+    EXPECT_FALSE(index.open(other_path));
+
+    std::ofstream{other_path, std::ios::binary} << "DCGS" + bytes.substr(4);
+    EXPECT_FALSE(index.open(other_path));
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(dreamchess::PositionIndexBuilder::merge(
+        {index_path, other_path}, merged_path));
+}
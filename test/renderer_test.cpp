@@ -0,0 +1,81 @@
+#include "Renderer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "Game.hpp"
+
+class RendererTest : public ::testing::Test {
+protected:
+    std::ostringstream stream;
+    dreamchess::Game game{};
+
+    [[nodiscard]] static std::size_t count(const std::string &text,
+                                           const std::string &pattern) {
+        std::size_t found = 0;
+
+        for (auto i = text.find(pattern); i != std::string::npos;
+             i = text.find(pattern, i + 1)) {
+            found++;
+        }
+
+        return found;
+    }
+};
+
+TEST_F(RendererTest, FirstFrameHoldsTheWholeBoard) {
+    dreamchess::Renderer renderer{stream};
+    renderer.draw(game.board());
+
+    std::ostringstream board;
+    board << game.board();
+
+    ASSERT_EQ(renderer.frame().rfind("\x1b[H\x1b[2J", 0), 0);
+    ASSERT_NE(renderer.frame().find(board.str()), std::string::npos);
+    ASSERT_EQ(stream.str(), renderer.frame());
+}
+
+TEST_F(RendererTest, OnlyChangedSquaresAreRedrawn) {
+    dreamchess::Renderer renderer{stream};
+    renderer.draw(game.board());
+    renderer.draw(game.board());
+
+    ASSERT_EQ(renderer.frame(), "\x1b[11;1H\x1b[J");
+
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    renderer.draw(game.board());
+
+    // e2 and e4, then the prompt
+    ASSERT_EQ(count(renderer.frame(), "\x1b["), 4);
+    ASSERT_EQ(renderer.frame().rfind("\x1b[3;9H", 0), 0);
+    ASSERT_NE(renderer.frame().find("\x1b[5;9H"), std::string::npos);
+    ASSERT_EQ(stream.str().size(), stream.str().find(renderer.frame()) +
+                                       renderer.frame().size());
+}
+
+TEST_F(RendererTest, InvalidateRedrawsTheWholeBoard) {
+    dreamchess::Renderer renderer{stream};
+    renderer.draw(game.board());
+    const std::string first = renderer.frame();
+
+    renderer.invalidate();
+    renderer.draw(game.board());
+
+    ASSERT_EQ(renderer.frame(), first);
+}
+
+TEST_F(RendererTest, PlainModeMatchesTheStreamOperator) {
+    dreamchess::Renderer renderer{stream, false};
+    std::ostringstream expected;
+
+    for (int i = 0; i < 2; i++) {
+        renderer.draw(game.board());
+        expected << dreamchess::Renderer::SEPARATOR << '\n'
+                 << game.board() << dreamchess::Renderer::SEPARATOR << '\n';
+    }
+
+    ASSERT_EQ(count(stream.str(), "\x1b"), 0);
+    ASSERT_EQ(stream.str(), expected.str());
+}
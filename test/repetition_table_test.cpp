@@ -0,0 +1,76 @@
+#include "RepetitionTable.hpp"
+
+#include <gtest/gtest.h>
+
+#include "MoveGenerator.hpp"
+
+class RepetitionTableTest : public ::testing::Test {
+protected:
+    dreamchess::Board board{};
+    dreamchess::RepetitionTable table{board};
+
+    void play(const char *move) {
+        const auto parsed = dreamchess::MoveGenerator::from_uci(board, move);
+        ASSERT_TRUE(parsed.has_value());
+
+        board.make_move(*parsed);
+        table.push(board);
+    }
+};
+
+TEST_F(RepetitionTableTest, CountsOccurrences) {
+    EXPECT_EQ(dreamchess::RepetitionTable{}.repetitions(), 0);
+    EXPECT_EQ(table.repetitions(), 1);
+
+    for (uint16_t occurrence = 2; occurrence <= 4; occurrence++) {
+        play("b1c3");
+        play("b8c6");
+        play("c3b1");
+        EXPECT_EQ(table.repetitions(), occurrence - 1);
+        play("c6b8");
+        EXPECT_EQ(table.repetitions(), occurrence);
+    }
+
+    EXPECT_EQ(table.size(), 13);
+}
+
+TEST_F(RepetitionTableTest, IrreversibleMovesStartANewWindow) {
+    play("g1f3");
+    play("g8f6");
+    play("f3g1");
+    play("f6g8");
+    EXPECT_EQ(table.repetitions(), 2);
+
+    play("d2d4");
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.repetitions(), 1);
+
+    play("g8f6");
+    play("g1f3");
+    play("f6g8");
+    EXPECT_EQ(table.repetitions(), 1);
+    play("f3g1");
+    EXPECT_EQ(table.repetitions(), 2);
+    EXPECT_EQ(table.size(), 5);
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.repetitions(), 0);
+}
+
+TEST_F(RepetitionTableTest, CastlingRightsMatter) {
+    // Same pieces, but White can't castle anymore
+    play("e2e4");
+    play("e7e5");
+    play("e1e2");
+    play("e8e7");
+    play("e2e1");
+    play("e7e8");
+    EXPECT_EQ(table.repetitions(), 1);
+
+    play("e1e2");
+    play("e8e7");
+    play("e2e1");
+    play("e7e8");
+    EXPECT_EQ(table.repetitions(), 2);
+}
@@ -0,0 +1,97 @@
+#include "Search.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+class SearchTest : public ::testing::Test {
+protected:
+    using Options = dreamchess::Search::Options;
+
+    dreamchess::Search search{};
+
+    // Every technique alone, then all of them and none
+    static std::vector<Options> configurations() {
+        const std::array<bool Options::*, 5> techniques{
+            &Options::m_pvs, &Options::m_aspiration, &Options::m_null_move,
+            &Options::m_late_move_reductions, &Options::m_futility};
+        std::vector<Options> result;
+
+        for (const auto technique : techniques) {
+            Options options{false, false, false, false, false};
+            options.*technique = true;
+            result.push_back(options);
+        }
+
+        result.push_back(Options{});
+        result.push_back(Options{false, false, false, false, false});
+
+        return result;
+    }
+
+    // Score of the last completed iteration
+    int32_t score{0};
+
+    [[nodiscard]] std::string best_move(const std::string &fen,
+                                        int16_t depth) {
+        dreamchess::Board board{};
+        board.load_fen(fen);
+
+        dreamchess::Search::Limits limits{};
+        limits.m_depth = depth;
+
+        const std::vector<dreamchess::Move> pv = search.think(
+            board, limits, [this](const dreamchess::Search::Report &report) {
+                score = report.m_score;
+            });
+
+        return pv.empty() ? "" : pv.front().to_uci();
+    }
+};
+
+TEST_F(SearchTest, EveryTechniqueFindsMates) {
+    for (const auto &options : configurations()) {
+        search.set_options(options);
+
+        ASSERT_EQ(best_move("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", 3), "a1a8");
+        ASSERT_EQ(score, dreamchess::Search::MATE_SCORE - 1);
+
+        // Mate in 2, the white KING has to come closer first
+        static_cast<void>(best_move("k7/8/2K5/8/8/8/8/7R w - - 0 1", 5));
+        ASSERT_EQ(score, dreamchess::Search::MATE_SCORE - 3);
+    }
+}
+
+TEST_F(SearchTest, EveryTechniqueWinsMaterial) {
+    for (const auto &options : configurations()) {
+        search.set_options(options);
+
+        // The knight forks KING and QUEEN
+        ASSERT_EQ(best_move("2q1k3/8/8/8/4N3/8/8/4K3 w - - 0 1", 4), "e4d6");
+    }
+}
+
+TEST_F(SearchTest, TechniquesSaveNodes) {
+    const std::string fen{
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 "
+        "4"};
+
+    search.set_options(Options{false, false, false, false, false});
+    static_cast<void>(best_move(fen, 5));
+    const uint64_t plain = search.nodes();
+
+    search.set_options(Options{});
+    static_cast<void>(best_move(fen, 5));
+
+    ASSERT_LT(search.nodes() * 2, plain);
+}
+
+TEST_F(SearchTest, NodeLimitIsHonored) {
+    dreamchess::Search::Limits limits{};
+    limits.m_nodes = 10000;
+
+    ASSERT_FALSE(search.think(dreamchess::Board{}, limits).empty());
+    ASSERT_EQ(search.nodes(), limits.m_nodes);
+}
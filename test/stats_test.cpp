@@ -0,0 +1,63 @@
+#include "Stats.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include "Game.hpp"
+
+class StatsTest : public ::testing::Test {
+protected:
+    dreamchess::Game game{};
+
+    void SetUp() override { dreamchess::Stats::reset(); }
+
+    [[nodiscard]] static uint64_t calls(dreamchess::Stats::Probe probe) {
+        return dreamchess::Stats::collect()[probe].m_calls;
+    }
+};
+
+TEST_F(StatsTest, ProbesCountCalls) {
+    ASSERT_TRUE(game.make_move("e2-e4"));
+    ASSERT_FALSE(game.make_move("e2-e4"));
+
+    const uint64_t expected = dreamchess::Stats::enabled() ? 1 : 0;
+
+    ASSERT_EQ(calls(dreamchess::Stats::GAME_MAKE_MOVE), 2 * expected);
+    ASSERT_EQ(calls(dreamchess::Stats::BOARD_MOVE_IS_VALID), 2 * expected);
+    ASSERT_EQ(calls(dreamchess::Stats::BOARD_MAKE_MOVE), expected);
+    ASSERT_EQ(calls(dreamchess::Stats::HISTORY_ADD_STEP), expected);
+}
+
+TEST_F(StatsTest, ExitedThreadsAreAggregated) {
+    std::thread worker{[] {
+        dreamchess::Game other{};
+        static_cast<void>(other.make_move("d2-d4"));
+    }};
+    worker.join();
+
+    const uint64_t expected = dreamchess::Stats::enabled() ? 1 : 0;
+
+    ASSERT_EQ(calls(dreamchess::Stats::BOARD_MAKE_MOVE), expected);
+}
+
+TEST_F(StatsTest, ResetClearsCounters) {
+    ASSERT_TRUE(game.make_move("e2-e4"));
+
+    dreamchess::Stats::reset();
+
+    ASSERT_EQ(calls(dreamchess::Stats::GAME_MAKE_MOVE), 0);
+}
+
+TEST_F(StatsTest, DumpNamesEveryProbe) {
+    std::stringstream out;
+
+    dreamchess::Stats::dump(out);
+
+    if (dreamchess::Stats::enabled()) {
+        ASSERT_NE(out.str().find("History::add_step"), std::string::npos);
+    } else {
+        ASSERT_NE(out.str().find("disabled"), std::string::npos);
+    }
+}
@@ -0,0 +1,143 @@
+#include "Tablebase.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Kpk.hpp"
+#include "TablebaseGenerator.hpp"
+
+class TablebaseTest : public ::testing::Test {
+protected:
+    static dreamchess::TablebaseGenerator generator;
+
+    static void SetUpTestSuite() {
+        static_cast<void>(generator.generate("KQK"));
+        static_cast<void>(generator.generate("KRK"));
+        static_cast<void>(generator.generate("KPK"));
+    }
+
+    static uint16_t longest_mate(const std::string &signature) {
+        const dreamchess::TablebaseGenerator::table_t &table =
+            generator.tables().at(signature);
+        uint16_t longest = 0;
+
+        for (const uint8_t value : table) {
+            const dreamchess::Tablebase::Result result =
+                dreamchess::Tablebase::decode(value);
+
+            if (result.m_wdl == dreamchess::Tablebase::WIN) {
+                longest = std::max(longest, result.m_moves);
+            }
+        }
+
+        return longest;
+    }
+};
+
+dreamchess::TablebaseGenerator TablebaseTest::generator{4};
+
+TEST_F(TablebaseTest, SignaturesAreNormalized) {
+    EXPECT_EQ(dreamchess::Tablebase::signature("kpkr"), "KRKP");
+    EXPECT_EQ(dreamchess::Tablebase::signature("KPKQ"), "KQKP");
+    EXPECT_EQ(dreamchess::Tablebase::signature("KNRK"), "KRNK");
+    EXPECT_EQ(dreamchess::Tablebase::signature("KQRKR"), std::nullopt);
+    EXPECT_EQ(dreamchess::Tablebase::signature("KQX"), std::nullopt);
+    EXPECT_EQ(dreamchess::Tablebase::signature("QKK"), std::nullopt);
+}
+
+TEST_F(TablebaseTest, DependenciesFollowCapturesAndPromotions) {
+    const std::vector<std::string> dependencies =
+        dreamchess::TablebaseGenerator::dependencies("KRKP");
+
+    for (const auto &expected : {"KPK", "KRK", "KQKR", "KRKR", "KRKB"}) {
+        EXPECT_NE(std::find(dependencies.begin(), dependencies.end(),
+                            expected),
+                  dependencies.end())
+            << expected;
+    }
+}
+
+TEST_F(TablebaseTest, LongestMatesAreKnown) {
+    EXPECT_EQ(longest_mate("KQK"), 10);
+    EXPECT_EQ(longest_mate("KRK"), 16);
+}
+
+TEST_F(TablebaseTest, KeyAndPositionAreInverse) {
+    dreamchess::Board board{};
+    ASSERT_TRUE(board.load_fen("8/8/8/5k2/8/1K6/6r1/8 b - - 0 1"));
+
+    const std::optional<dreamchess::Tablebase::Key> key =
+        dreamchess::Tablebase::key(board);
+    ASSERT_TRUE(key);
+    EXPECT_EQ(key->m_signature, "KRK");
+
+    const std::optional<dreamchess::Board> position =
+        dreamchess::Tablebase::position(key->m_signature, key->m_index);
+    ASSERT_TRUE(position);
+    EXPECT_EQ(dreamchess::Tablebase::key(*position)->m_index, key->m_index);
+}
+
+TEST_F(TablebaseTest, KpkMatchesTheBitbase) {
+    const dreamchess::TablebaseGenerator::table_t &table =
+        generator.tables().at("KPK");
+
+    for (uint64_t index = 0; index < table.size(); index++) {
+        const std::optional<dreamchess::Board> position =
+            dreamchess::Tablebase::position("KPK", index);
+
+        if (!position ||
+            dreamchess::Tablebase::key(*position)->m_index != index) {
+            continue;
+        }
+
+        const std::optional<bool> bitbase = dreamchess::Kpk::probe(*position);
+        const dreamchess::Tablebase::Result result =
+            dreamchess::Tablebase::decode(table[index]);
+
+        const bool white_wins =
+            result.m_wdl == (position->turn() == dreamchess::Piece::WHITE
+                                 ? dreamchess::Tablebase::WIN
+                                 : dreamchess::Tablebase::LOSS);
+
+        ASSERT_EQ(*bitbase, white_wins) << position->fen();
+    }
+}
+
+TEST_F(TablebaseTest, ProbesMappedFiles) {
+    const std::string path = "KRK.dctb";
+    ASSERT_TRUE(generator.write("KRK", path));
+
+    dreamchess::Tablebase tablebase;
+    ASSERT_TRUE(tablebase.open(path));
+    EXPECT_EQ(tablebase.size(), 1);
+
+    dreamchess::Board board{};
+
+    // Back rank mate
+    ASSERT_TRUE(board.load_fen("6k1/8/6K1/8/8/8/8/R7 w - - 0 1"));
+    std::optional<dreamchess::Tablebase::Result> result =
+        tablebase.probe(board);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->m_wdl, dreamchess::Tablebase::WIN);
+    EXPECT_EQ(result->m_moves, 1);
+
+    // Colors swapped and mirrored
+    ASSERT_TRUE(board.load_fen("7r/8/8/8/8/1k6/8/K7 w - - 0 1"));
+    result = tablebase.probe(board);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->m_wdl, dreamchess::Tablebase::LOSS);
+    EXPECT_EQ(result->m_moves, 1);
+
+    // The rook hangs
+    ASSERT_TRUE(board.load_fen("8/8/8/8/8/8/1k6/1R4K1 b - - 0 1"));
+    result = tablebase.probe(board);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->m_wdl, dreamchess::Tablebase::DRAW);
+
+    ASSERT_TRUE(board.load_fen(dreamchess::Board::START_FEN));
+    EXPECT_EQ(tablebase.probe(board), std::nullopt);
+
+    std::remove(path.c_str());
+}
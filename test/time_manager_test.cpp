@@ -0,0 +1,94 @@
+#include "TimeManager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+class TimeManagerTest : public ::testing::Test {
+protected:
+    dreamchess::TimeManager manager{};
+};
+
+TEST_F(TimeManagerTest, DeadlinesFollowTheClock) {
+    // An even share of 30 moves plus most of the increment, then 4 times it
+    manager.start(60000, 1000, 0, 0);
+    ASSERT_EQ(manager.soft_deadline(), 2750);
+    ASSERT_EQ(manager.hard_deadline(), 11000);
+
+    // The last move before the time control may use the whole clock
+    manager.start(10000, 0, 1, 0);
+    ASSERT_EQ(manager.soft_deadline(), 9950);
+    ASSERT_EQ(manager.hard_deadline(), 9950);
+
+    // With little time left the hard deadline is a quarter of it
+    manager.start(100, 0, 0, 0);
+    ASSERT_EQ(manager.soft_deadline(), 3);
+    ASSERT_EQ(manager.hard_deadline(), 12);
+
+    manager.start(0, 0, 0, 500);
+    ASSERT_EQ(manager.soft_deadline(), 500);
+    ASSERT_EQ(manager.hard_deadline(), 500);
+
+    manager.start(0, 0, 0, 0);
+    ASSERT_EQ(manager.hard_deadline(), 0);
+    ASSERT_FALSE(
+        manager.out_of_time(dreamchess::TimeManager::CHECK_INTERVAL));
+    ASSERT_TRUE(manager.completed(true));
+}
+
+TEST_F(TimeManagerTest, ClockIsReadEveryInterval) {
+    manager.start(0, 0, 0, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+    ASSERT_FALSE(manager.out_of_time(1));
+    ASSERT_TRUE(manager.out_of_time(dreamchess::TimeManager::CHECK_INTERVAL));
+}
+
+TEST_F(TimeManagerTest, UnstableBestMovesGetMoreTime) {
+    // Soft deadline 666 ms, hard one 2664 ms
+    manager.start(20000, 0, 0, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds{400});
+
+    // A stable best Move stops at the soft deadline, a changed one goes on
+    ASSERT_FALSE(manager.completed(false));
+    ASSERT_TRUE(manager.completed(true));
+
+    manager.finish();
+
+    const dreamchess::TimeManager::Statistics statistics =
+        manager.statistics();
+    ASSERT_EQ(statistics.m_moves, 1);
+    ASSERT_EQ(statistics.m_extended, 1);
+    ASSERT_EQ(statistics.m_hard_overruns, 0);
+    ASSERT_EQ(statistics.overrun_percentile(0.99), 0);
+}
+
+TEST_F(TimeManagerTest, OverrunsAreRecorded) {
+    manager.start(0, 0, 0, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    manager.finish();
+
+    // Moves with no deadline are not recorded
+    manager.start(0, 0, 0, 0);
+    manager.finish();
+
+    dreamchess::TimeManager::Statistics statistics = manager.statistics();
+    ASSERT_EQ(statistics.m_moves, 1);
+    ASSERT_EQ(statistics.m_soft_overruns, 1);
+    ASSERT_EQ(statistics.m_hard_overruns, 1);
+    ASSERT_GE(statistics.m_max_overrun, 4);
+    ASSERT_GE(statistics.overrun_percentile(0.99), 4);
+
+    // 1 Move in 100 is late
+    statistics = dreamchess::TimeManager::Statistics{};
+    statistics.m_moves = 100;
+    statistics.m_overruns[0] = 99;
+    statistics.m_overruns[10] = 1;
+
+    ASSERT_EQ(statistics.overrun_percentile(0.99), 0);
+    ASSERT_EQ(statistics.overrun_percentile(1.0), 10);
+
+    manager.reset_statistics();
+    ASSERT_EQ(manager.statistics().m_moves, 0);
+}
@@ -0,0 +1,112 @@
+#include "Uci.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "MoveGenerator.hpp"
+
+class UciTest : public ::testing::Test {
+protected:
+    std::stringstream input{};
+    std::stringstream output{};
+    dreamchess::Uci uci{input, output};
+
+    [[nodiscard]] std::string best_move() {
+        uci.wait();
+
+        const std::string text = output.str();
+        const size_t start = text.rfind("bestmove ");
+
+        if (start == std::string::npos) {
+            return "";
+        }
+
+        return text.substr(start + 9, text.find_first_of(" \n", start + 9) -
+                                          (start + 9));
+    }
+};
+
+TEST_F(UciTest, HandshakeIsAnswered) {
+    ASSERT_TRUE(uci.execute("uci"));
+    ASSERT_TRUE(uci.execute("isready"));
+    ASSERT_FALSE(uci.execute("quit"));
+
+    ASSERT_NE(output.str().find("uciok"), std::string::npos);
+    ASSERT_NE(output.str().find("readyok"), std::string::npos);
+}
+
+TEST_F(UciTest, PositionAppliesMoves) {
+    uci.execute("position startpos moves e2e4 e7e5 g1f3");
+
+    ASSERT_EQ(uci.board().fen(),
+              "rnbqkbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq - 1 2");
+
+    uci.execute(
+        "position fen 4k3/8/8/8/8/8/8/R3K3 w Q - 0 1 moves e1c1 e8f7");
+
+    ASSERT_EQ(uci.board().fen(), "8/5k2/8/8/8/8/8/2KR4 w - - 2 2");
+}
+
+TEST_F(UciTest, IllegalMovesAreRejected) {
+    uci.execute("position startpos moves e2e5");
+
+    ASSERT_EQ(uci.board().fen(), std::string{dreamchess::Board::START_FEN});
+    ASSERT_NE(output.str().find("illegal move e2e5"), std::string::npos);
+}
+
+TEST_F(UciTest, MateInOneIsFound) {
+    uci.execute("position fen 6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    uci.execute("go depth 3");
+
+    ASSERT_EQ(best_move(), "a1a8");
+    ASSERT_NE(output.str().find("score mate 1"), std::string::npos);
+}
+
+TEST_F(UciTest, StopEndsInfiniteSearch) {
+    uci.execute("position startpos");
+    uci.execute("go infinite");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    ASSERT_EQ(output.str().find("bestmove"), std::string::npos);
+
+    const auto stop_time = std::chrono::steady_clock::now();
+    uci.execute("stop");
+    const std::string move = best_move();
+    const auto stopped_in = std::chrono::steady_clock::now() - stop_time;
+
+    ASSERT_TRUE(dreamchess::MoveGenerator::from_uci(uci.board(), move));
+    ASSERT_LT(stopped_in, std::chrono::milliseconds{100});
+}
+
+TEST_F(UciTest, PonderhitSwitchesToTimedSearch) {
+    uci.execute("setoption name Ponder value true");
+    uci.execute("position startpos moves e2e4");
+    uci.execute("go ponder movetime 20");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{60});
+    ASSERT_EQ(output.str().find("bestmove"), std::string::npos);
+
+    uci.execute("ponderhit");
+
+    ASSERT_TRUE(dreamchess::MoveGenerator::from_uci(uci.board(), best_move()));
+}
+
+TEST_F(UciTest, TechniquesAreOptions) {
+    uci.execute("uci");
+
+    ASSERT_NE(output.str().find("option name NullMove type check default true"),
+              std::string::npos);
+
+    uci.execute("setoption name NullMove value false");
+    uci.execute("setoption name LateMoveReductions value false");
+
+    ASSERT_EQ(output.str().find("unknown option"), std::string::npos);
+
+    uci.execute("position fen 6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    uci.execute("go depth 3");
+
+    ASSERT_EQ(best_move(), "a1a8");
+}
@@ -0,0 +1,96 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "GameStoreWriter.hpp"
+#include "PgnReader.hpp"
+#include "PositionIndexBuilder.hpp"
+
+int main(int argc, char **argv) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "usage: dreamchess++-pgnstore INPUT.pgn OUTPUT.dcgs "
+                     "[INDEX.dcpi]\n";
+        return 1;
+    }
+
+    dreamchess::PgnReader reader;
+    dreamchess::GameStoreWriter writer;
+
+    if (!reader.open(argv[1])) {
+        std::cerr << "cannot open " << argv[1] << "\n";
+        return 1;
+    }
+
+    if (!writer.open(argv[2])) {
+        std::cerr << "cannot create " << argv[2] << "\n";
+        return 1;
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    const auto start = clock::now();
+    uint64_t rejected = 0;
+
+    for (auto game = reader.next(); game; game = reader.next()) {
+        rejected += !writer.add_pgn(*game);
+    }
+
+    const std::size_t stored = writer.size();
+
+    if (!writer.close()) {
+        std::cerr << "cannot write " << argv[2] << "\n";
+        return 1;
+    }
+
+    dreamchess::GameStore store;
+    const bool valid = store.open(argv[2]);
+
+    std::cout << stored << " games stored, " << rejected << " rejected in "
+              << std::chrono::duration<double>(clock::now() - start).count()
+              << " s\n";
+
+    if (valid) {
+        std::ifstream output{argv[2], std::ios::binary | std::ios::ate};
+        const auto bytes = static_cast<double>(output.tellg());
+
+        std::cout << reader.text().size() << " bytes of PGN, " << bytes
+                  << " bytes stored, "
+                  << static_cast<double>(reader.text().size()) / bytes
+                  << "x smaller\n";
+    }
+
+    if (!valid) {
+        return 1;
+    }
+
+    if (argc == 4) {
+        const auto index_start = clock::now();
+        const dreamchess::PositionIndexBuilder builder{static_cast<uint16_t>(
+            std::max(1U, std::thread::hardware_concurrency()))};
+
+        if (!builder.build(store, argv[3])) {
+            std::cerr << "cannot write " << argv[3] << "\n";
+            return 1;
+        }
+
+        dreamchess::PositionIndex index;
+        index.open(argv[3]);
+
+        std::cout << index.size() << " positions indexed in "
+                  << std::chrono::duration<double>(clock::now() - index_start)
+                         .count()
+                  << " s\n";
+    }
+
+    return 0;
+}
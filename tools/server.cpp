@@ -0,0 +1,80 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#include <algorithm>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "GameServer.hpp"
+
+namespace {
+/**
+ * @brief The server stopped by the signal handler
+ */
+dreamchess::GameServer *running_server = nullptr;
+
+void usage() {
+    std::cerr << "usage: dreamchess++-server [-j workers] [-p port | -u path]\n"
+                 "  -p 0 listens on any free port\n";
+}
+
+void on_signal(int) {
+    // Only writes to an event file, safe in a signal handler
+    running_server->stop();
+}
+}    // namespace
+
+int main(int argc, char **argv) {
+    uint16_t workers = static_cast<uint16_t>(
+        std::max(1U, std::thread::hardware_concurrency()));
+    uint16_t port = 7000;
+    std::string path;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument{argv[i]};
+
+        if (argument == "-j" && i + 1 < argc) {
+            workers = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else if (argument == "-p" && i + 1 < argc) {
+            port = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else if (argument == "-u" && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    dreamchess::GameServer server{workers};
+
+    if (path.empty() ? !server.listen_tcp(port) : !server.listen_unix(path)) {
+        std::cerr << "cannot listen on "
+                  << (path.empty() ? std::to_string(port) : path) << "\n";
+        return 1;
+    }
+
+    running_server = &server;
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    std::cout << "listening on "
+              << (path.empty() ? "127.0.0.1:" + std::to_string(server.port())
+                               : path)
+              << " with " << workers << " workers" << std::endl;
+
+    server.run();
+
+    const dreamchess::GameServer::Statistics statistics = server.statistics();
+
+    std::cout << statistics.m_connections << " connections, "
+              << statistics.m_commands << " commands, " << statistics.m_moves
+              << " moves, " << statistics.m_illegal << " illegal\n";
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Tablebase.hpp"
+#include "TablebaseGenerator.hpp"
+
+namespace {
+void usage() {
+    std::cerr << "usage: dreamchess++-tbgen [-j threads] [-o directory] "
+                 "SIGNATURE...\n"
+                 "  e.g. dreamchess++-tbgen -j 8 -o tb KQK KRK KRKP\n";
+}
+}    // namespace
+
+int main(int argc, char **argv) {
+    uint16_t threads = static_cast<uint16_t>(
+        std::max(1U, std::thread::hardware_concurrency()));
+    std::string directory{"."};
+    std::vector<std::string> signatures;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument{argv[i]};
+
+        if (argument == "-j" && i + 1 < argc) {
+            threads = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else if (argument == "-o" && i + 1 < argc) {
+            directory = argv[++i];
+        } else {
+            const std::optional<std::string> signature =
+                dreamchess::Tablebase::signature(argument);
+
+            if (!signature) {
+                std::cerr << "invalid signature " << argument << "\n";
+                usage();
+                return 1;
+            }
+
+            signatures.push_back(*signature);
+        }
+    }
+
+    if (signatures.empty()) {
+        usage();
+        return 1;
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    dreamchess::TablebaseGenerator generator{threads};
+    const auto start = clock::now();
+    auto table_start = start;
+    auto last_ply = start;
+
+    const auto progress = [&table_start, &last_ply](std::string_view signature,
+                                                    uint16_t ply,
+                                                    uint64_t resolved) {
+        const auto now = clock::now();
+
+        // A table starts when the previous one, or its dependency, ends
+        if (ply == 0) {
+            table_start = last_ply;
+        }
+
+        last_ply = now;
+
+        std::cout << signature << ": ply " << ply << ", " << resolved
+                  << " positions resolved, "
+                  << std::chrono::duration<double>(now - table_start).count()
+                  << " s" << std::endl;
+    };
+
+    for (const auto &signature : signatures) {
+        static_cast<void>(generator.generate(signature, progress));
+    }
+
+    std::cout << generator.tables().size() << " tables generated with "
+              << threads << " threads in "
+              << std::chrono::duration<double>(clock::now() - start).count()
+              << " s\n";
+
+    for (const auto &[signature, table] : generator.tables()) {
+        const std::string path = directory + "/" + signature +
+                                 std::string{dreamchess::Tablebase::EXTENSION};
+
+        uint64_t wins = 0;
+        uint64_t losses = 0;
+        uint16_t longest = 0;
+
+        for (const uint8_t value : table) {
+            const dreamchess::Tablebase::Result result =
+                dreamchess::Tablebase::decode(value);
+
+            wins += result.m_wdl == dreamchess::Tablebase::WIN;
+            losses += result.m_wdl == dreamchess::Tablebase::LOSS;
+            longest = std::max(longest, result.m_moves);
+        }
+
+        if (!generator.write(signature, path)) {
+            std::cerr << "cannot write " << path << "\n";
+            return 1;
+        }
+
+        std::cout << path << ": " << table.size() << " positions, " << wins
+                  << " wins, " << losses << " losses, longest mate "
+                  << longest << " moves\n";
+    }
+
+    return 0;
+}
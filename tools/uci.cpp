@@ -0,0 +1,18 @@
+/**
+ * @copyright Dreamchess++
+ * @author Mattia Zorzan
+ * @version v1.0
+ * @date July-October, 2021
+ * @file
+ */
+#include <iostream>
+
+#include "Uci.hpp"
+
+int main() {
+    dreamchess::Uci uci{std::cin, std::cout};
+
+    uci.loop();
+
+    return 0;
+}